@@ -0,0 +1,136 @@
+#include "Benchmark.hpp"
+#include "../solution/SolutionSet.hpp"
+#include <iostream>
+#include <new>
+
+/*****************************************
+ * The number of heap allocations so far.
+ *****************************************/
+static unsigned long numAllocations = 0;
+
+void * operator new(std::size_t size) {
+    numAllocations++;
+
+    if(void * p = malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void * p) noexcept {
+    free(p);
+}
+
+void operator delete[](void * p) noexcept {
+    free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept {
+    free(p);
+}
+
+/***************************************************************************************
+ * Reads every bulk value of the specified instance, solution and set of solutions and
+ * returns a checksum, so that the reads cannot be optimised away.
+ *
+ * @param instance    the instance to be read.
+ * @param solution    the solution to be read.
+ * @param solutionSet the set of solutions to be read.
+ *
+ * @return a checksum of the values read.
+ ***************************************************************************************/
+static double read(const Instance & instance, const Solution & solution,
+        const SolutionSet & solutionSet) {
+    double checksum = 0.0;
+
+    checksum += instance.getProfits().size() + instance.getTCreates().size() +
+        instance.getDemandsR().size() + instance.getSourcesR().size() +
+        instance.getTargetsR().size() + instance.getTStarts().size() +
+        instance.getTLimits().size() + instance.getSpeeds().size() +
+        instance.getCapacities().size() + instance.getSourcesK().size() +
+        instance.getTargetsK().size() + instance.getX().size() + instance.getY().size() +
+        instance.getTVisits().size() + instance.getRequestsV().size() +
+        instance.getVehiclesV().size() + instance.getDemandsV().size() +
+        instance.getLengths().size();
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        for(double length : instance.getLengths(u)) {
+            checksum += length;
+        }
+    }
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        checksum += instance.getTravelTimes(k).size();
+    }
+
+    checksum += solution.getInstance().getNumVertices() + solution.getPaths().size() +
+        solution.getX().size() + solution.getY().size() + solution.getT().size() +
+        solution.getL().size() + solution.getTTravels().size() +
+        solution.getTFulfills().size() + solution.getLoads().size() +
+        solution.getTimes().size() + solution.getVehiclesR().size() +
+        solution.getVehiclesV().size() + solution.getVehiclesE().size() +
+        solution.getRequestsK().size() + solution.getIndexesKV().size();
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        checksum += solution.getPath(k).size() + solution.getRequestsK(k).size();
+    }
+
+    checksum += solutionSet.size() + solutionSet.getSolutions().size() +
+        solutionSet.getFronts().size() + solutionSet.getFront(0).size() +
+        solutionSet.getMinTotalProfitsF().size() + solutionSet.getMaxTotalProfitsF().size() +
+        solutionSet.getMinSumTFulfillsF().size() + solutionSet.getMaxSumTFulfillsF().size() +
+        solutionSet.getMinTotalProfitF(0) + solutionSet.getMaxSumTFulfillF(0);
+
+    return checksum;
+}
+
+/**************************************************************************************
+ * Counts the heap allocations made by the read-only accessors of Instance, Solution
+ * and SolutionSet. Fails if any read allocates.
+ *
+ * Usage: AllocationBenchmark [numRequests] [numVehicles] [numIterations]
+ **************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 200);
+    unsigned numVehicles = getArgument(argc, argv, 2, 10);
+    unsigned numIterations = getArgument(argc, argv, 3, 100);
+    Instance instance = randomInstance(numRequests, numVehicles, 0);
+    Solution solution(instance, randomPaths(instance, 0));
+    SolutionSet solutionSet(numIterations);
+    double checksum = 0.0;
+
+    for(unsigned seed = 0; seed < 10; seed++) {
+        solutionSet.insert(Solution(instance, randomPaths(instance, seed)));
+    }
+
+    // sort the set of solutions and derive the dense matrices of the solution before counting
+    solutionSet.getFronts();
+    solution.getX();
+    solution.getVehiclesE();
+
+    unsigned long numAllocationsBefore = numAllocations;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        checksum += read(instance, solution, solutionSet);
+    }
+
+    double time = elapsedSeconds(startTime);
+    unsigned long numReadAllocations = numAllocations - numAllocationsBefore;
+
+    std::cout << "vertices: " << instance.getNumVertices() << std::endl;
+    std::cout << "read passes: " << numIterations << " (" << time << " s, checksum "
+        << checksum << ")" << std::endl;
+    std::cout << "heap allocations on read paths: " << numReadAllocations << std::endl;
+
+    return numReadAllocations == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../instance/Instance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+/****************************************************************************
+ * Returns the number of seconds elapsed since the specified time point.
+ *
+ * @param startTime the time point.
+ *
+ * @return the number of seconds elapsed since the specified time point.
+ ****************************************************************************/
+inline double elapsedSeconds(const std::chrono::steady_clock::time_point & startTime) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/*********************************************************************************
+ * Returns the specified command line argument as an unsigned value.
+ *
+ * @param argc         the number of command line arguments.
+ * @param argv         the command line arguments.
+ * @param i            the index of the argument.
+ * @param defaultValue the value returned when the argument is missing.
+ *
+ * @return the specified command line argument as an unsigned value.
+ *********************************************************************************/
+inline unsigned getArgument(int argc, char ** argv, int i, unsigned defaultValue) {
+    if(i < argc) {
+        return strtoul(argv[i], nullptr, 10);
+    }
+
+    return defaultValue;
+}
+
+/**************************************************************************************
+ * Constructs a random instance with uniformly distributed vertices.
+ *
+ * @param numRequests the number of requests.
+ * @param numVehicles the number of vehicles.
+ * @param seed        the seed for the pseudo-random numbers generator.
+ * @param mode        the way the lengths and travelling times are obtained.
+ *
+ * @return a random instance.
+ **************************************************************************************/
+inline Instance randomInstance(unsigned numRequests, unsigned numVehicles, unsigned seed,
+        DistanceMode mode) {
+    std::default_random_engine generator(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    std::uniform_int_distribution<unsigned> value(1, 10);
+    std::vector<double> profits, tCreates, demandsR, tStarts, tLimits, speeds, capacities;
+    std::vector<unsigned> sourcesR, targetsR, sourcesK, targetsK;
+    std::vector<double> x, y, tVisits;
+
+    for(unsigned k = 0; k < numVehicles; k++) {
+        tStarts.push_back(0.0);
+        tLimits.push_back(1.0e6);
+        speeds.push_back(value(generator));
+        capacities.push_back(100.0 * value(generator));
+        sourcesK.push_back(x.size());
+        targetsK.push_back(x.size() + 1);
+
+        for(unsigned i = 0; i < 2; i++) {
+            x.push_back(coordinate(generator));
+            y.push_back(coordinate(generator));
+            tVisits.push_back(value(generator));
+        }
+    }
+
+    for(unsigned r = 0; r < numRequests; r++) {
+        demandsR.push_back(value(generator));
+        profits.push_back(demandsR.back());
+        tCreates.push_back(0.0);
+        sourcesR.push_back(x.size());
+        targetsR.push_back(x.size() + 1);
+
+        for(unsigned i = 0; i < 2; i++) {
+            x.push_back(coordinate(generator));
+            y.push_back(coordinate(generator));
+            tVisits.push_back(value(generator));
+        }
+    }
+
+    return Instance(profits, tCreates, demandsR, sourcesR, targetsR, tStarts, tLimits, speeds,
+            capacities, sourcesK, targetsK, x, y, tVisits, mode);
+}
+
+/**************************************************************************************
+ * Constructs a random instance with uniformly distributed vertices, whose lengths
+ * and travelling times are stored in matrices.
+ *
+ * @param numRequests the number of requests.
+ * @param numVehicles the number of vehicles.
+ * @param seed        the seed for the pseudo-random numbers generator.
+ *
+ * @return a random instance.
+ **************************************************************************************/
+inline Instance randomInstance(unsigned numRequests, unsigned numVehicles, unsigned seed) {
+    return randomInstance(numRequests, numVehicles, seed, DistanceMode::MATRIX);
+}
+
+/**************************************************************************************
+ * Returns random paths that serve every request of the specified instance, each
+ * request being assigned to a random vehicle.
+ *
+ * @param instance the instance.
+ * @param seed     the seed for the pseudo-random numbers generator.
+ *
+ * @return random paths that serve every request of the specified instance.
+ **************************************************************************************/
+inline std::vector<std::vector<unsigned>> randomPaths(const Instance & instance, unsigned seed) {
+    std::default_random_engine generator(seed);
+    std::vector<std::vector<unsigned>> paths(instance.getNumVehicles());
+    std::vector<unsigned> requests(instance.getNumRequests());
+
+    for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+        requests[r] = r;
+    }
+
+    std::shuffle(requests.begin(), requests.end(), generator);
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        paths[k].push_back(instance.getSourceK(k));
+    }
+
+    for(unsigned i = 0; i < requests.size(); i++) {
+        unsigned k = i % instance.getNumVehicles();
+
+        paths[k].push_back(instance.getSourceR(requests[i]));
+        paths[k].push_back(instance.getTargetR(requests[i]));
+    }
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        paths[k].push_back(instance.getTargetK(k));
+    }
+
+    return paths;
+}
@@ -0,0 +1,61 @@
+#include "Benchmark.hpp"
+#include "../instance/InstanceCache.hpp"
+#include <cstdio>
+#include <iostream>
+
+/***************************************************************************************
+ * Compares the time needed to read an instance and build its arc filter from scratch
+ * with the time needed to get both from a cache, the first time, when they are
+ * computed and stored, and the following times, when they are mapped.
+ *
+ * Usage: CacheBenchmark [numRequests] [numVehicles] [numRuns]
+ ***************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 500);
+    unsigned numVehicles = getArgument(argc, argv, 2, 20);
+    unsigned numRuns = getArgument(argc, argv, 3, 5);
+    std::string filename = "/tmp/CacheBenchmark.in";
+    InstanceCache cache("/tmp/CacheBenchmark");
+    Instance instance = randomInstance(numRequests, numVehicles, 0);
+    uint64_t fingerprint = instance.getFingerprint();
+    std::size_t checksum = 0;
+
+    instance.write(filename.c_str());
+
+    std::remove(cache.getFilename(fingerprint, "instance", 2).c_str());
+    std::remove(cache.getFilename(fingerprint, "arcfilter", 1).c_str());
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned run = 0; run < numRuns; run++) {
+        Instance runInstance(filename);
+
+        checksum += ArcFilter(runInstance).getNumArcs();
+    }
+
+    double scratchTime = elapsedSeconds(startTime) / numRuns;
+
+    startTime = std::chrono::steady_clock::now();
+    checksum += cache.getArcFilter(cache.getInstance(filename, DistanceMode::MATRIX))
+        .getNumArcs();
+    double missTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned run = 0; run < numRuns; run++) {
+        Instance runInstance = cache.getInstance(filename, DistanceMode::MATRIX);
+
+        checksum += cache.getArcFilter(runInstance).getNumArcs();
+    }
+
+    double hitTime = elapsedSeconds(startTime) / numRuns;
+
+    std::cout << "vertices: " << instance.getNumVertices() << ", vehicles: " << numVehicles
+        << std::endl;
+    std::cout << "from scratch: " << 1.0e3 * scratchTime << " ms/run" << std::endl;
+    std::cout << "cache miss: " << 1.0e3 * missTime << " ms" << std::endl;
+    std::cout << "cache hit: " << 1.0e3 * hitTime << " ms/run (checksum " << checksum << ")"
+        << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "Benchmark.hpp"
+#include "../instance/CompressedStream.hpp"
+#include "../solution/Solution.hpp"
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**************************************************************************
+ * Returns the size of the specified file.
+ *
+ * @param filename the file.
+ *
+ * @return the size of the specified file, in bytes.
+ **************************************************************************/
+static double getFileSize(const std::string & filename) {
+    struct stat status;
+
+    return stat(filename.c_str(), &status) == 0 ? status.st_size : 0.0;
+}
+
+/**************************************************************************
+ * Returns the resident size of this process.
+ *
+ * @return the resident size of this process, in megabytes.
+ **************************************************************************/
+static double getResidentSize() {
+    std::ifstream ifs("/proc/self/statm");
+    double numPages = 0.0;
+    double numResidentPages = 0.0;
+
+    ifs >> numPages >> numResidentPages;
+
+    return numResidentPages * sysconf(_SC_PAGESIZE) / 1.0e6;
+}
+
+/**************************************************************************
+ * Returns the peak resident size of this process.
+ *
+ * @return the peak resident size of this process, in megabytes.
+ **************************************************************************/
+static double getPeakResidentSize() {
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss / 1.0e3;
+}
+
+/*****************************************************************************************
+ * Measures the throughput of writing and reading a text instance, and of writing and
+ * reading the values of many solution files, plain and compressed with each available
+ * compression. The throughputs are given in megabytes of text per second. Each instance
+ * is read in a child process, whose peak resident size grows from its size at the fork
+ * by the memory the read needed at most. The solution files are also written through
+ * std::ofstream, as they were before the compressed streams.
+ *
+ * Usage: CompressionBenchmark [numRequests] [numSolutions]
+ *****************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 50000);
+    unsigned numSolutions = getArgument(argc, argv, 2, 1000);
+    std::string directory = "bin/benchmark/";
+    std::vector<std::string> extensions = {"", ".gz"};
+
+#ifdef WITH_ZSTD
+    extensions.push_back(".zst");
+#endif
+
+    Instance instance = randomInstance(numRequests, 10, 0, DistanceMode::ON_THE_FLY);
+    double textSize = 0.0;
+
+    for(const std::string & extension : extensions) {
+        std::string filename = directory + "compression.in" + extension;
+        auto startTime = std::chrono::steady_clock::now();
+        CompressedOutputStream os(filename.c_str());
+
+        // enough digits for the values to be read back exactly
+        os.precision(std::numeric_limits<double>::max_digits10);
+        instance.write(os);
+        os.close();
+
+        double writeTime = elapsedSeconds(startTime);
+
+        if(extension.empty()) {
+            textSize = getFileSize(filename);
+        }
+
+        std::cout.flush();
+
+        // the child starts with the peak resident size of the parent reset
+        if(fork() == 0) {
+            double residentSize = getResidentSize();
+
+            startTime = std::chrono::steady_clock::now();
+            Instance readInstance(filename, DistanceMode::ON_THE_FLY);
+            double readTime = elapsedSeconds(startTime);
+
+            std::cout << "instance" << (extension.empty() ? " (plain)" : extension) << ": "
+                << getFileSize(filename) / 1.0e6 << " MB, write "
+                << textSize / 1.0e6 / writeTime << " MB/s, read "
+                << textSize / 1.0e6 / readTime << " MB/s, peak RSS +"
+                << getPeakResidentSize() - residentSize << " MB"
+                << (readInstance.getFingerprint() == instance.getFingerprint() ? "" :
+                        " (differs)") << std::endl;
+
+            _exit(0);
+        }
+
+        wait(nullptr);
+    }
+
+    std::shared_ptr<const Instance> smallInstance = std::make_shared<const Instance>(
+            randomInstance(200, 10, 0));
+    Solution solution(smallInstance, randomPaths(* smallInstance, 0));
+    unsigned long expectedSum = 0;
+
+    for(const std::vector<unsigned> & path : solution.getPaths()) {
+        expectedSum += path.size();
+
+        for(unsigned v : path) {
+            expectedSum += v;
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned i = 0; i < numSolutions; i++) {
+        std::ofstream ofs(directory + "compression" + std::to_string(i) + ".out");
+
+        solution.write(ofs);
+    }
+
+    double ofstreamTime = elapsedSeconds(startTime);
+
+    std::cout << numSolutions << " solutions through std::ofstream: write "
+        << 1.0e3 * ofstreamTime << " ms" << std::endl;
+
+    for(const std::string & extension : extensions) {
+        startTime = std::chrono::steady_clock::now();
+
+        for(unsigned i = 0; i < numSolutions; i++) {
+            solution.write(directory + "compression" + std::to_string(i) + ".out" + extension);
+        }
+
+        double writeTime = elapsedSeconds(startTime);
+        unsigned long sum = 0;
+
+        startTime = std::chrono::steady_clock::now();
+
+        // only the values are read, since building a solution costs more than its file
+        for(unsigned i = 0; i < numSolutions; i++) {
+            CompressedInputStream is((directory + "compression" + std::to_string(i) + ".out" +
+                        extension).c_str());
+            unsigned value;
+
+            while(is >> value) {
+                sum += value;
+            }
+        }
+
+        double readTime = elapsedSeconds(startTime);
+        bool isEqual = Solution(smallInstance, directory + "compression0.out" + extension) ==
+            solution && sum == numSolutions * expectedSum;
+
+        std::cout << numSolutions << " solutions" << (extension.empty() ? " (plain)" :
+                extension) << ": " << getFileSize(directory + "compression0.out" + extension)
+            << " B each, write " << 1.0e3 * writeTime << " ms, read " << 1.0e3 * readTime
+            << " ms" << (isEqual ? "" : " (differ)") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "Benchmark.hpp"
+#include "../solution/Solution.hpp"
+#include <iostream>
+#include <memory>
+
+/*****************************************************************************************
+ * Compares the time needed to verify the constraints of a random solution of random
+ * instances of growing size from its paths with the time needed to verify them from its
+ * decision variables, which are derived beforehand and timed apart.
+ *
+ * Usage: ConstraintBenchmark [minNumRequests] [maxNumRequests] [numVehicles]
+ *****************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned minNumRequests = getArgument(argc, argv, 1, 50);
+    unsigned maxNumRequests = getArgument(argc, argv, 2, 400);
+    unsigned numVehicles = getArgument(argc, argv, 3, 10);
+
+    std::cout << "vertices, paths (us), decision variables (us), derivation (us), errors"
+        << std::endl;
+
+    for(unsigned numRequests = minNumRequests; numRequests <= maxNumRequests; numRequests *= 2) {
+        std::shared_ptr<const Instance> instance = std::make_shared<const Instance>(
+                randomInstance(numRequests, numVehicles, 0));
+        Solution solution(instance, randomPaths(* instance, 0));
+        unsigned pathError, variableError;
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        solution.getX();
+
+        double derivationTime = elapsedSeconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        solution.areConstraintsSatisfied(pathError);
+
+        double pathTime = elapsedSeconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        solution.areDecisionVariablesSatisfied(variableError);
+
+        double variableTime = elapsedSeconds(startTime);
+
+        std::cout << instance->getNumVertices() << ", " << 1.0e6 * pathTime << ", "
+            << 1.0e6 * variableTime << ", " << 1.0e6 * derivationTime << ", " << pathError
+            << (pathError == variableError ? "" : " (differs)") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+#include "../solver/decomposition/DecompositionSolver.hpp"
+#include "../solver/greedy/GreedySolver.hpp"
+#include <iostream>
+#include <thread>
+
+/******************************************************************************************
+ * Measures the time taken to decompose an instance and solve its clusters with the
+ * greedy solver on an increasing number of threads, up to the number of cores. More
+ * threads than cores may be asked for, but they only measure the overhead of the threads.
+ * Then measures a whole solve of the same instance, whose merge builds the full solutions
+ * on the calling thread and so bounds the speedup of the whole solve.
+ *
+ * Usage: DecompositionBenchmark [numRequests] [numVehicles] [numClusters] [maxNumThreads]
+ ******************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 10000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 200);
+    unsigned numClusters = getArgument(argc, argv, 3, 200);
+    unsigned maxNumThreads = getArgument(argc, argv, 4, std::thread::hardware_concurrency());
+    unsigned timeLimit = 3600;
+    unsigned maxNumSolutions = 10;
+    SubSolverFactory greedySolverFactory = [](const std::shared_ptr<const Instance> & instance,
+            unsigned timeLimit, unsigned seed, unsigned maxNumSolutions) {
+        return std::unique_ptr<Solver>(new GreedySolver(instance, timeLimit, seed,
+                    maxNumSolutions));
+    };
+    std::shared_ptr<const Instance> instance = std::make_shared<const Instance>(
+            randomInstance(numRequests, numVehicles, 0, DistanceMode::ON_THE_FLY));
+    double baseTime = 0.0;
+
+    std::cout << "cores: " << std::thread::hardware_concurrency() << std::endl;
+
+    for(unsigned numThreads = 1; numThreads <= std::max(maxNumThreads, 1u); numThreads *= 2) {
+        DecompositionSolver solver(instance, numClusters, numThreads, greedySolverFactory,
+                timeLimit, 0, maxNumSolutions);
+        auto startTime = std::chrono::steady_clock::now();
+
+        solver.solveClusters();
+
+        double time = elapsedSeconds(startTime);
+        double totalProfit = 0.0;
+
+        if(numThreads == 1) {
+            baseTime = time;
+        }
+
+        for(unsigned c = 0; c < solver.getDecomposition().getNumClusters(); c++) {
+            double maxProfit = 0.0;
+
+            for(const Solution & solution : solver.getClusterSolutionSet(c).getSolutions()) {
+                maxProfit = std::max(maxProfit, solution.getTotalProfit());
+            }
+
+            totalProfit += maxProfit;
+        }
+
+        std::cout << numThreads << " threads, " << solver.getDecomposition().getNumClusters()
+            << " clusters: " << 1.0e3 * time << " ms, speedup " << baseTime / time
+            << " (profit " << totalProfit << ")"
+            << (numThreads > std::thread::hardware_concurrency() ? ", more threads than cores" :
+                    "") << std::endl;
+    }
+
+    DecompositionSolver solver(instance, numClusters, maxNumThreads, greedySolverFactory,
+            timeLimit, 0, maxNumSolutions);
+    auto startTime = std::chrono::steady_clock::now();
+
+    solver.solveClusters();
+
+    double clustersTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    solver.merge();
+
+    double mergeTime = elapsedSeconds(startTime);
+
+    std::cout << "solve (" << instance->getNumRequests() << " requests, "
+        << solver.getDecomposition().getNumClusters() << " clusters): " << 1.0e3 * clustersTime
+        << " ms, merge " << 1.0e3 * mergeTime << " ms, " << solver.getSolutionSet().size()
+        << " solutions, speedup at most " << (clustersTime + mergeTime) / mergeTime
+        << " on any number of threads" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "Benchmark.hpp"
+#include <iostream>
+
+/******************************************************************************************
+ * Compares the MATRIX and ON_THE_FLY distance modes: the time needed to construct an
+ * instance, the throughput of route evaluation and the throughput of the batch API
+ * computing the lengths from one vertex to every other vertex. Finally, constructs an
+ * instance too large for the MATRIX mode in the ON_THE_FLY mode.
+ *
+ * Usage: DistanceBenchmark [numRequests] [numVehicles] [numIterations] [numLargeRequests]
+ ******************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 2000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 50);
+    unsigned numIterations = getArgument(argc, argv, 3, 100);
+    unsigned numLargeRequests = getArgument(argc, argv, 4, 25000);
+
+    auto startTime = std::chrono::steady_clock::now();
+    Instance matrixInstance = randomInstance(numRequests, numVehicles, 0, DistanceMode::MATRIX);
+    double matrixInitTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    Instance onTheFlyInstance = randomInstance(numRequests, numVehicles, 0,
+            DistanceMode::ON_THE_FLY);
+    double onTheFlyInitTime = elapsedSeconds(startTime);
+
+    std::vector<std::vector<unsigned>> paths = randomPaths(matrixInstance, 0);
+    std::vector<unsigned> vertices(matrixInstance.getNumVertices());
+    std::vector<double> lengths(matrixInstance.getNumVertices());
+    unsigned long numArcs = 0;
+    double sumMatrix = 0.0, sumOnTheFly = 0.0, sumScalar = 0.0, sumBatch = 0.0;
+
+    for(const auto & path : paths) {
+        numArcs += path.size() - 1;
+    }
+
+    numArcs *= numIterations;
+
+    for(unsigned v = 0; v < vertices.size(); v++) {
+        vertices[v] = v;
+    }
+
+    auto evaluate = [&](const Instance & instance, double & sum) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        for(unsigned it = 0; it < numIterations; it++) {
+            for(const auto & path : paths) {
+                for(unsigned i = 1; i < path.size(); i++) {
+                    sum += instance.getLength(path[i - 1], path[i]);
+                }
+            }
+        }
+
+        return numArcs / elapsedSeconds(startTime) / 1.0e6;
+    };
+
+    double matrixRate = evaluate(matrixInstance, sumMatrix);
+    double onTheFlyRate = evaluate(onTheFlyInstance, sumOnTheFly);
+    unsigned long numLengths = (unsigned long) vertices.size() * vertices.size();
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned u = 0; u < vertices.size(); u++) {
+        for(unsigned i = 0; i < vertices.size(); i++) {
+            lengths[i] = onTheFlyInstance.getLength(u, vertices[i]);
+        }
+
+        // summing every length would serialise the loop, so only one is sampled
+        sumScalar += lengths[(7919ul * u) % lengths.size()];
+    }
+
+    double scalarRate = numLengths / elapsedSeconds(startTime) / 1.0e6;
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned u = 0; u < vertices.size(); u++) {
+        onTheFlyInstance.getLengths(u, vertices, lengths.data());
+
+        sumBatch += lengths[(7919ul * u) % lengths.size()];
+    }
+
+    double batchRate = numLengths / elapsedSeconds(startTime) / 1.0e6;
+
+    startTime = std::chrono::steady_clock::now();
+    Instance largeInstance = randomInstance(numLargeRequests, numVehicles, 0,
+            DistanceMode::ON_THE_FLY);
+    double largeInitTime = elapsedSeconds(startTime);
+    double largeGigabytes = 8.0e-9 * largeInstance.getNumVertices() *
+        largeInstance.getNumVertices() * (1 + largeInstance.getNumSpeedClasses());
+
+    std::cout << "vertices: " << matrixInstance.getNumVertices() << std::endl;
+    std::cout << "construction: matrix " << matrixInitTime << " s, on the fly "
+        << onTheFlyInitTime << " s" << std::endl;
+    std::cout << "route evaluation: matrix " << matrixRate << " Marcs/s, on the fly "
+        << onTheFlyRate << " Marcs/s" << std::endl;
+    std::cout << "one against all: scalar " << scalarRate << " Mlengths/s, batch "
+        << batchRate << " Mlengths/s" << std::endl;
+    std::cout << "large instance: " << largeInstance.getNumVertices() << " vertices in "
+        << largeInitTime << " s instead of " << largeGigabytes << " GB of matrices"
+        << std::endl;
+
+    return (sumMatrix == sumOnTheFly && sumScalar == sumBatch) ? 0 : 1;
+}
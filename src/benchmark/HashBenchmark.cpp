@@ -0,0 +1,89 @@
+#include "Benchmark.hpp"
+#include "../solution/Solution.hpp"
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <unordered_set>
+
+/******************************************************************************************
+ * Counts the pairs of distinct random solutions of a small instance whose hashes collide,
+ * in full and truncated to fewer bits, against the number of pairs expected from hashes
+ * drawn uniformly at random. It then compares the time needed to find every solution
+ * again among the others through a set of their paths with the time needed through a set
+ * of their hashes.
+ *
+ * Usage: HashBenchmark [numRequests] [numVehicles] [numSolutions]
+ ******************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 10);
+    unsigned numVehicles = getArgument(argc, argv, 2, 3);
+    unsigned numSolutions = getArgument(argc, argv, 3, 100000);
+    std::shared_ptr<const Instance> instance = std::make_shared<const Instance>(
+            randomInstance(numRequests, numVehicles, 0));
+    std::set<std::vector<std::vector<unsigned>>> pathSets;
+    std::vector<uint64_t> hashes;
+
+    for(unsigned seed = 0; seed < numSolutions; seed++) {
+        std::vector<std::vector<unsigned>> paths = randomPaths(* instance, seed);
+
+        // only the distinct solutions are kept, so that every collision is a false one
+        if(pathSets.insert(paths).second) {
+            hashes.push_back(Solution(instance, paths).getHash());
+        }
+    }
+
+    double numPairs = 0.5 * hashes.size() * (hashes.size() - 1.0);
+
+    std::cout << hashes.size() << " distinct solutions of " << numSolutions << " with "
+        << instance->getNumVertices() << " vertices" << std::endl;
+
+    for(unsigned numBits : {16, 20, 24, 32, 64}) {
+        uint64_t mask = numBits < 64 ? (1ull << numBits) - 1 : ~0ull;
+        std::vector<uint64_t> truncated;
+        unsigned long numCollisions = 0;
+
+        for(uint64_t hash : hashes) {
+            truncated.push_back(hash & mask);
+        }
+
+        std::sort(truncated.begin(), truncated.end());
+
+        // a run of c equal hashes holds c (c - 1) / 2 colliding pairs
+        for(unsigned i = 1, run = 1; i <= truncated.size(); i++) {
+            if(i < truncated.size() && truncated[i] == truncated[i - 1]) {
+                run++;
+            } else {
+                numCollisions += run * (run - 1ul) / 2;
+                run = 1;
+            }
+        }
+
+        std::cout << numBits << " bits: " << numCollisions << " colliding pairs, "
+            << numPairs / std::pow(2.0, numBits) << " expected" << std::endl;
+    }
+
+    unsigned long numFound = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(const std::vector<std::vector<unsigned>> & paths : pathSets) {
+        numFound += pathSets.count(paths);
+    }
+
+    double pathsTime = elapsedSeconds(startTime);
+    std::unordered_set<uint64_t> hashSet(hashes.begin(), hashes.end());
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(uint64_t hash : hashes) {
+        numFound += hashSet.count(hash);
+    }
+
+    double hashesTime = elapsedSeconds(startTime);
+
+    std::cout << "lookup through paths: " << 1.0e9 * pathsTime / pathSets.size()
+        << " ns, through hashes: " << 1.0e9 * hashesTime / hashes.size() << " ns ("
+        << numFound << " found)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "Benchmark.hpp"
+#include "../solution/Solution.hpp"
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+/*****************************************************************************************
+ * Compares the time needed to evaluate the insertions of the unserved requests of a
+ * random solution into every position of every path, through the cached loads and times
+ * of the solution, with the time needed to build the solution of each insertion and
+ * verify the path. Only a sample of the insertions is built, and the results of both are
+ * compared on it.
+ *
+ * Usage: InsertionBenchmark [numRequests] [numVehicles] [numUnserved] [numSamples]
+ *****************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 200);
+    unsigned numVehicles = getArgument(argc, argv, 2, 5);
+    unsigned numUnserved = std::min(getArgument(argc, argv, 3, 20), numRequests);
+    unsigned numSamples = getArgument(argc, argv, 4, 200);
+    std::shared_ptr<const Instance> instance = std::make_shared<const Instance>(
+            randomInstance(numRequests, numVehicles, 0));
+    std::vector<std::vector<unsigned>> paths = randomPaths(* instance, 0);
+    std::vector<unsigned> unserved;
+
+    // the first requests of the path of each vehicle are left unserved
+    for(unsigned k = 0; unserved.size() < numUnserved; k = (k + 1) % numVehicles) {
+        if(paths[k].size() > 2) {
+            unserved.push_back(instance->getVertex(paths[k][1]).request);
+            paths[k].erase(paths[k].begin() + 1, paths[k].begin() + 3);
+        }
+    }
+
+    Solution solution(instance, paths);
+    unsigned long numInsertions = 0, numFeasible = 0;
+    double sum = 0.0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned r : unserved) {
+        for(unsigned k = 0; k < numVehicles; k++) {
+            for(unsigned i = 1; i < paths[k].size(); i++) {
+                for(unsigned j = i; j < paths[k].size(); j++) {
+                    Insertion insertion = solution.evaluateInsertion(r, k, i, j);
+
+                    numInsertions++;
+                    numFeasible += insertion.isFeasible ? 1 : 0;
+                    sum += insertion.deltaSumTFulfill;
+                }
+            }
+        }
+    }
+
+    double evaluateTime = elapsedSeconds(startTime);
+    std::default_random_engine generator(0);
+    unsigned numDiffering = 0;
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned sample = 0; sample < numSamples; sample++) {
+        unsigned r = unserved[generator() % unserved.size()];
+        unsigned k = generator() % numVehicles;
+        unsigned i = 1 + generator() % (paths[k].size() - 1);
+        unsigned j = i + generator() % (paths[k].size() - i);
+        std::vector<std::vector<unsigned>> newPaths(paths);
+
+        newPaths[k].insert(newPaths[k].begin() + j, instance->getTargetR(r));
+        newPaths[k].insert(newPaths[k].begin() + i, instance->getSourceR(r));
+
+        Solution newSolution(instance, newPaths);
+        Insertion insertion = solution.evaluateInsertion(r, k, i, j);
+
+        if(fabs(solution.getSumTFulfill() + insertion.deltaSumTFulfill -
+                    newSolution.getSumTFulfill()) > 1e-6 ||
+                fabs(solution.getTTravel(k) + insertion.deltaTTravel -
+                    newSolution.getTTravel(k)) > 1e-6 ||
+                insertion.isFeasible != (newSolution.isValidPath(k) &&
+                    instance->isEligible(r, k))) {
+            numDiffering++;
+        }
+    }
+
+    double rebuildTime = elapsedSeconds(startTime);
+
+    std::cout << numInsertions << " insertions of " << numUnserved << " requests into "
+        << numVehicles << " paths of " << solution.getPath(0).size() << " vertices, "
+        << numFeasible << " feasible (sum " << sum << ")" << std::endl;
+    std::cout << "evaluate: " << 1.0e9 * evaluateTime / numInsertions << " ns, rebuild: "
+        << 1.0e6 * rebuildTime / numSamples << " us per insertion" << std::endl;
+    std::cout << numDiffering << " of " << numSamples << " sampled insertions differ"
+        << std::endl;
+
+    return 0;
+}
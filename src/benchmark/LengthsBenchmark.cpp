@@ -0,0 +1,76 @@
+#include "Benchmark.hpp"
+#include <iostream>
+
+/*************************************************************************************
+ * Compares the throughput of route evaluation with the lengths stored as a vector of
+ * vectors (the previous layout) and as a single row-major matrix.
+ *
+ * Usage: LengthsBenchmark [numRequests] [numVehicles] [numIterations]
+ *************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 2000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 50);
+    unsigned numIterations = getArgument(argc, argv, 3, 1000);
+    Instance instance = randomInstance(numRequests, numVehicles, 0);
+    std::vector<std::vector<unsigned>> paths = randomPaths(instance, 0);
+    std::vector<std::vector<double>> nestedLengths(instance.getNumVertices(),
+            std::vector<double>(instance.getNumVertices()));
+    unsigned long numArcs = 0;
+    double sumNested = 0.0, sumMatrix = 0.0, sumRows = 0.0;
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            nestedLengths[u][v] = instance.getLength(u, v);
+        }
+    }
+
+    for(const auto & path : paths) {
+        numArcs += path.size() - 1;
+    }
+
+    numArcs *= numIterations;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        for(const auto & path : paths) {
+            for(unsigned i = 1; i < path.size(); i++) {
+                sumNested += nestedLengths[path[i - 1]][path[i]];
+            }
+        }
+    }
+
+    double nestedTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        for(const auto & path : paths) {
+            for(unsigned i = 1; i < path.size(); i++) {
+                sumMatrix += instance.getLength(path[i - 1], path[i]);
+            }
+        }
+    }
+
+    double matrixTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        for(const auto & path : paths) {
+            for(unsigned i = 1; i < path.size(); i++) {
+                sumRows += instance.getLengths(path[i - 1])[path[i]];
+            }
+        }
+    }
+
+    double rowsTime = elapsedSeconds(startTime);
+
+    std::cout << "vertices: " << instance.getNumVertices() << std::endl;
+    std::cout << "arcs evaluated: " << numArcs << std::endl;
+    std::cout << "vector of vectors: " << numArcs / nestedTime / 1.0e6 << " Marcs/s" << std::endl;
+    std::cout << "matrix getLength: " << numArcs / matrixTime / 1.0e6 << " Marcs/s" << std::endl;
+    std::cout << "matrix row view:  " << numArcs / rowsTime / 1.0e6 << " Marcs/s" << std::endl;
+
+    return (sumNested == sumMatrix && sumMatrix == sumRows) ? 0 : 1;
+}
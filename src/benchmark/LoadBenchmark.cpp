@@ -0,0 +1,59 @@
+#include "Benchmark.hpp"
+#include <cstdio>
+#include <iostream>
+
+/***************************************************************************************
+ * Compares the time needed to load an instance from the text format, which is parsed
+ * and whose lengths are recomputed, with the time needed to load it from the binary
+ * format, which is mapped into memory.
+ *
+ * Usage: LoadBenchmark [numRequests] [numVehicles]
+ ***************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 2000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 50);
+    Instance instance = randomInstance(numRequests, numVehicles, 0);
+    std::string textFilename = "/tmp/LoadBenchmark.in";
+    std::string binaryFilename = "/tmp/LoadBenchmark.bin";
+
+    instance.write(textFilename.c_str());
+    instance.writeBinary(binaryFilename.c_str());
+
+    auto startTime = std::chrono::steady_clock::now();
+    Instance textInstance(textFilename);
+    double textTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    Instance binaryInstance(binaryFilename);
+    double binaryTime = elapsedSeconds(startTime);
+
+    // touch every length so that the mapped pages are actually read
+    double sum = 0.0;
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned u = 0; u < binaryInstance.getNumVertices(); u++) {
+        for(double length : binaryInstance.getLengths(u)) {
+            sum += length;
+        }
+    }
+
+    double touchTime = elapsedSeconds(startTime);
+    bool equal = binaryInstance.getNumVertices() == instance.getNumVertices();
+
+    for(unsigned u = 0; equal && u < instance.getNumVertices(); u++) {
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            equal = equal && binaryInstance.getLength(u, v) == instance.getLength(u, v);
+        }
+    }
+
+    std::cout << "vertices: " << instance.getNumVertices() << std::endl;
+    std::cout << "text load:   " << textTime << " s" << std::endl;
+    std::cout << "binary load: " << binaryTime << " s (+" << touchTime 
+        << " s to read every length, checksum " << sum << ")" << std::endl;
+
+    remove(textFilename.c_str());
+    remove(binaryFilename.c_str());
+
+    return equal ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#include "Benchmark.hpp"
+#include "../solution/Solution.hpp"
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+
+/*********************************************************************************
+ * The room kept before each heap block to remember its size, which preserves the
+ * alignment of the block.
+ *********************************************************************************/
+static const std::size_t HEADER_SIZE = sizeof(std::max_align_t);
+
+/*****************************************
+ * The number of bytes on the heap now.
+ *****************************************/
+static std::size_t numBytes = 0;
+
+void * operator new(std::size_t size) {
+    if(char * p = static_cast<char *>(malloc(HEADER_SIZE + size))) {
+        * reinterpret_cast<std::size_t *>(p) = size;
+        numBytes += size;
+
+        return p + HEADER_SIZE;
+    }
+
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void * p) noexcept {
+    if(p != nullptr) {
+        char * block = static_cast<char *>(p) - HEADER_SIZE;
+
+        numBytes -= * reinterpret_cast<std::size_t *>(block);
+        free(block);
+    }
+}
+
+void operator delete[](void * p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void * p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+/*****************************************************************************************
+ * Measures the heap footprint of a solution of random instances of growing size: the
+ * route data held from its construction, the decision variables and the dense matrices
+ * of indexes derived on first access, and a copy made afterwards. Also measures the time
+ * needed to construct a solution.
+ *
+ * Usage: MemoryBenchmark [minNumRequests] [maxNumRequests] [numVehicles]
+ *****************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned minNumRequests = getArgument(argc, argv, 1, 50);
+    unsigned maxNumRequests = getArgument(argc, argv, 2, 400);
+    unsigned numVehicles = getArgument(argc, argv, 3, 10);
+
+    std::cout << "vertices, construction (us), route data, decision variables, dense indexes, "
+        << "copy (bytes)" << std::endl;
+
+    for(unsigned numRequests = minNumRequests; numRequests <= maxNumRequests; numRequests *= 2) {
+        std::shared_ptr<const Instance> instance = std::make_shared<const Instance>(
+                randomInstance(numRequests, numVehicles, 0));
+        std::vector<std::vector<unsigned>> paths = randomPaths(* instance, 0);
+        std::size_t numBytesBefore = numBytes;
+        auto startTime = std::chrono::steady_clock::now();
+        Solution solution(instance, paths);
+        double time = elapsedSeconds(startTime);
+        std::size_t routeBytes = numBytes - numBytesBefore;
+
+        solution.getX();
+
+        std::size_t decisionBytes = numBytes - numBytesBefore - routeBytes;
+
+        solution.getVehiclesE();
+
+        std::size_t indexBytes = numBytes - numBytesBefore - routeBytes - decisionBytes;
+
+        numBytesBefore = numBytes;
+
+        Solution copy(solution);
+        std::size_t copyBytes = numBytes - numBytesBefore;
+
+        std::cout << instance->getNumVertices() << ", " << 1.0e6 * time << ", " << routeBytes
+            << ", " << decisionBytes << ", " << indexBytes << ", " << copyBytes
+            << (copy == solution ? "" : " (differs)") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "Benchmark.hpp"
+#include <iostream>
+
+/***************************************************************************************
+ * Compares the time needed to add requests one at a time to an instance with the time
+ * needed to build the instance from scratch with the same requests, in both distance
+ * modes. Then measures retiring requests and moving a vehicle.
+ *
+ * Usage: MutationBenchmark [numRequests] [numVehicles] [numAdditions]
+ ***************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 1000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 10);
+    unsigned numAdditions = getArgument(argc, argv, 3, 1000);
+
+    for(DistanceMode mode : {DistanceMode::MATRIX, DistanceMode::ON_THE_FLY}) {
+        Instance instance = randomInstance(numRequests, numVehicles, 0, mode);
+        Instance finalInstance = randomInstance(numRequests + numAdditions, numVehicles, 0, mode);
+        unsigned numVertices = instance.getNumVertices();
+        auto startTime = std::chrono::steady_clock::now();
+
+        // the random instances share their first vertices, so the additions rebuild the other
+        for(unsigned r = numRequests; r < numRequests + numAdditions; r++) {
+            unsigned sourceR = finalInstance.getSourceR(r);
+            unsigned targetR = finalInstance.getTargetR(r);
+
+            instance.addRequest(finalInstance.getProfit(r), finalInstance.getTCreate(r),
+                    finalInstance.getDemandR(r), finalInstance.getX(sourceR),
+                    finalInstance.getY(sourceR), finalInstance.getTVisit(sourceR),
+                    finalInstance.getX(targetR), finalInstance.getY(targetR),
+                    finalInstance.getTVisit(targetR));
+        }
+
+        double addTime = elapsedSeconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        Instance rebuiltInstance = randomInstance(numRequests + numAdditions, numVehicles, 0,
+                mode);
+        double rebuildTime = elapsedSeconds(startTime);
+
+        bool equal = true;
+
+        for(unsigned v = numVertices; v < instance.getNumVertices(); v++) {
+            for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+                equal = equal && instance.getLength(u, v) == rebuiltInstance.getLength(u, v);
+            }
+        }
+
+        startTime = std::chrono::steady_clock::now();
+
+        for(unsigned r = 0; r < numAdditions; r++) {
+            instance.removeRequest(r);
+        }
+
+        double removeTime = elapsedSeconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        instance.updateVehicle(0, 500.0, 500.0, 10.0, 1.0e6, 1000.0);
+        double updateTime = elapsedSeconds(startTime);
+
+        std::cout << (mode == DistanceMode::MATRIX ? "matrix" : "on the fly") << " ("
+            << numVertices << " vertices): add " << 1.0e6 * addTime / numAdditions
+            << " us/request, rebuild " << 1.0e3 * rebuildTime << " ms, remove "
+            << 1.0e6 * removeTime / numAdditions << " us/request, update vehicle "
+            << 1.0e6 * updateTime << " us" << (equal ? "" : " (lengths differ)") << std::endl;
+    }
+
+    return 0;
+}
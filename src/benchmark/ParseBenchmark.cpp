@@ -0,0 +1,83 @@
+#include "Benchmark.hpp"
+#include "../instance/InstanceReader.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**********************************************************************************************
+ * Compares the throughput of the InstanceReader with the stream extraction previously used to
+ * parse instances. Only the records are parsed, since the lengths of an instance this large
+ * would not fit into memory.
+ *
+ * Usage: ParseBenchmark [numRequests] [numVehicles]
+ **********************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 1000000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 100);
+    std::string filename = "/tmp/ParseBenchmark.in";
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> coordinate(0, 1000);
+    std::uniform_int_distribution<int> demand(1, 10);
+    std::uniform_real_distribution<double> tCreate(0.0, 10000.0);
+
+    std::ofstream ofs(filename);
+
+    for(unsigned k = 0; k < numVehicles; k++) {
+        ofs << "k 0 10000 1 100 " << coordinate(generator) << " " << coordinate(generator)
+            << " 0 " << coordinate(generator) << " " << coordinate(generator) << " 0\n";
+    }
+
+    for(unsigned r = 0; r < numRequests; r++) {
+        int d = demand(generator);
+
+        ofs << "r " << d << " " << tCreate(generator) << " " << d << " "
+            << coordinate(generator) << " " << coordinate(generator) << " 1.5 "
+            << coordinate(generator) << " " << coordinate(generator) << " 1.5\n";
+    }
+
+    ofs.close();
+
+    std::ifstream ifs(filename);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    std::string buffer = ss.str();
+
+    std::vector<double> profits, tCreates, demandsR, tStarts, tLimits, speeds, capacities;
+    std::vector<double> x, y, tVisits;
+    std::vector<unsigned> sourcesR, targetsR, sourcesK, targetsK;
+
+    auto startTime = std::chrono::steady_clock::now();
+    InstanceReader(buffer.data(), buffer.data() + buffer.size()).read(profits, tCreates,
+            demandsR, sourcesR, targetsR, tStarts, tLimits, speeds, capacities, sourcesK,
+            targetsK, x, y, tVisits);
+    double readerTime = elapsedSeconds(startTime);
+
+    std::istringstream is(buffer);
+    std::vector<double> values;
+    double value;
+    char c;
+
+    startTime = std::chrono::steady_clock::now();
+
+    while(is >> c) {
+        for(unsigned i = 0; i < (c == 'k' ? 10u : 9u) && is >> value; i++) {
+            values.push_back(value);
+        }
+    }
+
+    double streamTime = elapsedSeconds(startTime);
+    double megabytes = buffer.size() / 1e6;
+    bool equal = profits.size() == numRequests && tStarts.size() == numVehicles &&
+        values.size() == 10 * numVehicles + 9 * numRequests && values.back() == tVisits.back();
+
+    std::cout << "requests: " << numRequests << ", size: " << megabytes << " MB" << std::endl;
+    std::cout << "reader: " << readerTime << " s (" << megabytes / readerTime << " MB/s)"
+        << std::endl;
+    std::cout << "stream: " << streamTime << " s (" << megabytes / streamTime << " MB/s)"
+        << std::endl;
+
+    remove(filename.c_str());
+
+    return equal ? 0 : 1;
+}
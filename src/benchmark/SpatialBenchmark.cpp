@@ -0,0 +1,105 @@
+#include "Benchmark.hpp"
+#include "../instance/CandidateLists.hpp"
+#include <iostream>
+
+/******************************************************************************************
+ * Compares the latency of the k-nearest and radius queries of the spatial index with a
+ * brute force scan over every vertex, and measures the time needed to build the index
+ * and the candidate lists.
+ *
+ * Usage: SpatialBenchmark [numRequests] [numVehicles] [numQueries] [k] [radius]
+ ******************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 50000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 50);
+    unsigned numQueries = getArgument(argc, argv, 3, 10000);
+    unsigned k = getArgument(argc, argv, 4, 10);
+    double radius = getArgument(argc, argv, 5, 20);
+
+    Instance instance = randomInstance(numRequests, numVehicles, 0, DistanceMode::ON_THE_FLY);
+    unsigned numVertices = instance.getNumVertices();
+
+    auto startTime = std::chrono::steady_clock::now();
+    SpatialIndex index(instance.getX(), instance.getY());
+    double indexTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    CandidateLists candidates(instance, k);
+    double candidatesTime = elapsedSeconds(startTime);
+
+    std::vector<unsigned> queries(numQueries), vertices(numVertices), nearest;
+    std::vector<std::pair<double, unsigned>> distances(numVertices);
+    std::vector<std::vector<unsigned>> indexNearest(numQueries), bruteNearest(numQueries);
+    unsigned long indexCount = 0, bruteCount = 0;
+
+    for(unsigned q = 0; q < numQueries; q++) {
+        queries[q] = (7919ul * q) % numVertices;
+    }
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned q = 0; q < numQueries; q++) {
+        index.getNearest(instance.getX(queries[q]), instance.getY(queries[q]), k,
+                indexNearest[q]);
+    }
+
+    double indexNearestTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned q = 0; q < numQueries; q++) {
+        double x = instance.getX(queries[q]), y = instance.getY(queries[q]);
+
+        for(unsigned v = 0; v < numVertices; v++) {
+            double dx = x - instance.getX(v), dy = y - instance.getY(v);
+
+            distances[v] = std::make_pair(dx*dx + dy*dy, v);
+        }
+
+        unsigned size = std::min(k, numVertices);
+
+        std::partial_sort(distances.begin(), distances.begin() + size, distances.end());
+
+        for(unsigned i = 0; i < size; i++) {
+            bruteNearest[q].push_back(distances[i].second);
+        }
+    }
+
+    double bruteNearestTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned q = 0; q < numQueries; q++) {
+        index.getWithinRadius(instance.getX(queries[q]), instance.getY(queries[q]), radius,
+                vertices);
+        indexCount += vertices.size();
+    }
+
+    double indexRadiusTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned q = 0; q < numQueries; q++) {
+        double x = instance.getX(queries[q]), y = instance.getY(queries[q]);
+
+        for(unsigned v = 0; v < numVertices; v++) {
+            double dx = x - instance.getX(v), dy = y - instance.getY(v);
+
+            bruteCount += dx*dx + dy*dy <= radius * radius;
+        }
+    }
+
+    double bruteRadiusTime = elapsedSeconds(startTime);
+
+    std::cout << "vertices: " << numVertices << std::endl;
+    std::cout << "construction: index " << indexTime << " s, " << k
+        << " candidates per vertex " << candidatesTime << " s" << std::endl;
+    std::cout << k << "-nearest query: index " << 1.0e6 * indexNearestTime / numQueries
+        << " us, brute force " << 1.0e6 * bruteNearestTime / numQueries << " us" << std::endl;
+    std::cout << "radius " << radius << " query: index " << 1.0e6 * indexRadiusTime / numQueries
+        << " us, brute force " << 1.0e6 * bruteRadiusTime / numQueries << " us, "
+        << (double) indexCount / numQueries << " vertices per query" << std::endl;
+
+    return (indexNearest == bruteNearest && indexCount == bruteCount &&
+            candidates.getSources(0).size() == std::min(k, numRequests)) ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#include "Benchmark.hpp"
+#include "../solution/Solution.hpp"
+#include <iostream>
+#include <memory>
+
+/************************************************************************************
+ * Evaluates the specified path reading the attributes of each vertex from the
+ * parallel arrays of the instance and a bit-packed array of target flags, and
+ * returns the sum of the fulfillment times.
+ *
+ * @param instance  the instance.
+ * @param isTargetV the flags indicating whether each vertex is a target.
+ * @param path      the path to be evaluated.
+ *
+ * @return the sum of the fulfillment times along the path.
+ ************************************************************************************/
+static double evaluateArrays(const Instance & instance, const std::vector<bool> & isTargetV,
+        const std::vector<unsigned> & path) {
+    ArrayView<double> demandsV = instance.getDemandsV();
+    ArrayView<double> tVisits = instance.getTVisits();
+    ArrayView<unsigned> requestsV = instance.getRequestsV();
+    double load = 0.0, time = 0.0, sumTFulfill = 0.0;
+
+    for(unsigned v : path) {
+        load += demandsV[v];
+        time += tVisits[v];
+
+        if(requestsV[v] < instance.getNumRequests() && isTargetV[v]) {
+            sumTFulfill += time - load;
+        }
+    }
+
+    return sumTFulfill;
+}
+
+/************************************************************************************
+ * Evaluates the specified path reading the attributes of each vertex from its
+ * record, and returns the sum of the fulfillment times.
+ *
+ * @param instance the instance.
+ * @param path     the path to be evaluated.
+ *
+ * @return the sum of the fulfillment times along the path.
+ ************************************************************************************/
+static double evaluateRecords(const Instance & instance, const std::vector<unsigned> & path) {
+    double load = 0.0, time = 0.0, sumTFulfill = 0.0;
+
+    for(unsigned v : path) {
+        const VertexRecord & vertex = instance.getVertex(v);
+
+        load += vertex.demand;
+        time += vertex.tVisit;
+
+        if(vertex.role == VertexRole::REQUEST_TARGET) {
+            sumTFulfill += time - load;
+        }
+    }
+
+    return sumTFulfill;
+}
+
+/***************************************************************************************
+ * Measures the cost of evaluating paths node by node, reading the attributes of each
+ * vertex either from the parallel arrays of the instance or from its packed record,
+ * on an instance too large for its vertices to stay in cache. Then measures the
+ * construction of solutions, whose path loops read the records.
+ *
+ * Usage: VertexBenchmark [numRequests] [numVehicles] [numIterations]
+ ***************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 1000000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 100);
+    unsigned numIterations = getArgument(argc, argv, 3, 10);
+    Instance instance = randomInstance(numRequests, numVehicles, 0, DistanceMode::ON_THE_FLY);
+    std::vector<std::vector<unsigned>> paths = randomPaths(instance, 0);
+    std::vector<bool> isTargetV(instance.getNumVertices(), false);
+    double checksumArrays = 0.0, checksumRecords = 0.0;
+
+    for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+        isTargetV[v] = instance.isATarget(v);
+    }
+
+    std::cout << "vertices: " << instance.getNumVertices() << std::endl;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        for(const std::vector<unsigned> & path : paths) {
+            checksumArrays += evaluateArrays(instance, isTargetV, path);
+        }
+    }
+
+    double timeArrays = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        for(const std::vector<unsigned> & path : paths) {
+            checksumRecords += evaluateRecords(instance, path);
+        }
+    }
+
+    double timeRecords = elapsedSeconds(startTime);
+    double numNodes = double(numIterations) * instance.getNumVertices();
+
+    std::cout << "parallel arrays: " << 1.0e9 * timeArrays / numNodes << " ns/node (checksum "
+        << checksumArrays << ")" << std::endl;
+    std::cout << "vertex records: " << 1.0e9 * timeRecords / numNodes << " ns/node (checksum "
+        << checksumRecords << ")" << std::endl;
+
+    // the solutions allocate quadratic structures, so they are built on a smaller instance
+    std::shared_ptr<const Instance> smallInstance =
+        std::make_shared<const Instance>(randomInstance(500, 10, 0));
+    std::vector<std::vector<unsigned>> smallPaths = randomPaths(* smallInstance, 0);
+    double checksum = 0.0;
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned it = 0; it < numIterations; it++) {
+        checksum += Solution(smallInstance, smallPaths).getSumTFulfill();
+    }
+
+    std::cout << "solution construction (" << smallInstance->getNumVertices() << " vertices): "
+        << 1.0e3 * elapsedSeconds(startTime) / numIterations << " ms (checksum " << checksum
+        << ")" << std::endl;
+
+    return checksumArrays == checksumRecords ? 0 : 1;
+}
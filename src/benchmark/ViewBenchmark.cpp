@@ -0,0 +1,119 @@
+#include "Benchmark.hpp"
+#include <iostream>
+#include <memory>
+#include <numeric>
+
+/*****************************************************************************************
+ * Compares the time needed to build the sub-instances of random subsets of requests and
+ * vehicles as new instances, copying the attributes and computing the lengths, with the
+ * time needed to build them as views of the instance. Then compares the time needed to
+ * read every length of the sub-instances.
+ *
+ * Usage: ViewBenchmark [numRequests] [numVehicles] [numSubRequests] [numSubVehicles]
+ *                      [numSubsets]
+ *****************************************************************************************/
+int main(int argc, char ** argv) {
+    unsigned numRequests = getArgument(argc, argv, 1, 1000);
+    unsigned numVehicles = getArgument(argc, argv, 2, 10);
+    unsigned numSubRequests = std::min(getArgument(argc, argv, 3, 100), numRequests);
+    unsigned numSubVehicles = std::min(getArgument(argc, argv, 4, 2), numVehicles);
+    unsigned numSubsets = getArgument(argc, argv, 5, 100);
+    std::shared_ptr<const Instance> instance = std::make_shared<const Instance>(
+            randomInstance(numRequests, numVehicles, 0));
+    std::vector<std::vector<unsigned>> subsetsR(numSubsets), subsetsK(numSubsets);
+    std::default_random_engine generator(0);
+
+    for(unsigned i = 0; i < numSubsets; i++) {
+        std::vector<unsigned> requests(numRequests), vehicles(numVehicles);
+
+        std::iota(requests.begin(), requests.end(), 0);
+        std::iota(vehicles.begin(), vehicles.end(), 0);
+        std::shuffle(requests.begin(), requests.end(), generator);
+        std::shuffle(vehicles.begin(), vehicles.end(), generator);
+
+        subsetsR[i].assign(requests.begin(), requests.begin() + numSubRequests);
+        subsetsK[i].assign(vehicles.begin(), vehicles.begin() + numSubVehicles);
+    }
+
+    std::vector<Instance> copies, views;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(unsigned i = 0; i < numSubsets; i++) {
+        std::vector<double> profits, tCreates, demandsR, tStarts, tLimits, speeds, capacities;
+        std::vector<unsigned> sourcesR, targetsR, sourcesK, targetsK;
+        std::vector<double> x, y, tVisits;
+
+        // appends the specified vertex of the instance to the sub-instance
+        auto addVertex = [&](unsigned v) {
+            x.push_back(instance->getX(v));
+            y.push_back(instance->getY(v));
+            tVisits.push_back(instance->getTVisit(v));
+        };
+
+        for(unsigned k : subsetsK[i]) {
+            tStarts.push_back(instance->getTStart(k));
+            tLimits.push_back(instance->getTLimit(k));
+            speeds.push_back(instance->getSpeed(k));
+            capacities.push_back(instance->getCapacity(k));
+            sourcesK.push_back(x.size());
+            addVertex(instance->getSourceK(k));
+            targetsK.push_back(x.size());
+            addVertex(instance->getTargetK(k));
+        }
+
+        for(unsigned r : subsetsR[i]) {
+            profits.push_back(instance->getProfit(r));
+            tCreates.push_back(instance->getTCreate(r));
+            demandsR.push_back(instance->getDemandR(r));
+            sourcesR.push_back(x.size());
+            addVertex(instance->getSourceR(r));
+            targetsR.push_back(x.size());
+            addVertex(instance->getTargetR(r));
+        }
+
+        copies.push_back(Instance(profits, tCreates, demandsR, sourcesR, targetsR, tStarts,
+                    tLimits, speeds, capacities, sourcesK, targetsK, x, y, tVisits));
+    }
+
+    double copyTime = elapsedSeconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(unsigned i = 0; i < numSubsets; i++) {
+        views.push_back(Instance(instance, subsetsR[i], subsetsK[i]));
+    }
+
+    double viewTime = elapsedSeconds(startTime);
+
+    // reads every travelling time of the specified sub-instances
+    auto readTravelTimes = [](const std::vector<Instance> & subInstances, double & sum) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        for(const Instance & subInstance : subInstances) {
+            for(unsigned k = 0; k < subInstance.getNumVehicles(); k++) {
+                for(unsigned u = 0; u < subInstance.getNumVertices(); u++) {
+                    for(unsigned v = 0; v < subInstance.getNumVertices(); v++) {
+                        sum += subInstance.getTravelTime(u, v, k);
+                    }
+                }
+            }
+        }
+
+        return elapsedSeconds(startTime);
+    };
+
+    double copySum = 0.0, viewSum = 0.0;
+    double copyReadTime = readTravelTimes(copies, copySum);
+    double viewReadTime = readTravelTimes(views, viewSum);
+
+    std::cout << numSubsets << " sub-instances of " << numSubRequests << " requests and "
+        << numSubVehicles << " vehicles out of " << instance->getNumVertices() << " vertices"
+        << std::endl;
+    std::cout << "build: copies " << 1.0e6 * copyTime / numSubsets << " us, views "
+        << 1.0e6 * viewTime / numSubsets << " us per sub-instance" << std::endl;
+    std::cout << "read travelling times: copies " << 1.0e3 * copyReadTime << " ms, views "
+        << 1.0e3 * viewReadTime << " ms" << (copySum == viewSum ? "" : " (sums differ)")
+        << std::endl;
+
+    return 0;
+}
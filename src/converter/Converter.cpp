@@ -0,0 +1,90 @@
+#include "../instance/Instance.hpp"
+#include <dirent.h>
+#include <string>
+#include <sys/stat.h>
+
+/****************************************************************************************
+ * Converts the specified file into the binary format.
+ *
+ * @param input  the file to be converted, in the text, Li & Lim or binary format.
+ * @param output the file to write into.
+ *
+ * @return true if the file was converted; false otherwise.
+ ****************************************************************************************/
+static bool convert(const std::string & input, const std::string & output) {
+    try {
+        Instance instance(input);
+
+        instance.writeBinary(output.c_str());
+    } catch(const char * e) {
+        std::cerr << input << ": " << e << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/****************************************************************************************
+ * Verifies whether the specified path is a directory.
+ *
+ * @param path the path to be verified.
+ *
+ * @return true if the specified path is a directory; false otherwise.
+ ****************************************************************************************/
+static bool isDirectory(const std::string & path) {
+    struct stat status;
+
+    return stat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+/**************************************************************************************
+ * Converts an instance into the binary format, which is mapped into memory instead of
+ * parsed when it is loaded. When the input is a directory, every instance in it is
+ * converted into a file of the output directory with the same name and the .bin
+ * extension, so a whole Li & Lim benchmark set can be converted at once.
+ *
+ * Usage: Converter <input file> <output file>
+ *        Converter <input directory> <output directory>
+ **************************************************************************************/
+int main(int argc, char ** argv) {
+    if(argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input file> <output file>" << std::endl;
+        std::cerr << "       " << argv[0] << " <input directory> <output directory>"
+            << std::endl;
+        return 1;
+    }
+
+    if(!isDirectory(argv[1])) {
+        return convert(argv[1], argv[2]) ? 0 : 1;
+    }
+
+    DIR * directory = opendir(argv[1]);
+    unsigned numFailures = 0;
+
+    if(directory == nullptr) {
+        std::cerr << argv[1] << ": Directory not found." << std::endl;
+        return 1;
+    }
+
+    mkdir(argv[2], 0755);
+
+    for(dirent * entry = readdir(directory); entry != nullptr; entry = readdir(directory)) {
+        std::string name = entry->d_name;
+        std::string input = std::string(argv[1]) + "/" + name;
+
+        if(name[0] == '.' || isDirectory(input)) {
+            continue;
+        }
+
+        std::string output = std::string(argv[2]) + "/" + name.substr(0, name.rfind('.')) +
+            ".bin";
+
+        if(!convert(input, output)) {
+            numFailures++;
+        }
+    }
+
+    closedir(directory);
+
+    return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+#include "InstanceGenerator.hpp"
+#include "../instance/CompressedStream.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+/*******************************************************************************************
+ * Generates a random instance and writes it into the specified file, in the binary format
+ * if its name ends with .bin and in the text format otherwise, compressed if its name ends
+ * with .gz or .zst. Text instances are generated in the ON_THE_FLY mode, so they can be
+ * arbitrarily large.
+ *
+ * Usage: Generator <output file> [numRequests] [numVehicles] [seed]
+ *                  [uniform|clustered|mixed] [batch|poisson|rush-hour] [demandRatio]
+ *                  [numSpeeds]
+ *******************************************************************************************/
+int main(int argc, char ** argv) {
+    if(argc < 2 || argc > 9) {
+        std::cerr << "Usage: " << argv[0] << " <output file> [numRequests] [numVehicles] [seed]"
+            " [uniform|clustered|mixed] [batch|poisson|rush-hour] [demandRatio] [numSpeeds]"
+            << std::endl;
+        return 1;
+    }
+
+    try {
+        InstanceGenerator generator(argc > 2 ? strtoul(argv[2], nullptr, 10) : 100,
+                argc > 3 ? strtoul(argv[3], nullptr, 10) : 10,
+                argc > 4 ? strtoul(argv[4], nullptr, 10) : 0);
+        std::size_t length = strlen(argv[1]);
+        bool binary = length >= 4 && strcmp(argv[1] + length - 4, ".bin") == 0;
+
+        if(argc > 5) {
+            generator.setSpatialDistribution(toSpatialDistribution(argv[5]));
+        }
+
+        if(argc > 6) {
+            generator.setArrivalProcess(toArrivalProcess(argv[6]));
+        }
+
+        if(argc > 7) {
+            generator.setDemandRatio(strtod(argv[7], nullptr));
+        }
+
+        if(argc > 8) {
+            generator.setNumSpeeds(strtoul(argv[8], nullptr, 10));
+        }
+
+        if(binary) {
+            generator.generate(DistanceMode::MATRIX).writeBinary(argv[1]);
+        } else {
+            CompressedOutputStream os(argv[1]);
+
+            // enough digits for the values to be read back exactly
+            os.precision(std::numeric_limits<double>::max_digits10);
+            generator.generate(DistanceMode::ON_THE_FLY).write(os);
+            os.close();
+        }
+    } catch(const char * e) {
+        std::cerr << e << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "InstanceGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+constexpr double InstanceGenerator::SIDE;
+constexpr double InstanceGenerator::HORIZON;
+
+InstanceGenerator::InstanceGenerator(unsigned numRequests, unsigned numVehicles, unsigned seed) :
+    numRequests(numRequests),
+    numVehicles(numVehicles),
+    spatialDistribution(SpatialDistribution::UNIFORM),
+    arrivalProcess(ArrivalProcess::BATCH),
+    demandRatio(0.1),
+    numSpeeds(1),
+    seed(seed) {}
+
+void InstanceGenerator::setSpatialDistribution(SpatialDistribution spatialDistribution) {
+    this->spatialDistribution = spatialDistribution;
+}
+
+void InstanceGenerator::setArrivalProcess(ArrivalProcess arrivalProcess) {
+    this->arrivalProcess = arrivalProcess;
+}
+
+void InstanceGenerator::setDemandRatio(double demandRatio) {
+    // written so that NaN is rejected as well
+    if(!(demandRatio > 0.0)) {
+        throw "Invalid demand ratio.";
+    }
+
+    this->demandRatio = demandRatio;
+}
+
+void InstanceGenerator::setNumSpeeds(unsigned numSpeeds) {
+    this->numSpeeds = std::max(numSpeeds, 1u);
+}
+
+Instance InstanceGenerator::generate(DistanceMode mode) const {
+    std::mt19937 generator(this->seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<unsigned> value(1, 10);
+    std::vector<double> profits, tCreates, demandsR, tStarts, tLimits, speeds, capacities;
+    std::vector<unsigned> sourcesR, targetsR, sourcesK, targetsK;
+    std::vector<double> x, y, tVisits;
+
+    // about one cluster per hundred vertices, each spread over a twentieth of the side
+    unsigned numClusters = std::max(1u, 2 * (this->numRequests + this->numVehicles) / 100);
+    std::vector<double> xClusters, yClusters;
+    std::normal_distribution<double> spread(0.0, SIDE / 20.0);
+
+    for(unsigned c = 0; c < numClusters; c++) {
+        xClusters.push_back(SIDE * unit(generator));
+        yClusters.push_back(SIDE * unit(generator));
+    }
+
+    // adds a vertex at a random point of the square
+    auto addVertex = [&]() {
+        bool clustered = this->spatialDistribution == SpatialDistribution::CLUSTERED ||
+            (this->spatialDistribution == SpatialDistribution::MIXED && unit(generator) < 0.5);
+
+        if(clustered) {
+            unsigned c = std::min((unsigned) (numClusters * unit(generator)), numClusters - 1);
+
+            x.push_back(std::min(std::max(xClusters[c] + spread(generator), 0.0), SIDE));
+            y.push_back(std::min(std::max(yClusters[c] + spread(generator), 0.0), SIDE));
+        } else {
+            x.push_back(SIDE * unit(generator));
+            y.push_back(SIDE * unit(generator));
+        }
+
+        tVisits.push_back(value(generator));
+    };
+
+    // the average demand is the average of the uniform integers between 1 and 10
+    double capacity = 5.5 / this->demandRatio;
+
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        tStarts.push_back(0.0);
+        tLimits.push_back(HORIZON);
+        speeds.push_back(1.0 + std::min((unsigned) (this->numSpeeds * unit(generator)),
+                    this->numSpeeds - 1));
+        capacities.push_back(std::max(1.0, round(capacity * (0.5 + unit(generator)))));
+        sourcesK.push_back(x.size());
+        addVertex();
+        targetsK.push_back(x.size());
+        addVertex();
+    }
+
+    // the arrivals are spread over the first three quarters of the horizon
+    double tLast = 0.75 * HORIZON;
+    double tCreate = 0.0;
+    std::exponential_distribution<double> interarrival(std::max(this->numRequests, 1u) / tLast);
+    std::normal_distribution<double> peak(0.0, tLast / 16.0);
+
+    for(unsigned r = 0; r < this->numRequests; r++) {
+        demandsR.push_back(value(generator));
+        profits.push_back(demandsR.back());
+
+        if(this->arrivalProcess == ArrivalProcess::POISSON) {
+            tCreate += interarrival(generator);
+            tCreates.push_back(tCreate);
+        } else if(this->arrivalProcess == ArrivalProcess::RUSH_HOUR) {
+            double u = unit(generator);
+
+            if(u < 0.2) {
+                tCreates.push_back(tLast * unit(generator));
+            } else {
+                tCreates.push_back((u < 0.6 ? 0.25 : 0.75) * tLast + peak(generator));
+            }
+
+            tCreates.back() = std::min(std::max(tCreates.back(), 0.0), tLast);
+        } else {
+            tCreates.push_back(0.0);
+        }
+
+        sourcesR.push_back(x.size());
+        addVertex();
+        targetsR.push_back(x.size());
+        addVertex();
+    }
+
+    std::sort(tCreates.begin(), tCreates.end());
+
+    return Instance(profits, tCreates, demandsR, sourcesR, targetsR, tStarts, tLimits, speeds,
+            capacities, sourcesK, targetsK, x, y, tVisits, mode);
+}
+
+Instance InstanceGenerator::generate() const {
+    return this->generate(DistanceMode::MATRIX);
+}
+
+SpatialDistribution toSpatialDistribution(const std::string & name) {
+    if(name == "uniform") {
+        return SpatialDistribution::UNIFORM;
+    } else if(name == "clustered") {
+        return SpatialDistribution::CLUSTERED;
+    } else if(name == "mixed") {
+        return SpatialDistribution::MIXED;
+    }
+
+    throw "Unknown spatial distribution.";
+}
+
+ArrivalProcess toArrivalProcess(const std::string & name) {
+    if(name == "batch") {
+        return ArrivalProcess::BATCH;
+    } else if(name == "poisson") {
+        return ArrivalProcess::POISSON;
+    } else if(name == "rush-hour") {
+        return ArrivalProcess::RUSH_HOUR;
+    }
+
+    throw "Unknown arrival process.";
+}
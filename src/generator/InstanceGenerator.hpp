@@ -0,0 +1,177 @@
+#pragma once
+
+#include "../instance/Instance.hpp"
+#include <string>
+
+/********************************************************************************************
+ * The ways the vertices of a generated instance can be spread over the square.
+ ********************************************************************************************/
+enum class SpatialDistribution {
+    /**************************************************************************
+     * The vertices are uniformly distributed.
+     **************************************************************************/
+    UNIFORM,
+
+    /**************************************************************************
+     * The vertices are normally distributed around random cluster centres.
+     **************************************************************************/
+    CLUSTERED,
+
+    /**************************************************************************
+     * Half of the vertices are uniformly distributed and half are clustered.
+     **************************************************************************/
+    MIXED
+};
+
+/********************************************************************************************
+ * The ways the creation times of the requests of a generated instance can be distributed.
+ ********************************************************************************************/
+enum class ArrivalProcess {
+    /**************************************************************************
+     * Every request is created at time zero.
+     **************************************************************************/
+    BATCH,
+
+    /**************************************************************************
+     * The requests arrive as a Poisson process along the horizon.
+     **************************************************************************/
+    POISSON,
+
+    /**************************************************************************
+     * Most requests arrive around a morning and an evening peak, on top of a
+     * uniform background.
+     **************************************************************************/
+    RUSH_HOUR
+};
+
+/*********************************************************************************************
+ * The InstanceGenerator class generates random instances of any size. The same parameters
+ * and seed always generate the same instance. The vertices lie in a square of side SIDE,
+ * every vehicle operates from time zero for HORIZON time units and the requests, listed in
+ * non decreasing order of creation time, are mostly created within the first three quarters
+ * of the horizon.
+ *********************************************************************************************/
+class InstanceGenerator {
+    private:
+        /***********************************************
+         * The side of the square holding the vertices.
+         ***********************************************/
+        static constexpr double SIDE = 1000.0;
+
+        /***********************************************************
+         * The time-limit of operation of every vehicle.
+         ***********************************************************/
+        static constexpr double HORIZON = 10000.0;
+
+        /**************************
+         * The number of requests.
+         **************************/
+        unsigned numRequests;
+
+        /**************************
+         * The number of vehicles.
+         **************************/
+        unsigned numVehicles;
+
+        /*****************************************
+         * The way the vertices are distributed.
+         *****************************************/
+        SpatialDistribution spatialDistribution;
+
+        /**************************************************************
+         * The way the creation times of the requests are distributed.
+         **************************************************************/
+        ArrivalProcess arrivalProcess;
+
+        /*****************************************************************************
+         * The ratio between the average demand of a request and the average capacity
+         * of a vehicle.
+         *****************************************************************************/
+        double demandRatio;
+
+        /*****************************************
+         * The number of distinct vehicle speeds.
+         *****************************************/
+        unsigned numSpeeds;
+
+        /****************************************************
+         * The seed for the pseudo-random numbers generator.
+         ****************************************************/
+        unsigned seed;
+
+    public:
+        /**************************************************************************************
+         * Constructs a new generator of uniform instances with batch arrivals, vehicles able
+         * to carry ten average requests and a single speed.
+         *
+         * @param numRequests the number of requests.
+         * @param numVehicles the number of vehicles.
+         * @param seed        the seed for the pseudo-random numbers generator.
+         **************************************************************************************/
+        InstanceGenerator(unsigned numRequests, unsigned numVehicles, unsigned seed);
+
+        /*******************************************************************
+         * Sets the way the vertices are distributed.
+         *
+         * @param spatialDistribution the way the vertices are distributed.
+         *******************************************************************/
+        void setSpatialDistribution(SpatialDistribution spatialDistribution);
+
+        /**************************************************************************
+         * Sets the way the creation times of the requests are distributed.
+         *
+         * @param arrivalProcess the way the creation times are distributed.
+         **************************************************************************/
+        void setArrivalProcess(ArrivalProcess arrivalProcess);
+
+        /*********************************************************************************
+         * Sets the ratio between the average demand of a request and the average
+         * capacity of a vehicle. Throws an exception if the ratio is not positive.
+         *
+         * @param demandRatio the ratio between the average demand and capacity.
+         *********************************************************************************/
+        void setDemandRatio(double demandRatio);
+
+        /**********************************************************
+         * Sets the number of distinct vehicle speeds.
+         *
+         * @param numSpeeds the number of distinct vehicle speeds.
+         **********************************************************/
+        void setNumSpeeds(unsigned numSpeeds);
+
+        /**************************************************************************
+         * Generates an instance.
+         *
+         * @param mode the way the lengths and travelling times are obtained.
+         *
+         * @return the generated instance.
+         **************************************************************************/
+        Instance generate(DistanceMode mode) const;
+
+        /**********************************************************************
+         * Generates an instance whose lengths and travelling times are stored
+         * in matrices.
+         *
+         * @return the generated instance.
+         **********************************************************************/
+        Instance generate() const;
+};
+
+/************************************************************************************
+ * Returns the spatial distribution with the specified name: uniform, clustered or
+ * mixed.
+ *
+ * @param name the name of the spatial distribution.
+ *
+ * @return the spatial distribution with the specified name.
+ ************************************************************************************/
+SpatialDistribution toSpatialDistribution(const std::string & name);
+
+/************************************************************************************
+ * Returns the arrival process with the specified name: batch, poisson or rush-hour.
+ *
+ * @param name the name of the arrival process.
+ *
+ * @return the arrival process with the specified name.
+ ************************************************************************************/
+ArrivalProcess toArrivalProcess(const std::string & name);
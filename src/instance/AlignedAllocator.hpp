@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**************************************************************************************
+ * The AlignedAllocator class represents an allocator of cache line aligned arrays, so
+ * that records whose size divides the cache line size never straddle two lines.
+ **************************************************************************************/
+template <class T>
+class AlignedAllocator {
+    public:
+        /******************************
+         * The type of the values.
+         ******************************/
+        typedef T value_type;
+
+        /*******************************************
+         * The alignment, in bytes, of the arrays.
+         *******************************************/
+        static const std::size_t ALIGNMENT = 64;
+
+        /*******************************
+         * Constructs a new allocator.
+         *******************************/
+        AlignedAllocator() {}
+
+        /*******************************************
+         * Constructs a new allocator.
+         *
+         * @param allocator the allocator to copy.
+         *******************************************/
+        template <class U>
+        AlignedAllocator(const AlignedAllocator<U> & allocator) {}
+
+        /****************************************************
+         * Allocates an array.
+         *
+         * @param n the number of values in the array.
+         *
+         * @return the first value of the array.
+         ****************************************************/
+        T * allocate(std::size_t n) {
+            void * buffer = nullptr;
+
+            if(posix_memalign(&buffer, ALIGNMENT, n * sizeof(T)) != 0) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T *>(buffer);
+        }
+
+        /*************************************************
+         * Deallocates an array.
+         *
+         * @param p the first value of the array.
+         *************************************************/
+        void deallocate(T * p, std::size_t) {
+            free(p);
+        }
+};
+
+template <class T, class U>
+bool operator == (const AlignedAllocator<T> &, const AlignedAllocator<U> &) {
+    return true;
+}
+
+template <class T, class U>
+bool operator != (const AlignedAllocator<T> &, const AlignedAllocator<U> &) {
+    return false;
+}
@@ -0,0 +1,266 @@
+#include "ArcFilter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+/****************************************************************
+ * The alignment, in bytes, of each array of a written filter.
+ ****************************************************************/
+static const std::size_t ALIGNMENT = 64;
+
+/*****************************************************
+ * The header of a written arc filter.
+ *****************************************************/
+struct ArcFilterHeader {
+    uint32_t numVertices;
+    uint32_t numVehicles;
+    uint64_t numWords;
+    uint64_t numArcs;
+};
+
+/*************************************************************************
+ * Moves the specified values into a buffer that copies can share.
+ *
+ * @param values the values.
+ *
+ * @return the shared buffer.
+ *************************************************************************/
+template <class T>
+static std::shared_ptr<const T> share(std::vector<T> && values) {
+    auto buffer = std::make_shared<const std::vector<T>>(std::move(values));
+
+    return std::shared_ptr<const T>(buffer, buffer->data());
+}
+
+/**********************************************************************************
+ * Returns a lower bound on the time at which the specified vehicle can start
+ * visiting the specified vertex.
+ *
+ * @param instance the instance.
+ * @param v        the vertex.
+ * @param k        the vehicle.
+ *
+ * @return a lower bound on the time at which the vehicle can start visiting v.
+ **********************************************************************************/
+static double getEarliestStart(const Instance & instance, unsigned v, unsigned k) {
+    const VertexRecord & vertex = instance.getVertex(v);
+    unsigned sourceK = instance.getSourceK(k);
+    double tDepart = instance.getTStart(k) + instance.getTVisit(sourceK);
+
+    switch(vertex.role) {
+        case VertexRole::REQUEST_SOURCE:
+            return std::max(tDepart + instance.getTravelTime(sourceK, v, k),
+                    instance.getTCreate(vertex.request));
+        case VertexRole::REQUEST_TARGET: {
+            unsigned sourceR = instance.getSourceR(vertex.request);
+
+            return getEarliestStart(instance, sourceR, k) + instance.getTVisit(sourceR) +
+                instance.getTravelTime(sourceR, v, k);
+        }
+        case VertexRole::VEHICLE_TARGET:
+            return tDepart + instance.getTravelTime(sourceK, v, k);
+        default:
+            return instance.getTStart(k);
+    }
+}
+
+/**********************************************************************************
+ * Returns a lower bound on the time the specified vehicle needs to go from the
+ * start of its visit to the specified vertex to the start of its visit to its
+ * target.
+ *
+ * @param instance the instance.
+ * @param v        the vertex.
+ * @param k        the vehicle.
+ *
+ * @return a lower bound on the time needed to go from v to the target of k.
+ **********************************************************************************/
+static double getMinTail(const Instance & instance, unsigned v, unsigned k) {
+    const VertexRecord & vertex = instance.getVertex(v);
+    unsigned targetK = instance.getTargetK(k);
+
+    switch(vertex.role) {
+        case VertexRole::REQUEST_SOURCE: {
+            unsigned targetR = instance.getTargetR(vertex.request);
+
+            return vertex.tVisit + instance.getTravelTime(v, targetR, k) +
+                instance.getTVisit(targetR) + instance.getTravelTime(targetR, targetK, k);
+        }
+        case VertexRole::VEHICLE_TARGET:
+            return 0.0;
+        default:
+            return vertex.tVisit + instance.getTravelTime(v, targetK, k);
+    }
+}
+
+ArcFilter::ArcFilter(const Instance & instance) :
+    numVertices(instance.getNumVertices()),
+    numVehicles(instance.getNumVehicles()),
+    numWords((instance.getNumVertices() + 63) / 64) {
+    std::vector<uint64_t> bits(std::size_t(this->numVehicles) * this->numVertices *
+            this->numWords, 0);
+    std::vector<std::size_t> starts(1, 0);
+    std::vector<unsigned> successors;
+
+    starts.reserve(std::size_t(this->numVehicles) * this->numVertices + 1);
+
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        for(unsigned u = 0; u < this->numVertices; u++) {
+            std::size_t row = (std::size_t(k) * this->numVertices + u) * this->numWords;
+
+            for(unsigned v = 0; v < this->numVertices; v++) {
+                if(ArcFilter::isArcFeasible(instance, u, v, k)) {
+                    bits[row + v / 64] |= uint64_t(1) << (v % 64);
+                    successors.push_back(v);
+                }
+            }
+
+            starts.push_back(successors.size());
+        }
+    }
+
+    this->numArcs = successors.size();
+    this->bits = share(std::move(bits));
+    this->starts = share(std::move(starts));
+    this->successors = share(std::move(successors));
+}
+
+ArcFilter::ArcFilter(const std::shared_ptr<MappedFile> & file, std::size_t offset) {
+    ArcFilterHeader header;
+
+    if(file->size() < offset + sizeof(header)) {
+        throw "Invalid arc filter.";
+    }
+
+    memcpy(&header, file->getData() + offset, sizeof(header));
+    offset += sizeof(header);
+
+    this->numVertices = header.numVertices;
+    this->numVehicles = header.numVehicles;
+    this->numWords = header.numWords;
+    this->numArcs = header.numArcs;
+
+    // returns the next array of the file, used in place
+    auto next = [&](auto & values, std::size_t size) {
+        typedef typename std::remove_reference<decltype(values)>::type::element_type T;
+        std::size_t begin = ((offset + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+        offset = begin + size * sizeof(T);
+
+        if(offset > file->size()) {
+            throw "Invalid arc filter.";
+        }
+
+        values = std::shared_ptr<const T>(file, reinterpret_cast<const T *>(file->getData() +
+                    begin));
+    };
+
+    std::size_t numRows = std::size_t(this->numVehicles) * this->numVertices;
+
+    next(this->bits, numRows * this->numWords);
+    next(this->starts, numRows + 1);
+    next(this->successors, this->numArcs);
+}
+
+ArcFilter::ArcFilter() :
+    numVertices(0),
+    numVehicles(0),
+    numWords(0),
+    numArcs(0),
+    bits(share(std::vector<uint64_t>())),
+    starts(share(std::vector<std::size_t>(1, 0))),
+    successors(share(std::vector<unsigned>())) {}
+
+ArrayView<unsigned> ArcFilter::getSuccessors(unsigned u, unsigned k) const {
+    std::size_t i = std::size_t(k) * this->numVertices + u;
+    const std::size_t * starts = this->starts.get();
+
+    return ArrayView<unsigned>(this->successors.get() + starts[i], starts[i + 1] - starts[i]);
+}
+
+std::size_t ArcFilter::getNumArcs() const {
+    return this->numArcs;
+}
+
+bool ArcFilter::isArcFeasible(const Instance & instance, unsigned u, unsigned v, unsigned k) {
+    const VertexRecord & a = instance.getVertex(u);
+    const VertexRecord & b = instance.getVertex(v);
+    bool isDepotA = a.role == VertexRole::VEHICLE_SOURCE || a.role == VertexRole::VEHICLE_TARGET;
+    bool isDepotB = b.role == VertexRole::VEHICLE_SOURCE || b.role == VertexRole::VEHICLE_TARGET;
+    double epsilon = std::numeric_limits<float>::epsilon();
+
+    if(u == v || (isDepotA && a.vehicle != k) || (isDepotB && b.vehicle != k)) {
+        return false;
+    }
+
+    if((!isDepotA && a.request < instance.getNumRequests() &&
+                !instance.isEligible(a.request, k)) ||
+            (!isDepotB && b.request < instance.getNumRequests() &&
+             !instance.isEligible(b.request, k))) {
+        return false;
+    }
+
+    if(a.role == VertexRole::VEHICLE_TARGET || b.role == VertexRole::VEHICLE_SOURCE) {
+        return false;
+    }
+
+    if((a.role == VertexRole::VEHICLE_SOURCE && b.role == VertexRole::REQUEST_TARGET) ||
+            (a.role == VertexRole::REQUEST_SOURCE && b.role == VertexRole::VEHICLE_TARGET)) {
+        return false;
+    }
+
+    if(a.role == VertexRole::REQUEST_TARGET && b.role == VertexRole::REQUEST_SOURCE &&
+            a.request == b.request) {
+        return false;
+    }
+
+    // the load on board when arriving at a target includes its own demand
+    double load = a.role == VertexRole::REQUEST_SOURCE ? a.demand : 0.0;
+
+    if(b.role == VertexRole::REQUEST_SOURCE) {
+        load += b.demand;
+    } else if(b.role == VertexRole::REQUEST_TARGET &&
+            (a.role != VertexRole::REQUEST_SOURCE || a.request != b.request)) {
+        load -= b.demand;
+    }
+
+    if(std::max(load, -a.demand) > instance.getCapacity(k) + epsilon) {
+        return false;
+    }
+
+    double tArrive = getEarliestStart(instance, u, k) + a.tVisit +
+        instance.getTravelTime(u, v, k);
+
+    if(b.role == VertexRole::REQUEST_SOURCE) {
+        tArrive = std::max(tArrive, instance.getTCreate(b.request));
+    }
+
+    return tArrive + getMinTail(instance, v, k) <= instance.getTStart(k) +
+        instance.getTLimit(k) - instance.getTVisit(instance.getTargetK(k)) + epsilon;
+}
+
+void ArcFilter::write(std::ostream & os) const {
+    ArcFilterHeader header = {this->numVertices, this->numVehicles, this->numWords,
+        this->numArcs};
+    std::size_t numRows = std::size_t(this->numVehicles) * this->numVertices;
+    std::size_t offset = 0;
+
+    // writes the specified bytes, starting at the next aligned offset
+    auto write = [&](const void * data, std::size_t size) {
+        static const char padding[ALIGNMENT] = {};
+
+        if(offset % ALIGNMENT != 0) {
+            os.write(padding, ALIGNMENT - offset % ALIGNMENT);
+            offset += ALIGNMENT - offset % ALIGNMENT;
+        }
+
+        os.write(static_cast<const char *>(data), size);
+        offset += size;
+    };
+
+    write(&header, sizeof(header));
+    write(this->bits.get(), numRows * this->numWords * sizeof(uint64_t));
+    write(this->starts.get(), (numRows + 1) * sizeof(std::size_t));
+    write(this->successors.get(), this->numArcs * sizeof(unsigned));
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Instance.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*********************************************************************************************
+ * The ArcFilter class represents, for each vehicle of an instance, the arcs that it may
+ * traverse in some feasible route, so that model builders and neighbourhoods can skip the
+ * others. An arc is discarded when it is a loop, leaves the target of the vehicle, enters
+ * its source, touches the depot of another vehicle or a request that the vehicle cannot
+ * serve, enters a target straight from the source of the vehicle, enters the target of
+ * the vehicle from a source, returns from a target to the source of its own request,
+ * carries more than the capacity of the vehicle, or cannot be traversed within the
+ * time-limit of the vehicle even on the most direct trip. The time bound assumes that the
+ * travelling times respect the triangular inequality, which Instance::isValid verifies.
+ *
+ * The arcs of each vehicle are stored both as a bitset, to answer single queries, and as
+ * adjacency lists, to enumerate the successors of a vertex. Copies share the same arrays,
+ * which can also be used in place from a mapped file written by write().
+ *********************************************************************************************/
+class ArcFilter {
+    private:
+        /***************************
+         * The number of vertices.
+         ***************************/
+        unsigned numVertices;
+
+        /***************************
+         * The number of vehicles.
+         ***************************/
+        unsigned numVehicles;
+
+        /********************************************************
+         * The number of words in the bitset of each vertex.
+         ********************************************************/
+        std::size_t numWords;
+
+        /***********************************
+         * The number of arcs kept.
+         ***********************************/
+        std::size_t numArcs;
+
+        /*************************************************************************
+         * The bitset of the successors of each vertex, for each vehicle.
+         *************************************************************************/
+        std::shared_ptr<const uint64_t> bits;
+
+        /***********************************************************************
+         * The position of the first successor of each vertex, for each
+         * vehicle, followed by the number of arcs.
+         ***********************************************************************/
+        std::shared_ptr<const std::size_t> starts;
+
+        /************************************************************************
+         * The successors of each vertex, for each vehicle, in increasing order.
+         ************************************************************************/
+        std::shared_ptr<const unsigned> successors;
+
+    public:
+        /*******************************************************
+         * Constructs the arc filter of the specified instance.
+         *
+         * @param instance the instance.
+         *******************************************************/
+        ArcFilter(const Instance & instance);
+
+        /*************************************************************************************
+         * Constructs an arc filter written by write() at the specified offset of a mapped
+         * file, such as a cache file. The arrays are used in place from the mapped file.
+         *
+         * Throws an exception if the file is too short for the arc filter.
+         *
+         * @param file   the mapped file.
+         * @param offset the offset of the arc filter in the file, a multiple of 64.
+         *************************************************************************************/
+        ArcFilter(const std::shared_ptr<MappedFile> & file, std::size_t offset);
+
+        /*********************************
+         * Constructs a new empty filter.
+         *********************************/
+        ArcFilter();
+
+        /***************************************************************************
+         * Verifies whether the specified vehicle may traverse the specified arc.
+         *
+         * @param u the tail of the arc.
+         * @param v the head of the arc.
+         * @param k the vehicle.
+         *
+         * @return true if the specified vehicle may traverse the specified arc;
+         *         false otherwise.
+         ***************************************************************************/
+        bool isFeasible(unsigned u, unsigned v, unsigned k) const;
+
+        /******************************************************************************
+         * Returns the vertices that the specified vehicle may visit right after the
+         * specified vertex.
+         *
+         * @param u the vertex whose successors are to be returned.
+         * @param k the vehicle.
+         *
+         * @return the vertices that the specified vehicle may visit right after the
+         *         specified vertex, in increasing order.
+         ******************************************************************************/
+        ArrayView<unsigned> getSuccessors(unsigned u, unsigned k) const;
+
+        /**********************************************************
+         * Returns the number of arcs kept, over every vehicle.
+         *
+         * @return the number of arcs kept, over every vehicle.
+         **********************************************************/
+        std::size_t getNumArcs() const;
+
+        /***************************************************************************
+         * Verifies whether the specified vehicle may traverse the specified arc of
+         * the specified instance, without building a filter.
+         *
+         * @param instance the instance.
+         * @param u        the tail of the arc.
+         * @param v        the head of the arc.
+         * @param k        the vehicle.
+         *
+         * @return true if the specified vehicle may traverse the specified arc;
+         *         false otherwise.
+         ***************************************************************************/
+        static bool isArcFeasible(const Instance & instance, unsigned u, unsigned v, unsigned k);
+
+        /***************************************************************************************
+         * Writes this filter into the specified output stream, as a header with the number
+         * of vertices, vehicles, words and arcs followed by the bitsets, the positions and the
+         * successors, each array starting on a 64-byte boundary.
+         *
+         * @param os the output stream to write into.
+         ***************************************************************************************/
+        void write(std::ostream & os) const;
+};
+
+inline bool ArcFilter::isFeasible(unsigned u, unsigned v, unsigned k) const {
+    std::size_t row = (std::size_t(k) * this->numVertices + u) * this->numWords;
+
+    return (this->bits.get()[row + v / 64] >> (v % 64)) & 1;
+}
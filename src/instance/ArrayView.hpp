@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**************************************************************************************
+ * The ArrayView class represents a read-only view over a contiguous array of values.
+ * It does not own the values, so it must not outlive the object that owns them.
+ **************************************************************************************/
+template <class T>
+class ArrayView {
+    private:
+        /***********************************
+         * The first value of the array.
+         ***********************************/
+        const T * first;
+
+        /*************************************
+         * The number of values in the array.
+         *************************************/
+        std::size_t length;
+
+    public:
+        /***************************************************
+         * Constructs a new view.
+         *
+         * @param first  the first value of the array.
+         * @param length the number of values in the array.
+         ***************************************************/
+        ArrayView(const T * first, std::size_t length) : first(first), length(length) {}
+
+        /*******************************************
+         * Constructs a new view.
+         *
+         * @param values the vector to be viewed.
+         *******************************************/
+        ArrayView(const std::vector<T> & values) : first(values.data()), length(values.size()) {}
+
+        /*******************************
+         * Constructs a new empty view.
+         *******************************/
+        ArrayView() : first(nullptr), length(0) {}
+
+        /******************************************
+         * Returns the number of values.
+         *
+         * @return the number of values.
+         ******************************************/
+        std::size_t size() const {
+            return this->length;
+        }
+
+        /*******************************************************
+         * Verifies whether this view is empty.
+         *
+         * @return true if this view is empty; false otherwise.
+         *******************************************************/
+        bool empty() const {
+            return this->length == 0;
+        }
+
+        /****************************************************
+         * Returns the first value of the array.
+         *
+         * @return the first value of the array.
+         ****************************************************/
+        const T * data() const {
+            return this->first;
+        }
+
+        /****************************************************
+         * Returns an iterator to the first value.
+         *
+         * @return an iterator to the first value.
+         ****************************************************/
+        const T * begin() const {
+            return this->first;
+        }
+
+        /****************************************************
+         * Returns an iterator past the last value.
+         *
+         * @return an iterator past the last value.
+         ****************************************************/
+        const T * end() const {
+            return this->first + this->length;
+        }
+
+        /****************************************************
+         * Returns the specified value.
+         *
+         * @param i the index of the value to be returned.
+         *
+         * @return the specified value.
+         ****************************************************/
+        const T & operator [] (std::size_t i) const {
+            return this->first[i];
+        }
+};
@@ -0,0 +1,47 @@
+#include "CandidateLists.hpp"
+
+CandidateLists::CandidateLists(const Instance & instance, unsigned numCandidates) :
+    numCandidates(numCandidates) {
+    SpatialIndex sourcesIndex(instance.getX(), instance.getY(), instance.getSourcesR());
+    SpatialIndex targetsIndex(instance.getX(), instance.getY(), instance.getTargetsR());
+    std::vector<unsigned> nearest;
+
+    // query one more vertex than needed in case the vertex itself is among the closest
+    auto append = [&](const SpatialIndex & index, unsigned v, std::vector<unsigned> & starts,
+            std::vector<unsigned> & candidates) {
+        index.getNearest(instance.getX(v), instance.getY(v), numCandidates + 1, nearest);
+
+        starts.push_back(candidates.size());
+
+        for(unsigned i = 0; i < nearest.size() &&
+                candidates.size() - starts.back() < numCandidates; i++) {
+            if(nearest[i] != v) {
+                candidates.push_back(nearest[i]);
+            }
+        }
+    };
+
+    for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+        append(sourcesIndex, v, this->sourceStarts, this->sources);
+        append(targetsIndex, v, this->targetStarts, this->targets);
+    }
+
+    this->sourceStarts.push_back(this->sources.size());
+    this->targetStarts.push_back(this->targets.size());
+}
+
+CandidateLists::CandidateLists() : numCandidates(0), sourceStarts(1, 0), targetStarts(1, 0) {}
+
+unsigned CandidateLists::getNumCandidates() const {
+    return this->numCandidates;
+}
+
+ArrayView<unsigned> CandidateLists::getSources(unsigned v) const {
+    return ArrayView<unsigned>(this->sources.data() + this->sourceStarts[v],
+            this->sourceStarts[v + 1] - this->sourceStarts[v]);
+}
+
+ArrayView<unsigned> CandidateLists::getTargets(unsigned v) const {
+    return ArrayView<unsigned>(this->targets.data() + this->targetStarts[v],
+            this->targetStarts[v + 1] - this->targetStarts[v]);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Instance.hpp"
+#include <vector>
+
+/*********************************************************************************************
+ * The CandidateLists class represents, for each vertex of an instance, the closest sources
+ * and the closest targets of requests, so that neighbourhoods and insertion heuristics can
+ * restrict themselves to the most promising edges. A vertex is never its own candidate.
+ *********************************************************************************************/
+class CandidateLists {
+    private:
+        /*************************************************
+         * The maximum number of candidates per vertex.
+         *************************************************/
+        unsigned numCandidates;
+
+        /************************************************************************
+         * The position of the first candidate source of each vertex, followed
+         * by the number of candidate sources.
+         ************************************************************************/
+        std::vector<unsigned> sourceStarts;
+
+        /*********************************************************************
+         * The candidate sources of each vertex, in non decreasing order of
+         * distance.
+         *********************************************************************/
+        std::vector<unsigned> sources;
+
+        /************************************************************************
+         * The position of the first candidate target of each vertex, followed
+         * by the number of candidate targets.
+         ************************************************************************/
+        std::vector<unsigned> targetStarts;
+
+        /*********************************************************************
+         * The candidate targets of each vertex, in non decreasing order of
+         * distance.
+         *********************************************************************/
+        std::vector<unsigned> targets;
+
+    public:
+        /*************************************************************************
+         * Constructs the candidate lists of the specified instance.
+         *
+         * @param instance      the instance.
+         * @param numCandidates the maximum number of candidates per vertex.
+         *************************************************************************/
+        CandidateLists(const Instance & instance, unsigned numCandidates);
+
+        /*********************************************
+         * Constructs new empty candidate lists.
+         *********************************************/
+        CandidateLists();
+
+        /********************************************************
+         * Returns the maximum number of candidates per vertex.
+         *
+         * @return the maximum number of candidates per vertex.
+         ********************************************************/
+        unsigned getNumCandidates() const;
+
+        /******************************************************************************
+         * Returns the request sources closest to the specified vertex.
+         *
+         * @param v the vertex whose closest request sources are to be returned.
+         *
+         * @return the request sources closest to the specified vertex.
+         ******************************************************************************/
+        ArrayView<unsigned> getSources(unsigned v) const;
+
+        /******************************************************************************
+         * Returns the request targets closest to the specified vertex.
+         *
+         * @param v the vertex whose closest request targets are to be returned.
+         *
+         * @return the request targets closest to the specified vertex.
+         ******************************************************************************/
+        ArrayView<unsigned> getTargets(unsigned v) const;
+};
@@ -0,0 +1,590 @@
+#include "CompressedStream.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+#include <vector>
+#include <zlib.h>
+
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+/*****************************************************
+ * The size of the blocks read and written at once.
+ *****************************************************/
+static const std::size_t BLOCK_SIZE = 1 << 16;
+
+/********************************************************
+ * The compression level of the gzip files, the fastest.
+ ********************************************************/
+static const char * GZIP_MODE = "wb1";
+
+/*****************************************************
+ * The compression level of the Zstandard files.
+ *****************************************************/
+static const int ZSTD_LEVEL = 3;
+
+/**********************************************************************************
+ * The largest ratio between the sizes of the data and of its gzip stream, beyond
+ * which the size found at the end of a gzip file cannot be right.
+ **********************************************************************************/
+static const std::size_t GZIP_MAX_RATIO = 1032;
+
+/***************************************************************************
+ * Returns the size of the specified open file.
+ *
+ * @param file the file.
+ *
+ * @return the size of the specified file, in bytes, or 0 if it is unknown.
+ ***************************************************************************/
+static std::size_t getFileSize(FILE * file) {
+    struct stat status;
+
+    return fstat(fileno(file), &status) == 0 ? status.st_size : 0;
+}
+
+/**************************************************************************************
+ * The CompressedInputBuffer class represents a stream buffer that holds the last
+ * block of decompressed data read from a file.
+ **************************************************************************************/
+class CompressedInputBuffer : public std::streambuf {
+    private:
+        /***************************************
+         * The last block of decompressed data.
+         ***************************************/
+        std::vector<char> block;
+
+    protected:
+        /*************************************************************
+         * The size of the decompressed data, or 0 if it is unknown.
+         *************************************************************/
+        std::size_t size;
+
+        /*******************************************************************************
+         * Reads and decompresses the next block of data.
+         *
+         * Throws an exception if the file is corrupted or truncated.
+         *
+         * @param data the block to fill.
+         * @param size the maximum number of bytes of the block.
+         *
+         * @return the number of bytes of the block, which is 0 at the end of the file.
+         *******************************************************************************/
+        virtual std::size_t readBlock(char * data, std::size_t size) = 0;
+
+        int_type underflow() override {
+            std::size_t size = this->readBlock(this->block.data(), this->block.size());
+
+            if(size == 0) {
+                return traits_type::eof();
+            }
+
+            this->setg(this->block.data(), this->block.data(), this->block.data() + size);
+
+            return traits_type::to_int_type(this->block[0]);
+        }
+
+    public:
+        CompressedInputBuffer() : block(BLOCK_SIZE), size(0) {}
+
+        virtual ~CompressedInputBuffer() {}
+
+        /*****************************************************************
+         * Returns the size of the decompressed data.
+         *
+         * @return the size of the decompressed data, or 0 if it is not
+         *         known before reading it.
+         *****************************************************************/
+        std::size_t getSize() const {
+            return this->size;
+        }
+};
+
+/**************************************************************************************
+ * The CompressedOutputBuffer class represents a stream buffer that gathers the data
+ * written into a file into blocks, which are compressed and written when full or
+ * flushed.
+ **************************************************************************************/
+class CompressedOutputBuffer : public std::streambuf {
+    private:
+        /*************************************
+         * The block of data being gathered.
+         *************************************/
+        std::vector<char> block;
+
+        /**********************************************************
+         * Compresses and writes the gathered block.
+         *
+         * @return true if the block was written; false otherwise.
+         **********************************************************/
+        bool flushBlock() {
+            std::size_t size = this->pptr() - this->pbase();
+            bool isWritten = size == 0 || this->writeBlock(this->pbase(), size);
+
+            this->setp(this->block.data(), this->block.data() + this->block.size());
+
+            return isWritten;
+        }
+
+    protected:
+        /*****************************************************************************
+         * Compresses and writes the specified block of data.
+         *
+         * @param data the block.
+         * @param size the number of bytes of the block.
+         *
+         * @return true if the block was written; false otherwise.
+         *****************************************************************************/
+        virtual bool writeBlock(const char * data, std::size_t size) = 0;
+
+        /*****************************************************************************
+         * Writes the end of the compressed data and closes the file, unless it is
+         * already closed.
+         *
+         * @return true if the file was written and closed; false otherwise.
+         *****************************************************************************/
+        virtual bool finish() = 0;
+
+        int_type overflow(int_type c) override {
+            if(!this->flushBlock()) {
+                return traits_type::eof();
+            }
+
+            if(!traits_type::eq_int_type(c, traits_type::eof())) {
+                * this->pptr() = traits_type::to_char_type(c);
+                this->pbump(1);
+            }
+
+            return traits_type::not_eof(c);
+        }
+
+        int sync() override {
+            return this->flushBlock() ? 0 : -1;
+        }
+
+    public:
+        CompressedOutputBuffer() : block(BLOCK_SIZE) {
+            this->setp(this->block.data(), this->block.data() + this->block.size());
+        }
+
+        virtual ~CompressedOutputBuffer() {}
+
+        /*****************************************************************************
+         * Writes the gathered block and the end of the compressed data, and closes
+         * the file.
+         *
+         * @return true if the file was written and closed; false otherwise.
+         *****************************************************************************/
+        bool close() {
+            bool isWritten = this->flushBlock();
+
+            return this->finish() && isWritten;
+        }
+};
+
+/**************************************************
+ * Reads a file that is not compressed.
+ **************************************************/
+class PlainInputBuffer : public CompressedInputBuffer {
+    private:
+        FILE * file;
+
+    protected:
+        std::size_t readBlock(char * data, std::size_t size) override {
+            std::size_t numRead = fread(data, 1, size, this->file);
+
+            if(numRead == 0 && ferror(this->file)) {
+                throw "File not read.";
+            }
+
+            return numRead;
+        }
+
+    public:
+        PlainInputBuffer(const char * filename) : file(fopen(filename, "rb")) {
+            if(this->file == nullptr) {
+                throw "File not found.";
+            }
+
+            this->size = getFileSize(this->file);
+        }
+
+        ~PlainInputBuffer() {
+            fclose(this->file);
+        }
+};
+
+/**************************************************
+ * Writes a file that is not compressed.
+ **************************************************/
+class PlainOutputBuffer : public CompressedOutputBuffer {
+    private:
+        FILE * file;
+
+    protected:
+        bool writeBlock(const char * data, std::size_t size) override {
+            return fwrite(data, 1, size, this->file) == size;
+        }
+
+        bool finish() override {
+            bool isClosed = this->file == nullptr || fclose(this->file) == 0;
+
+            this->file = nullptr;
+
+            return isClosed;
+        }
+
+    public:
+        PlainOutputBuffer(const char * filename) : file(fopen(filename, "wb")) {
+            if(this->file == nullptr) {
+                throw "File not created.";
+            }
+        }
+
+        ~PlainOutputBuffer() {
+            this->close();
+        }
+};
+
+/**************************************************
+ * Reads a file compressed with gzip.
+ **************************************************/
+class GzipInputBuffer : public CompressedInputBuffer {
+    private:
+        gzFile file;
+
+    protected:
+        std::size_t readBlock(char * data, std::size_t size) override {
+            int numRead = gzread(this->file, data, size);
+            int error = Z_OK;
+
+            // a truncated file reads as a short one, with the error left in the file
+            if(numRead <= 0) {
+                gzerror(this->file, &error);
+            }
+
+            if(numRead < 0 || error != Z_OK) {
+                throw "Invalid compressed file.";
+            }
+
+            return numRead;
+        }
+
+    public:
+        GzipInputBuffer(const char * filename) : file(gzopen(filename, "rb")) {
+            if(this->file == nullptr) {
+                throw "File not found.";
+            }
+
+            gzbuffer(this->file, BLOCK_SIZE);
+
+            FILE * rawFile = fopen(filename, "rb");
+            unsigned char magic[2];
+            unsigned char trailer[4];
+
+            // a gzip file ends with the size of its data modulo 2^32, which is only
+            // trusted when the ratio to the size of the file is possible
+            if(rawFile != nullptr) {
+                std::size_t fileSize = getFileSize(rawFile);
+
+                if(fread(magic, 1, 2, rawFile) == 2 && magic[0] == 0x1f && magic[1] == 0x8b &&
+                        fseek(rawFile, -4, SEEK_END) == 0 && fread(trailer, 1, 4, rawFile) == 4) {
+                    std::size_t dataSize = trailer[0] | trailer[1] << 8 | trailer[2] << 16 |
+                        (uint32_t) trailer[3] << 24;
+
+                    this->size = dataSize <= fileSize * GZIP_MAX_RATIO ? dataSize : 0;
+                }
+
+                fclose(rawFile);
+            }
+        }
+
+        ~GzipInputBuffer() {
+            gzclose_r(this->file);
+        }
+};
+
+/**************************************************
+ * Writes a file compressed with gzip.
+ **************************************************/
+class GzipOutputBuffer : public CompressedOutputBuffer {
+    private:
+        gzFile file;
+
+    protected:
+        bool writeBlock(const char * data, std::size_t size) override {
+            return gzwrite(this->file, data, size) == (int) size;
+        }
+
+        bool finish() override {
+            bool isClosed = this->file == nullptr || gzclose_w(this->file) == Z_OK;
+
+            this->file = nullptr;
+
+            return isClosed;
+        }
+
+    public:
+        GzipOutputBuffer(const char * filename) : file(gzopen(filename, GZIP_MODE)) {
+            if(this->file == nullptr) {
+                throw "File not created.";
+            }
+
+            gzbuffer(this->file, BLOCK_SIZE);
+        }
+
+        ~GzipOutputBuffer() {
+            this->close();
+        }
+};
+
+#ifdef WITH_ZSTD
+/**************************************************
+ * Reads a file compressed with Zstandard.
+ **************************************************/
+class ZstdInputBuffer : public CompressedInputBuffer {
+    private:
+        FILE * file;
+
+        ZSTD_DStream * stream;
+
+        std::vector<char> input;
+
+        ZSTD_inBuffer inBuffer;
+
+        /***********************************************************************
+         * The result of the last call that made progress, which is 0 once the
+         * frames read so far are complete.
+         ***********************************************************************/
+        std::size_t hint;
+
+    protected:
+        std::size_t readBlock(char * data, std::size_t size) override {
+            ZSTD_outBuffer outBuffer = {data, size, 0};
+
+            while(true) {
+                bool isEnd = false;
+
+                if(this->inBuffer.pos == this->inBuffer.size) {
+                    this->inBuffer.size = fread(this->input.data(), 1, this->input.size(),
+                            this->file);
+                    this->inBuffer.pos = 0;
+                    isEnd = this->inBuffer.size == 0;
+                }
+
+                // the stream may still hold decompressed data once the file is read
+                std::size_t pos = this->inBuffer.pos;
+                std::size_t result = ZSTD_decompressStream(this->stream, &outBuffer,
+                        &this->inBuffer);
+
+                if(ZSTD_isError(result)) {
+                    throw "Invalid compressed file.";
+                }
+
+                if(outBuffer.pos > 0 || this->inBuffer.pos > pos) {
+                    this->hint = result;
+                }
+
+                if(outBuffer.pos > 0) {
+                    return outBuffer.pos;
+                }
+
+                if(isEnd) {
+                    if(this->hint != 0 || ferror(this->file)) {
+                        throw "Invalid compressed file.";
+                    }
+
+                    return 0;
+                }
+            }
+        }
+
+    public:
+        ZstdInputBuffer(const char * filename) :
+            file(fopen(filename, "rb")),
+            stream(nullptr),
+            input(ZSTD_DStreamInSize()),
+            inBuffer{input.data(), 0, 0},
+            hint(0) {
+            if(this->file == nullptr) {
+                throw "File not found.";
+            }
+
+            this->stream = ZSTD_createDStream();
+            ZSTD_initDStream(this->stream);
+
+            // the first input holds the header of the first frame, which may give its size
+            this->inBuffer.size = fread(this->input.data(), 1, this->input.size(), this->file);
+
+            unsigned long long contentSize = ZSTD_getFrameContentSize(this->input.data(),
+                    this->inBuffer.size);
+
+            if(contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR) {
+                this->size = contentSize;
+            }
+        }
+
+        ~ZstdInputBuffer() {
+            ZSTD_freeDStream(this->stream);
+            fclose(this->file);
+        }
+};
+
+/**************************************************
+ * Writes a file compressed with Zstandard.
+ **************************************************/
+class ZstdOutputBuffer : public CompressedOutputBuffer {
+    private:
+        FILE * file;
+
+        ZSTD_CStream * stream;
+
+        std::vector<char> output;
+
+        /*************************************************************************
+         * Compresses the specified data and writes what the stream outputs.
+         *
+         * @param data      the data.
+         * @param size      the number of bytes of the data.
+         * @param directive whether the data ends the compressed data.
+         *
+         * @return true if the data was written; false otherwise.
+         *************************************************************************/
+        bool compress(const char * data, std::size_t size, ZSTD_EndDirective directive) {
+            ZSTD_inBuffer inBuffer = {data, size, 0};
+            std::size_t remaining;
+
+            do {
+                ZSTD_outBuffer outBuffer = {this->output.data(), this->output.size(), 0};
+
+                remaining = ZSTD_compressStream2(this->stream, &outBuffer, &inBuffer,
+                        directive);
+
+                if(ZSTD_isError(remaining) ||
+                        fwrite(this->output.data(), 1, outBuffer.pos, this->file) !=
+                        outBuffer.pos) {
+                    return false;
+                }
+            } while(directive == ZSTD_e_end ? remaining != 0 : inBuffer.pos < inBuffer.size);
+
+            return true;
+        }
+
+    protected:
+        bool writeBlock(const char * data, std::size_t size) override {
+            return this->compress(data, size, ZSTD_e_continue);
+        }
+
+        bool finish() override {
+            if(this->file == nullptr) {
+                return true;
+            }
+
+            bool isWritten = this->compress(nullptr, 0, ZSTD_e_end);
+            bool isClosed = fclose(this->file) == 0;
+
+            this->file = nullptr;
+
+            return isWritten && isClosed;
+        }
+
+    public:
+        ZstdOutputBuffer(const char * filename) :
+            file(fopen(filename, "wb")),
+            stream(nullptr),
+            output(ZSTD_CStreamOutSize()) {
+            if(this->file == nullptr) {
+                throw "File not created.";
+            }
+
+            this->stream = ZSTD_createCStream();
+            ZSTD_initCStream(this->stream, ZSTD_LEVEL);
+        }
+
+        ~ZstdOutputBuffer() {
+            this->close();
+            ZSTD_freeCStream(this->stream);
+        }
+};
+#endif
+
+Compression getCompression(const char * filename) {
+    std::size_t length = strlen(filename);
+
+    // checks whether the name of the file ends with the specified extension
+    auto hasExtension = [&](const char * extension) {
+        std::size_t extensionLength = strlen(extension);
+
+        return length > extensionLength &&
+            strcmp(filename + length - extensionLength, extension) == 0;
+    };
+
+    if(hasExtension(".gz")) {
+        return Compression::GZIP;
+    }
+
+    if(hasExtension(".zst")) {
+        return Compression::ZSTD;
+    }
+
+    return Compression::NONE;
+}
+
+CompressedInputStream::CompressedInputStream(const char * filename) : std::istream(nullptr) {
+    switch(getCompression(filename)) {
+        case Compression::GZIP:
+            this->buffer.reset(new GzipInputBuffer(filename));
+            break;
+#ifdef WITH_ZSTD
+        case Compression::ZSTD:
+            this->buffer.reset(new ZstdInputBuffer(filename));
+            break;
+#else
+        case Compression::ZSTD:
+            throw "Zstandard compression not available.";
+#endif
+        default:
+            this->buffer.reset(new PlainInputBuffer(filename));
+    }
+
+    this->rdbuf(this->buffer.get());
+
+    // let the exceptions of the buffer reach the reader
+    this->exceptions(std::ios::badbit);
+}
+
+CompressedInputStream::~CompressedInputStream() {}
+
+std::size_t CompressedInputStream::getSize() const {
+    return this->buffer->getSize();
+}
+
+CompressedOutputStream::CompressedOutputStream(const char * filename) : std::ostream(nullptr) {
+    switch(getCompression(filename)) {
+        case Compression::GZIP:
+            this->buffer.reset(new GzipOutputBuffer(filename));
+            break;
+#ifdef WITH_ZSTD
+        case Compression::ZSTD:
+            this->buffer.reset(new ZstdOutputBuffer(filename));
+            break;
+#else
+        case Compression::ZSTD:
+            throw "Zstandard compression not available.";
+#endif
+        default:
+            this->buffer.reset(new PlainOutputBuffer(filename));
+    }
+
+    this->rdbuf(this->buffer.get());
+}
+
+CompressedOutputStream::~CompressedOutputStream() {}
+
+void CompressedOutputStream::close() {
+    if(!this->buffer->close()) {
+        throw "File not written.";
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+
+/********************************************************************************************
+ * The compressions of a file, chosen by the extension of its name.
+ ********************************************************************************************/
+enum class Compression {
+    /**************************************************************************
+     * The file is not compressed.
+     **************************************************************************/
+    NONE,
+
+    /**************************************************************************
+     * The file is compressed with gzip, and its name ends with ".gz".
+     **************************************************************************/
+    GZIP,
+
+    /**************************************************************************
+     * The file is compressed with Zstandard, and its name ends with ".zst".
+     * Only available when built with WITH_ZSTD.
+     **************************************************************************/
+    ZSTD
+};
+
+/**************************************************************************
+ * Returns the compression of the specified file, chosen by its extension.
+ *
+ * @param filename the name of the file.
+ *
+ * @return the compression of the specified file.
+ **************************************************************************/
+Compression getCompression(const char * filename);
+
+class CompressedInputBuffer;
+
+class CompressedOutputBuffer;
+
+/********************************************************************************************
+ * The CompressedInputStream class represents an input stream over a file, decompressed
+ * block by block as it is read according to the extension of its name, so that only a
+ * block of the compressed file is held in memory at once.
+ *
+ * A file that is corrupted or truncated throws an exception from the read that reaches it.
+ ********************************************************************************************/
+class CompressedInputStream : public std::istream {
+    private:
+        /***************************************************
+         * The buffer that reads and decompresses the file.
+         ***************************************************/
+        std::unique_ptr<CompressedInputBuffer> buffer;
+
+    public:
+        /*****************************************************************************
+         * Opens the specified file.
+         *
+         * Throws an exception if the file cannot be opened or if its compression is
+         * not available.
+         *
+         * @param filename the file to read from.
+         *****************************************************************************/
+        CompressedInputStream(const char * filename);
+
+        /******************************
+         * Closes the file.
+         ******************************/
+        ~CompressedInputStream();
+
+        /******************************************************************************
+         * Returns the size of the decompressed file, as found in the file before it
+         * is read: the size of a plain file, the size at the end of a gzip file, or
+         * the content size in the header of a Zstandard frame. The size of a gzip
+         * file of several members or of more than 4 GB is wrong.
+         *
+         * @return the size of the decompressed file, in bytes, or 0 if it is unknown.
+         ******************************************************************************/
+        std::size_t getSize() const;
+};
+
+/********************************************************************************************
+ * The CompressedOutputStream class represents an output stream into a file, compressed
+ * block by block as it is written according to the extension of its name.
+ ********************************************************************************************/
+class CompressedOutputStream : public std::ostream {
+    private:
+        /**************************************************
+         * The buffer that compresses and writes the file.
+         **************************************************/
+        std::unique_ptr<CompressedOutputBuffer> buffer;
+
+    public:
+        /*****************************************************************************
+         * Creates the specified file.
+         *
+         * Throws an exception if the file cannot be created or if its compression is
+         * not available.
+         *
+         * @param filename the file to write into.
+         *****************************************************************************/
+        CompressedOutputStream(const char * filename);
+
+        /*****************************************
+         * Closes the file if it is still open.
+         *****************************************/
+        ~CompressedOutputStream();
+
+        /*************************************************************************
+         * Writes the end of the compressed data and closes the file.
+         *
+         * Throws an exception if the file cannot be written.
+         *************************************************************************/
+        void close();
+};
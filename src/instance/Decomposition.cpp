@@ -0,0 +1,170 @@
+#include "Decomposition.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+/**************************************************************************************
+ * Splits the specified requests into the specified number of clusters of about the
+ * same size, bisecting their midpoints along the widest axis.
+ *
+ * @param begin       the first request.
+ * @param end         the request past the last one.
+ * @param numClusters the number of clusters.
+ * @param midX        the x coordinate of the midpoint of each request.
+ * @param midY        the y coordinate of the midpoint of each request.
+ * @param clusters    the clusters the new ones are appended to.
+ **************************************************************************************/
+static void bisect(std::vector<unsigned>::iterator begin, std::vector<unsigned>::iterator end,
+        unsigned numClusters, const std::vector<double> & midX, const std::vector<double> & midY,
+        std::vector<std::vector<unsigned>> & clusters) {
+    if(numClusters == 1) {
+        clusters.push_back(std::vector<unsigned>(begin, end));
+        return;
+    }
+
+    auto rangeX = std::minmax_element(begin, end, [&](unsigned a, unsigned b) {
+        return midX[a] < midX[b];
+    });
+    auto rangeY = std::minmax_element(begin, end, [&](unsigned a, unsigned b) {
+        return midY[a] < midY[b];
+    });
+    const std::vector<double> & mid = midX[* rangeX.second] - midX[* rangeX.first] >=
+        midY[* rangeY.second] - midY[* rangeY.first] ? midX : midY;
+    unsigned numLeft = numClusters / 2;
+    auto middle = begin + (end - begin) * numLeft / numClusters;
+
+    std::nth_element(begin, middle, end, [&](unsigned a, unsigned b) {
+        return std::tie(mid[a], a) < std::tie(mid[b], b);
+    });
+
+    bisect(begin, middle, numLeft, midX, midY, clusters);
+    bisect(middle, end, numClusters - numLeft, midX, midY, clusters);
+}
+
+Decomposition::Decomposition(const std::shared_ptr<const Instance> & instance,
+        unsigned numClusters) {
+    unsigned numRequests = instance->getNumRequests();
+    unsigned numVehicles = instance->getNumVehicles();
+    std::vector<std::vector<unsigned>> requestsC, vehiclesC;
+
+    numClusters = std::max(1u, std::min({numClusters, numVehicles, std::max(numRequests, 1u)}));
+
+    if(numVehicles == 0) {
+        return;
+    }
+
+    std::vector<double> midX(numRequests), midY(numRequests);
+    std::vector<unsigned> requests(numRequests);
+
+    for(unsigned r = 0; r < numRequests; r++) {
+        unsigned sourceR = instance->getSourceR(r);
+        unsigned targetR = instance->getTargetR(r);
+
+        midX[r] = (instance->getX(sourceR) + instance->getX(targetR)) / 2.0;
+        midY[r] = (instance->getY(sourceR) + instance->getY(targetR)) / 2.0;
+    }
+
+    std::iota(requests.begin(), requests.end(), 0);
+    bisect(requests.begin(), requests.end(), numClusters, midX, midY, requestsC);
+
+    // one vehicle per cluster, then each one to the cluster with the most requests per vehicle
+    std::vector<unsigned> quotas(numClusters, 1);
+    std::priority_queue<std::pair<double, unsigned>> loads;
+
+    for(unsigned c = 0; c < numClusters; c++) {
+        loads.push(std::make_pair(requestsC[c].size(), c));
+    }
+
+    for(unsigned k = numClusters; k < numVehicles; k++) {
+        unsigned c = loads.top().second;
+
+        loads.pop();
+        quotas[c]++;
+        loads.push(std::make_pair(double(requestsC[c].size()) / quotas[c], c));
+    }
+
+    // the vehicles go to the closest clusters with room left
+    std::vector<double> centroidX(numClusters, 0.0), centroidY(numClusters, 0.0);
+    std::vector<std::tuple<double, unsigned, unsigned>> distances;
+
+    for(unsigned c = 0; c < numClusters; c++) {
+        for(unsigned r : requestsC[c]) {
+            centroidX[c] += midX[r] / requestsC[c].size();
+            centroidY[c] += midY[r] / requestsC[c].size();
+        }
+
+        for(unsigned k = 0; k < numVehicles; k++) {
+            double dx = instance->getX(instance->getSourceK(k)) - centroidX[c];
+            double dy = instance->getY(instance->getSourceK(k)) - centroidY[c];
+
+            distances.push_back(std::make_tuple(dx * dx + dy * dy, k, c));
+        }
+    }
+
+    std::sort(distances.begin(), distances.end());
+
+    std::vector<bool> isAssigned(numVehicles, false);
+
+    vehiclesC = std::vector<std::vector<unsigned>>(numClusters);
+
+    for(const auto & distance : distances) {
+        unsigned k = std::get<1>(distance);
+        unsigned c = std::get<2>(distance);
+
+        if(!isAssigned[k] && vehiclesC[c].size() < quotas[c]) {
+            isAssigned[k] = true;
+            vehiclesC[c].push_back(k);
+        }
+    }
+
+    for(unsigned c = 0; c < numClusters; c++) {
+        std::sort(vehiclesC[c].begin(), vehiclesC[c].end());
+        std::sort(requestsC[c].begin(), requestsC[c].end());
+
+        this->subInstances.push_back(std::make_shared<const Instance>(instance, requestsC[c],
+                    vehiclesC[c]));
+    }
+}
+
+Decomposition::Decomposition(const Instance & instance, unsigned numClusters) :
+    Decomposition::Decomposition(std::make_shared<const Instance>(instance), numClusters) {}
+
+Decomposition::Decomposition() {}
+
+unsigned Decomposition::getNumClusters() const {
+    return this->subInstances.size();
+}
+
+const std::shared_ptr<const Instance> & Decomposition::getSubInstance(unsigned c) const {
+    return this->subInstances[c];
+}
+
+ArrayView<unsigned> Decomposition::getRequests(unsigned c) const {
+    return this->subInstances[c]->getParentsR();
+}
+
+ArrayView<unsigned> Decomposition::getVehicles(unsigned c) const {
+    return this->subInstances[c]->getParentsK();
+}
+
+ArrayView<unsigned> Decomposition::getVertices(unsigned c) const {
+    return this->subInstances[c]->getParentsV();
+}
+
+void Decomposition::toGlobal(unsigned c, const std::vector<std::vector<unsigned>> & localPaths,
+        std::vector<std::vector<unsigned>> & paths) const {
+    ArrayView<unsigned> vehicles = this->subInstances[c]->getParentsK();
+    ArrayView<unsigned> vertices = this->subInstances[c]->getParentsV();
+
+    for(unsigned k = 0; k < localPaths.size(); k++) {
+        std::vector<unsigned> & path = paths[vehicles[k]];
+
+        path.clear();
+
+        for(unsigned v : localPaths[k]) {
+            path.push_back(vertices[v]);
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Instance.hpp"
+#include <memory>
+#include <vector>
+
+/*********************************************************************************************
+ * The Decomposition class represents a partition of an instance into geographic clusters
+ * of requests, each served by its own vehicles. The requests are split by recursive
+ * bisection of the midpoints of their sources and targets along the widest axis, so the
+ * clusters hold about as many requests each. Every cluster gets at least one vehicle and
+ * the remaining vehicles are shared in proportion to the number of requests, each cluster
+ * taking the vehicles whose sources are closest to the centroid of its requests.
+ *
+ * Each cluster becomes a view of the instance, whose vertices are those of its vehicles
+ * followed by those of its requests, and which reads the lengths of the instance instead of
+ * computing its own.
+ *********************************************************************************************/
+class Decomposition {
+    private:
+        /***************************************
+         * The sub-instance of each cluster.
+         ***************************************/
+        std::vector<std::shared_ptr<const Instance>> subInstances;
+
+    public:
+        /*************************************************************************************
+         * Decomposes the specified instance. The number of clusters is reduced to the
+         * number of vehicles or requests when either is smaller.
+         *
+         * @param instance    the instance to be decomposed.
+         * @param numClusters the number of clusters.
+         *************************************************************************************/
+        Decomposition(const std::shared_ptr<const Instance> & instance, unsigned numClusters);
+
+        /*************************************************************************************
+         * Decomposes a copy of the specified instance. The number of clusters is reduced
+         * to the number of vehicles or requests when either is smaller.
+         *
+         * @param instance    the instance to be decomposed.
+         * @param numClusters the number of clusters.
+         *************************************************************************************/
+        Decomposition(const Instance & instance, unsigned numClusters);
+
+        /****************************************
+         * Constructs a new empty decomposition.
+         ****************************************/
+        Decomposition();
+
+        /**********************************
+         * Returns the number of clusters.
+         *
+         * @return the number of clusters.
+         **********************************/
+        unsigned getNumClusters() const;
+
+        /*******************************************************************
+         * Returns the sub-instance of the specified cluster, a view of the
+         * instance.
+         *
+         * @param c the cluster whose sub-instance is to be returned.
+         *
+         * @return the sub-instance of the specified cluster.
+         *******************************************************************/
+        const std::shared_ptr<const Instance> & getSubInstance(unsigned c) const;
+
+        /*************************************************************************
+         * Returns the requests of the specified cluster, indexed by their index
+         * in its sub-instance.
+         *
+         * @param c the cluster whose requests are to be returned.
+         *
+         * @return the requests of the specified cluster.
+         *************************************************************************/
+        ArrayView<unsigned> getRequests(unsigned c) const;
+
+        /*************************************************************************
+         * Returns the vehicles of the specified cluster, indexed by their index
+         * in its sub-instance.
+         *
+         * @param c the cluster whose vehicles are to be returned.
+         *
+         * @return the vehicles of the specified cluster.
+         *************************************************************************/
+        ArrayView<unsigned> getVehicles(unsigned c) const;
+
+        /*************************************************************************
+         * Returns the vertices of the specified cluster, indexed by their index
+         * in its sub-instance.
+         *
+         * @param c the cluster whose vertices are to be returned.
+         *
+         * @return the vertices of the specified cluster.
+         *************************************************************************/
+        ArrayView<unsigned> getVertices(unsigned c) const;
+
+        /**************************************************************************************
+         * Translates the paths of a solution of the specified cluster into the paths of its
+         * vehicles in the instance, leaving the paths of the other vehicles untouched.
+         *
+         * @param c          the cluster.
+         * @param localPaths the path of each vehicle of the sub-instance of the cluster.
+         * @param paths      the path of each vehicle of the instance.
+         **************************************************************************************/
+        void toGlobal(unsigned c, const std::vector<std::vector<unsigned>> & localPaths,
+                std::vector<std::vector<unsigned>> & paths) const;
+};
@@ -1,25 +1,106 @@
 #include "Instance.hpp"
+#include "CompressedStream.hpp"
+#include "InstanceReader.hpp"
+#include "LiLimReader.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cfloat>
 #include <climits>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <numeric>
+#include <thread>
+
+/*****************************************************************************
+ * The number of vertices in each block of the triangular inequality check.
+ *****************************************************************************/
+static const unsigned VALIDATION_BLOCK_SIZE = 64;
+
+/*****************************************************
+ * The number of bytes read at once from a stream.
+ *****************************************************/
+static const std::size_t READ_BLOCK_SIZE = 1 << 16;
+
+/*****************************************************
+ * The first bytes of a binary instance file.
+ *****************************************************/
+static const char BINARY_MAGIC[8] = {'M', 'V', 'R', 'P', 'P', 'D', 'B', '\0'};
+
+/*****************************************************
+ * The version of the binary instance format.
+ *****************************************************/
+static const uint32_t BINARY_VERSION = 2;
+
+/****************************************************************
+ * The alignment, in bytes, of each array in a binary instance.
+ ****************************************************************/
+static const std::size_t BINARY_ALIGNMENT = 64;
+
+/*****************************************************
+ * The header of a binary instance file.
+ *****************************************************/
+struct BinaryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numRequests;
+    uint32_t numVehicles;
+    uint32_t numVertices;
+    uint32_t numSpeedClasses;
+    uint32_t stride;
+    uint32_t flags;
+};
+
+/*****************************************************************
+ * The flag of a binary instance whose lengths are asymmetric.
+ *****************************************************************/
+static const uint32_t BINARY_ASYMMETRIC = 1;
+
+/*****************************************************
+ * The first bytes of a lengths file.
+ *****************************************************/
+static const char LENGTHS_MAGIC[8] = {'M', 'V', 'R', 'P', 'P', 'D', 'L', '\0'};
+
+/*****************************************************
+ * The version of the lengths file format.
+ *****************************************************/
+static const uint32_t LENGTHS_VERSION = 1;
+
+/*****************************************************
+ * The header of a lengths file.
+ *****************************************************/
+struct LengthsHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numVertices;
+    uint32_t numTravelTimes;
+    uint32_t stride;
+};
 
 void Instance::init() {
+    this->initVertices();
+    this->initLengths();
+    this->initEligibility();
+
+    this->spatialIndex = SpatialIndex(this->x, this->y);
+}
+
+void Instance::initVertices() {
     // compute the flags and demand of each vertex
     this->requestsV = std::vector<unsigned int>(this->numVertices, this->numRequests);
     this->vehiclesV = std::vector<unsigned int>(this->numVertices, this->numVehicles);
-    this->isSourceV = std::vector<bool>(this->numVertices, false);
-    this->isTargetV = std::vector<bool>(this->numVertices, false);
     this->demandsV = std::vector<double>(this->numVertices, 0.0);
+    std::vector<VertexRole> roles(this->numVertices, VertexRole::NONE);
 
     for(unsigned r = 0; r < this->numRequests; r++) {
         this->requestsV[this->sourcesR[r]] = r;
         this->requestsV[this->targetsR[r]] = r;
-        this->isSourceV[this->sourcesR[r]] = true;
-        this->isTargetV[this->targetsR[r]] = true;
+        roles[this->sourcesR[r]] = VertexRole::REQUEST_SOURCE;
+        roles[this->targetsR[r]] = VertexRole::REQUEST_TARGET;
         this->demandsV[this->sourcesR[r]] = this->demandsR[r];
         this->demandsV[this->targetsR[r]] = -this->demandsR[r];
     }
@@ -27,110 +108,382 @@ void Instance::init() {
     for(unsigned k = 0; k < this->numVehicles; k++) {
         this->vehiclesV[this->sourcesK[k]] = k;
         this->vehiclesV[this->targetsK[k]] = k;
-        this->isSourceV[this->sourcesK[k]] = true;
-        this->isTargetV[this->targetsK[k]] = true;
+        roles[this->sourcesK[k]] = VertexRole::VEHICLE_SOURCE;
+        roles[this->targetsK[k]] = VertexRole::VEHICLE_TARGET;
+    }
+
+    // pack the attributes read when evaluating a path into one record per vertex
+    this->recordsV.resize(this->numVertices);
+
+    for(unsigned v = 0; v < this->numVertices; v++) {
+        this->recordsV[v].demand = this->demandsV[v];
+        this->recordsV[v].tVisit = v < this->tVisits.size() ? this->tVisits[v] : 0.0;
+        this->recordsV[v].request = this->requestsV[v];
+        this->recordsV[v].vehicle = this->vehiclesV[v];
+        this->recordsV[v].role = roles[v];
+    }
+}
+
+void Instance::initLengths() {
+    // compute the speed class of each vehicle
+    this->speedClassesK = std::vector<unsigned>(this->numVehicles);
+    this->speedsC.clear();
+
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        unsigned c = std::find(this->speedsC.begin(), this->speedsC.end(), this->speeds[k]) -
+            this->speedsC.begin();
+
+        if(c == this->speedsC.size()) {
+            this->speedsC.push_back(this->speeds[k]);
+        }
+
+        this->speedClassesK[k] = c;
+    }
+
+    this->lengths = Matrix();
+    this->travelTimes.clear();
+
+    if(this->distanceMode != DistanceMode::MATRIX) {
+        return;
     }
 
     // compute the length of each edge
-    this->lengths = std::vector<std::vector<double>>(this->numVertices,
-            std::vector<double>(this->numVertices));
+    this->lengths = Matrix(this->numVertices, this->numVertices);
 
     for(unsigned u = 0; u < this->numVertices; u++) {
         for(unsigned int v = 0; v < this->numVertices; v++) {
-            this->lengths[u][v] = sqrt((this->x[u] - this->x[v])*(this->x[u]-this->x[v]) +
-                    (this->y[u] - this->y[v])*(this->y[u] - this->y[v]));
+            this->lengths.set(u, v, sqrt((this->x[u] - this->x[v])*(this->x[u]-this->x[v]) +
+                    (this->y[u] - this->y[v])*(this->y[u] - this->y[v])));
+        }
+    }
+
+    // compute the travelling time of each edge once for each speed class
+    for(unsigned c = 0; c < this->speedsC.size(); c++) {
+        this->travelTimes.push_back(Matrix(this->numVertices, this->numVertices));
+
+        for(unsigned u = 0; u < this->numVertices; u++) {
+            for(unsigned v = 0; v < this->numVertices; v++) {
+                this->travelTimes[c].set(u, v, this->lengths.get(u, v) / this->speedsC[c]);
+            }
         }
     }
 }
 
-void Instance::init(std::istream & is) {
-    this->numVehicles = this->numRequests = this->numVertices = 0;
+void Instance::init(std::istream & is, std::size_t size) {
+    this->read(is, size);
 
-    this->sumProfit = 0.0;
+    // the text is released before the rest of the instance is computed
+    this->init();
+}
 
-    char c;
+void Instance::read(std::istream & is, std::size_t size) {
+    std::string buffer(size, '\0');
+    std::size_t length = 0;
 
-    while(is >> c) {
-        if(c == 'k') {
-            this->tStarts.push_back(0.0);
-            this->tLimits.push_back(0.0);
-            this->speeds.push_back(1.0);
-            this->capacities.push_back(0.0);
-            this->sourcesK.push_back(UINT_MAX);
-            this->targetsK.push_back(UINT_MAX);
+    // read straight into the buffer, which only grows once the expected size is read and
+    // more text follows, so that a known size is allocated once and never copied
+    while(length < buffer.size() || is.peek() != std::char_traits<char>::eof()) {
+        if(length == buffer.size()) {
+            buffer.resize(length + READ_BLOCK_SIZE);
+        }
 
-            is >> this->tStarts[this->numVehicles]
-               >> this->tLimits[this->numVehicles]
-               >> this->speeds[this->numVehicles]
-               >> this->capacities[this->numVehicles];
+        is.read(&buffer[length], buffer.size() - length);
+        length += is.gcount();
 
-            this->sourcesK[this->numVehicles] = this->numVertices;
+        if(!is) {
+            break;
+        }
+    }
 
-            this->x.push_back(0.0);
-            this->y.push_back(0.0);
-            this->tVisits.push_back(0.0);
+    buffer.resize(length);
 
-            is >> this->x[this->numVertices]
-               >> this->y[this->numVertices]
-               >> this->tVisits[this->numVertices];
+    this->read(buffer.data(), buffer.data() + buffer.size());
+}
 
-            this->numVertices++;
+void Instance::read(const char * begin, const char * end) {
+    if(LiLimReader::isLiLim(begin, end)) {
+        LiLimReader(begin, end).read(this->profits, this->tCreates, this->demandsR,
+                this->sourcesR, this->targetsR, this->tStarts, this->tLimits, this->speeds,
+                this->capacities, this->sourcesK, this->targetsK, this->x, this->y,
+                this->tVisits);
+    } else {
+        InstanceReader(begin, end).read(this->profits, this->tCreates, this->demandsR,
+                this->sourcesR, this->targetsR, this->tStarts, this->tLimits, this->speeds,
+                this->capacities, this->sourcesK, this->targetsK, this->x, this->y,
+                this->tVisits);
+    }
 
-            this->targetsK[this->numVehicles] = this->numVertices;
+    this->numRequests = this->profits.size();
+    this->numVehicles = this->tStarts.size();
+    this->numVertices = this->x.size();
 
-            this->x.push_back(0.0);
-            this->y.push_back(0.0);
-            this->tVisits.push_back(0.0);
+    this->sumProfit = std::accumulate(this->profits.begin(), this->profits.end(), 0.0);
+}
 
-            is >> this->x[this->numVertices]
-               >> this->y[this->numVertices]
-               >> this->tVisits[this->numVertices];
+void Instance::init(const std::shared_ptr<MappedFile> & file, std::size_t start) {
+    BinaryHeader header;
+    std::size_t offset = start;
 
-            this->numVertices++;
-            this->numVehicles++;
-        } else if(c == 'r') {
-            this->profits.push_back(0.0);
-            this->tCreates.push_back(0.0);
-            this->demandsR.push_back(0.0);
-            this->sourcesR.push_back(UINT_MAX);
-            this->targetsR.push_back(UINT_MAX);
+    if(file->size() < start + sizeof(header)) {
+        throw "Invalid binary instance.";
+    }
 
-            is >> this->profits[this->numRequests]
-               >> this->tCreates[this->numRequests]
-               >> this->demandsR[this->numRequests];
+    memcpy(&header, file->getData() + start, sizeof(header));
+    offset += sizeof(header);
 
-            this->sumProfit += this->profits[this->numRequests];
+    if(memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 
+            || header.version < 1 || header.version > BINARY_VERSION ||
+            header.stride < header.numVertices) {
+        throw "Invalid binary instance.";
+    }
 
-            this->sourcesR[this->numRequests] = this->numVertices;
+    // the first version has no flags, but its header is followed by zero padding
+    if(header.version == 1) {
+        header.flags = 0;
+    }
 
-            this->x.push_back(0.0);
-            this->y.push_back(0.0);
-            this->tVisits.push_back(0.0);
+    this->numRequests = header.numRequests;
+    this->numVehicles = header.numVehicles;
+    this->numVertices = header.numVertices;
 
-            is >> this->x[this->numVertices]
-               >> this->y[this->numVertices]
-               >> this->tVisits[this->numVertices];
+    // returns the offset of the next array and skips it
+    auto next = [&](std::size_t size) {
+        std::size_t begin = ((offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT) *
+            BINARY_ALIGNMENT;
 
-            this->numVertices++;
+        offset = begin + size;
 
-            this->targetsR[this->numRequests] = this->numVertices;
+        if(offset > file->size()) {
+            throw "Invalid binary instance.";
+        }
 
-            this->x.push_back(0.0);
-            this->y.push_back(0.0);
-            this->tVisits.push_back(0.0);
+        return begin;
+    };
+
+    // copies the next array into the specified vector
+    auto read = [&](auto & values, std::size_t size) {
+        std::size_t begin = next(size * sizeof(values[0]));
+
+        values.resize(size);
+        memcpy(values.data(), file->getData() + begin, size * sizeof(values[0]));
+    };
+
+    read(this->profits, this->numRequests);
+    read(this->tCreates, this->numRequests);
+    read(this->demandsR, this->numRequests);
+    read(this->sourcesR, this->numRequests);
+    read(this->targetsR, this->numRequests);
+    read(this->tStarts, this->numVehicles);
+    read(this->tLimits, this->numVehicles);
+    read(this->speeds, this->numVehicles);
+    read(this->capacities, this->numVehicles);
+    read(this->sourcesK, this->numVehicles);
+    read(this->targetsK, this->numVehicles);
+    read(this->speedClassesK, this->numVehicles);
+    read(this->x, this->numVertices);
+    read(this->y, this->numVertices);
+    read(this->tVisits, this->numVertices);
+
+    // the vertices and speed classes index the other arrays, so they are checked first
+    for(unsigned r = 0; r < this->numRequests; r++) {
+        if(this->sourcesR[r] >= this->numVertices || this->targetsR[r] >= this->numVertices) {
+            throw "Invalid binary instance.";
+        }
+    }
 
-            is >> this->x[this->numVertices]
-               >> this->y[this->numVertices]
-               >> this->tVisits[this->numVertices];
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        if(this->sourcesK[k] >= this->numVertices || this->targetsK[k] >= this->numVertices ||
+                this->speedClassesK[k] >= header.numSpeedClasses) {
+            throw "Invalid binary instance.";
+        }
+    }
 
-            this->numVertices++;
-            this->numRequests++;
-        } else {
-            break;
+    this->sumProfit = std::accumulate(this->profits.begin(), this->profits.end(), 0.0);
+
+    this->initVertices();
+
+    this->spatialIndex = SpatialIndex(this->x, this->y);
+
+    this->speedsC = std::vector<double>(header.numSpeedClasses);
+
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        this->speedsC[this->speedClassesK[k]] = this->speeds[k];
+    }
+
+    this->lengths = Matrix();
+    this->travelTimes.clear();
+    this->symmetric = (header.flags & BINARY_ASYMMETRIC) == 0;
+
+    // asymmetric lengths cannot be derived from the coordinates, so they are always read
+    if(!this->symmetric) {
+        this->distanceMode = DistanceMode::MATRIX;
+    }
+
+    if(this->distanceMode == DistanceMode::MATRIX) {
+        // use the lengths and travelling times in place
+        std::size_t size = (std::size_t) this->numVertices * header.stride * sizeof(double);
+
+        this->lengths = Matrix(this->numVertices, this->numVertices, header.stride,
+                std::shared_ptr<double>(file, (double *) (file->getData() + next(size))));
+
+        for(unsigned c = 0; c < header.numSpeedClasses; c++) {
+            this->travelTimes.push_back(Matrix(this->numVertices, this->numVertices,
+                        header.stride, std::shared_ptr<double>(file,
+                            (double *) (file->getData() + next(size)))));
         }
     }
 
-    this->init();
+    this->initEligibility();
+}
+
+void Instance::initLengths(const std::shared_ptr<MappedFile> & file) {
+    LengthsHeader header;
+    std::size_t offset = sizeof(header);
+
+    if(file->size() < sizeof(header)) {
+        throw "Invalid lengths file.";
+    }
+
+    memcpy(&header, file->getData(), sizeof(header));
+
+    if(memcmp(header.magic, LENGTHS_MAGIC, sizeof(LENGTHS_MAGIC)) != 0 ||
+            header.version != LENGTHS_VERSION || header.numVertices != this->numVertices ||
+            header.stride < this->numVertices || (header.numTravelTimes != 0 &&
+                header.numTravelTimes != this->speedsC.size())) {
+        throw "Invalid lengths file.";
+    }
+
+    // returns a matrix over the next array of the file
+    auto next = [&]() {
+        std::size_t size = (std::size_t) this->numVertices * header.stride * sizeof(double);
+        std::size_t begin = ((offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT) *
+            BINARY_ALIGNMENT;
+
+        offset = begin + size;
+
+        if(offset > file->size()) {
+            throw "Invalid lengths file.";
+        }
+
+        return Matrix(this->numVertices, this->numVertices, header.stride,
+                std::shared_ptr<double>(file, (double *) (file->getData() + begin)));
+    };
+
+    this->distanceMode = DistanceMode::MATRIX;
+    this->symmetric = false;
+    this->lengths = next();
+    this->travelTimes.clear();
+
+    for(unsigned c = 0; c < header.numTravelTimes; c++) {
+        this->travelTimes.push_back(next());
+    }
+
+    // without travelling times in the file, they are computed from the lengths
+    for(unsigned c = header.numTravelTimes; c < this->speedsC.size(); c++) {
+        this->travelTimes.push_back(Matrix(this->numVertices, this->numVertices));
+
+        for(unsigned u = 0; u < this->numVertices; u++) {
+            ArrayView<double> lengthsU = this->lengths[u];
+
+            for(unsigned v = 0; v < this->numVertices; v++) {
+                this->travelTimes[c].set(u, v, lengthsU[v] / this->speedsC[c]);
+            }
+        }
+    }
+
+    this->initEligibility();
+}
+
+void Instance::initEligibility() {
+    this->numWordsK = (this->numVehicles + 63) / 64;
+    this->eligibleRK = std::vector<uint64_t>(this->numRequests * this->numWordsK, 0);
+    this->retiredR.resize(this->numRequests, false);
+
+    // no vehicle can serve the requests of a structurally invalid instance
+    if(!this->isValid(ValidationLevel::STRUCTURAL)) {
+        return;
+    }
+
+    for(unsigned r = 0; r < this->numRequests; r++) {
+        if(this->retiredR[r]) {
+            continue;
+        }
+
+        for(unsigned k = 0; k < this->numVehicles; k++) {
+            // a view keeps the eligibility of the parent, which is cheaper to read
+            bool isEligible = this->distanceMode == DistanceMode::VIEW ?
+                this->parent->isEligible(this->parentsR[r], this->parentsK[k]) :
+                this->canServe(r, k);
+
+            if(isEligible) {
+                this->eligibleRK[r * this->numWordsK + k / 64] |= uint64_t(1) << (k % 64);
+            }
+        }
+    }
+}
+
+bool Instance::canServe(unsigned r, unsigned k) const {
+    double epsilon = std::numeric_limits<float>::epsilon();
+    unsigned sourceR = this->sourcesR[r];
+    unsigned targetR = this->targetsR[r];
+    unsigned sourceK = this->sourcesK[k];
+    unsigned targetK = this->targetsK[k];
+
+    if(this->demandsR[r] > this->capacities[k] + epsilon) {
+        return false;
+    }
+
+    // the vehicle may have to wait at the source for the request to be created
+    double tArrive = std::max(this->tStarts[k] + this->tVisits[sourceK] +
+            this->getTravelTime(sourceK, sourceR, k), this->tCreates[r]);
+    double tFinish = tArrive + this->tVisits[sourceR] +
+        this->getTravelTime(sourceR, targetR, k) + this->tVisits[targetR] +
+        this->getTravelTime(targetR, targetK, k);
+
+    return tFinish <= this->tStarts[k] + this->tLimits[k] - this->tVisits[targetK] + epsilon;
+}
+
+void Instance::addVertex(double x, double y, double tVisit, unsigned request, double demand,
+        VertexRole role) {
+    unsigned v = this->numVertices++;
+
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->tVisits.push_back(tVisit);
+    this->requestsV.push_back(request);
+    this->vehiclesV.push_back(this->numVehicles);
+    this->demandsV.push_back(demand);
+    this->recordsV.push_back(VertexRecord{demand, tVisit, request, this->numVehicles, role});
+
+    // a column of every travelling time matrix would be rewritten for each vertex added, so
+    // they are dropped and the travelling times are then derived from the lengths
+    if(this->distanceMode == DistanceMode::MATRIX) {
+        this->lengths.resize(this->numVertices, this->numVertices);
+        this->travelTimes.clear();
+
+        this->updateLengths(v);
+    }
+
+    this->spatialIndex.insert(v, x, y);
+}
+
+void Instance::updateLengths(unsigned v) {
+    if(this->distanceMode != DistanceMode::MATRIX) {
+        return;
+    }
+
+    for(unsigned u = 0; u < this->numVertices; u++) {
+        double length = sqrt((this->x[u] - this->x[v])*(this->x[u] - this->x[v]) +
+                (this->y[u] - this->y[v])*(this->y[u] - this->y[v]));
+
+        this->lengths.set(u, v, length);
+        this->lengths.set(v, u, length);
+
+        for(unsigned c = 0; c < this->travelTimes.size(); c++) {
+            this->travelTimes[c].set(u, v, length / this->speedsC[c]);
+            this->travelTimes[c].set(v, u, length / this->speedsC[c]);
+        }
+    }
 }
 
 Instance::Instance(const std::vector<double> & profits, const std::vector<double> & tCreates, 
@@ -139,7 +492,17 @@ Instance::Instance(const std::vector<double> & profits, const std::vector<double
         const std::vector<double> & tLimits, const std::vector<double> & speeds,
         const std::vector<double> & capacities, const std::vector<unsigned> & sourcesK,
         const std::vector<unsigned> & targetsK, const std::vector<double> x,
-        const std::vector<double> y, const std::vector<double> tVisits) : 
+        const std::vector<double> y, const std::vector<double> tVisits) :
+    Instance::Instance(profits, tCreates, demandsR, sourcesR, targetsR, tStarts, tLimits, speeds,
+            capacities, sourcesK, targetsK, x, y, tVisits, DistanceMode::MATRIX) {}
+
+Instance::Instance(const std::vector<double> & profits, const std::vector<double> & tCreates, 
+        const std::vector<double> & demandsR, const std::vector<unsigned> & sourcesR,
+        const std::vector<unsigned> & targetsR, const std::vector<double> & tStarts,
+        const std::vector<double> & tLimits, const std::vector<double> & speeds,
+        const std::vector<double> & capacities, const std::vector<unsigned> & sourcesK,
+        const std::vector<unsigned> & targetsK, const std::vector<double> x,
+        const std::vector<double> y, const std::vector<double> tVisits, DistanceMode mode) : 
     profits(profits),
     tCreates(tCreates),
     demandsR(demandsR),
@@ -153,7 +516,9 @@ Instance::Instance(const std::vector<double> & profits, const std::vector<double
     targetsK(targetsK),
     x(x),
     y(y),
-    tVisits(tVisits) {
+    tVisits(tVisits),
+    distanceMode(mode),
+    symmetric(true) {
     this->numRequests = this->profits.size();
     this->numVehicles = this->tLimits.size();
     this->numVertices = this->x.size();
@@ -163,16 +528,49 @@ Instance::Instance(const std::vector<double> & profits, const std::vector<double
     this->init();
 }
 
-Instance::Instance(std::istream & is) {
-    this->init(is);
+Instance::Instance(std::istream & is) : Instance::Instance(is, DistanceMode::MATRIX) {}
+
+Instance::Instance(std::istream & is, DistanceMode mode) :
+    distanceMode(mode),
+    symmetric(true) {
+    this->init(is, 0);
 }
 
-Instance::Instance(const char * filename) {
+Instance::Instance(const char * filename) : Instance::Instance(filename, DistanceMode::MATRIX) {}
+
+Instance::Instance(const char * filename, DistanceMode mode) :
+    distanceMode(mode),
+    symmetric(true) {
     std::ifstream ifs;
-    ifs.open(filename);
+
+    // compressed files are decompressed block by block into the text buffer
+    if(getCompression(filename) != Compression::NONE) {
+        CompressedInputStream is(filename);
+
+        this->init(is, is.getSize());
+        return;
+    }
+
+    ifs.open(filename, std::ios::binary);
 
     if(ifs.is_open()) {
-        this->init(ifs);
+        char magic[sizeof(BINARY_MAGIC)];
+
+        ifs.read(magic, sizeof(magic));
+
+        if(ifs.gcount() == sizeof(magic) && memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0) {
+            ifs.close();
+            this->init(std::make_shared<MappedFile>(filename), 0);
+        } else {
+            // a file shorter than the magic number leaves the stream failed
+            ifs.clear();
+            ifs.seekg(0, std::ios::end);
+
+            std::size_t size = ifs.tellg();
+
+            ifs.seekg(0);
+            this->init(ifs, size);
+        }
     } else {
         throw "File not found.";
     }
@@ -180,7 +578,82 @@ Instance::Instance(const char * filename) {
 
 Instance::Instance(const std::string & filename) : Instance::Instance(filename.c_str()) {}
 
-Instance::Instance() {}
+Instance::Instance(const std::string & filename, DistanceMode mode) :
+    Instance::Instance(filename.c_str(), mode) {}
+
+Instance::Instance(const char * filename, const char * lengthsFilename) :
+    Instance::Instance(filename, DistanceMode::ON_THE_FLY) {
+    this->initLengths(std::make_shared<MappedFile>(lengthsFilename));
+}
+
+Instance::Instance(const std::string & filename, const std::string & lengthsFilename) :
+    Instance::Instance(filename.c_str(), lengthsFilename.c_str()) {}
+
+Instance::Instance(const std::shared_ptr<MappedFile> & file, std::size_t offset,
+        DistanceMode mode) :
+    distanceMode(mode),
+    symmetric(true) {
+    this->init(file, offset);
+}
+
+Instance::Instance(const std::shared_ptr<const Instance> & parent,
+        const std::vector<unsigned> & requests, const std::vector<unsigned> & vehicles) :
+    numRequests(requests.size()),
+    numVehicles(vehicles.size()),
+    numVertices(2 * (requests.size() + vehicles.size())),
+    sumProfit(0.0),
+    distanceMode(DistanceMode::VIEW),
+    symmetric(parent->isSymmetric()),
+    parent(parent),
+    parentsR(requests),
+    parentsK(vehicles) {
+    // appends the specified vertex of the parent to the view
+    auto addVertex = [&](unsigned v) {
+        this->parentsV.push_back(v);
+        this->x.push_back(parent->getX(v));
+        this->y.push_back(parent->getY(v));
+        this->tVisits.push_back(parent->getTVisit(v));
+    };
+
+    this->parentsV.reserve(this->numVertices);
+
+    for(unsigned k : vehicles) {
+        this->tStarts.push_back(parent->getTStart(k));
+        this->tLimits.push_back(parent->getTLimit(k));
+        this->speeds.push_back(parent->getSpeed(k));
+        this->capacities.push_back(parent->getCapacity(k));
+        this->sourcesK.push_back(this->parentsV.size());
+        addVertex(parent->getSourceK(k));
+        this->targetsK.push_back(this->parentsV.size());
+        addVertex(parent->getTargetK(k));
+    }
+
+    for(unsigned r : requests) {
+        this->profits.push_back(parent->getProfit(r));
+        this->tCreates.push_back(parent->getTCreate(r));
+        this->demandsR.push_back(parent->getDemandR(r));
+        this->sourcesR.push_back(this->parentsV.size());
+        addVertex(parent->getSourceR(r));
+        this->targetsR.push_back(this->parentsV.size());
+        addVertex(parent->getTargetR(r));
+        this->retiredR.push_back(parent->isRetired(r));
+
+        if(!parent->isRetired(r)) {
+            this->sumProfit += parent->getProfit(r);
+        }
+    }
+
+    this->init();
+}
+
+Instance::Instance() :
+    numRequests(0),
+    numVehicles(0),
+    numVertices(0),
+    sumProfit(0.0),
+    distanceMode(DistanceMode::MATRIX),
+    symmetric(true),
+    numWordsK(0) {}
 
 unsigned Instance::getNumRequests() const {
     return this->numRequests;
@@ -198,7 +671,7 @@ unsigned Instance::getSumProfit() const {
     return this->sumProfit;
 }
 
-std::vector<double> Instance::getProfits() const {
+ArrayView<double> Instance::getProfits() const {
     return this->profits;
 }
 
@@ -206,7 +679,7 @@ double Instance::getProfit(unsigned r) const {
     return this->profits[r];
 }
 
-std::vector<double> Instance::getTCreates() const {
+ArrayView<double> Instance::getTCreates() const {
     return this->tCreates;
 }
 
@@ -214,7 +687,7 @@ double Instance::getTCreate(unsigned r) const {
     return this->tCreates[r];
 }
 
-std::vector<double> Instance::getDemandsR() const {
+ArrayView<double> Instance::getDemandsR() const {
     return this->demandsR;
 }
 
@@ -222,7 +695,7 @@ double Instance::getDemandR(unsigned r) const {
     return this->demandsR[r];
 }
 
-std::vector<unsigned> Instance::getSourcesR() const {
+ArrayView<unsigned> Instance::getSourcesR() const {
     return this->sourcesR;
 }
 
@@ -230,7 +703,7 @@ unsigned Instance::getSourceR(unsigned r) const {
     return this->sourcesR[r];
 }
 
-std::vector<unsigned> Instance::getTargetsR() const {
+ArrayView<unsigned> Instance::getTargetsR() const {
     return this->targetsR;
 }
 
@@ -238,7 +711,7 @@ unsigned Instance::getTargetR(unsigned r) const {
     return this->targetsR[r];
 }
 
-std::vector<double> Instance::getTStarts() const {
+ArrayView<double> Instance::getTStarts() const {
     return this->tStarts;
 }
 
@@ -246,7 +719,7 @@ double Instance::getTStart(unsigned k) const {
     return this->tStarts[k];
 }
 
-std::vector<double> Instance::getTLimits() const {
+ArrayView<double> Instance::getTLimits() const {
     return this->tLimits;
 }
 
@@ -254,7 +727,7 @@ double Instance::getTLimit(unsigned k) const {
     return this->tLimits[k];
 }
 
-std::vector<double> Instance::getSpeeds() const {
+ArrayView<double> Instance::getSpeeds() const {
     return this->speeds;
 }
 
@@ -262,7 +735,7 @@ double Instance::getSpeed(unsigned k) const {
     return this->speeds[k];
 }
 
-std::vector<double> Instance::getCapacities() const {
+ArrayView<double> Instance::getCapacities() const {
     return this->capacities;
 }
 
@@ -270,7 +743,7 @@ double Instance::getCapacity(unsigned k) const {
     return this->capacities[k];
 }
 
-std::vector<unsigned> Instance::getSourcesK() const {
+ArrayView<unsigned> Instance::getSourcesK() const {
     return this->sourcesK;
 }
 
@@ -278,7 +751,7 @@ unsigned Instance::getSourceK(unsigned k) const {
     return this->sourcesK[k];
 }
 
-std::vector<unsigned> Instance::getTargetsK() const {
+ArrayView<unsigned> Instance::getTargetsK() const {
     return this->targetsK;
 }
 
@@ -286,7 +759,7 @@ unsigned Instance::getTargetK(unsigned k) const {
     return this->targetsK[k];
 }
 
-std::vector<double> Instance::getX() const {
+ArrayView<double> Instance::getX() const {
     return this->x;
 }
 
@@ -294,7 +767,7 @@ double Instance::getX(unsigned v) const {
     return this->x[v];
 }
 
-std::vector<double> Instance::getY() const {
+ArrayView<double> Instance::getY() const {
     return this->y;
 }
 
@@ -302,55 +775,295 @@ double Instance::getY(unsigned v) const {
     return this->y[v];
 }
 
-std::vector<double> Instance::getTVisits() const {
+ArrayView<double> Instance::getTVisits() const {
     return this->tVisits;
 }
 
-double Instance::getTVisit(unsigned v) const {
-    return this->tVisits[v];
+ArrayView<unsigned> Instance::getRequestsV() const {
+    return this->requestsV;
 }
 
-std::vector<unsigned> Instance::getRequestsV() const {
-    return this->requestsV;
+ArrayView<unsigned> Instance::getVehiclesV() const {
+    return this->vehiclesV;
 }
 
-unsigned Instance::getRequestV(unsigned v) const {
-    return this->requestsV[v];
+ArrayView<double> Instance::getDemandsV() const {
+    return this->demandsV;
 }
 
-std::vector<unsigned> Instance::getVehiclesV() const {
-    return this->vehiclesV;
+DistanceMode Instance::getDistanceMode() const {
+    return this->distanceMode;
 }
 
-unsigned Instance::getVehicleV(unsigned v) const {
-    return this->vehiclesV[v];
+bool Instance::isSymmetric() const {
+    return this->symmetric;
 }
 
-bool Instance::isASource(unsigned v) const {
-    return this->isSourceV[v];
+uint64_t Instance::getFingerprint() const {
+    // 64-bit FNV-1a over whole words
+    uint64_t fingerprint = 14695981039346656037ULL;
+
+    auto hash = [&](uint64_t word) {
+        fingerprint = (fingerprint ^ word) * 1099511628211ULL;
+    };
+
+    // hashes the size and then the bytes of the specified vector, padded to whole words
+    auto hashVector = [&](const auto & values) {
+        std::size_t size = values.size() * sizeof(values[0]);
+        const char * data = reinterpret_cast<const char *>(values.data());
+
+        hash(size);
+
+        for(std::size_t i = 0; i < size; i += sizeof(uint64_t)) {
+            uint64_t word = 0;
+
+            memcpy(&word, data + i, std::min(sizeof(uint64_t), size - i));
+            hash(word);
+        }
+    };
+
+    hashVector(this->profits);
+    hashVector(this->tCreates);
+    hashVector(this->demandsR);
+    hashVector(this->sourcesR);
+    hashVector(this->targetsR);
+    hashVector(this->tStarts);
+    hashVector(this->tLimits);
+    hashVector(this->speeds);
+    hashVector(this->capacities);
+    hashVector(this->sourcesK);
+    hashVector(this->targetsK);
+    hashVector(this->x);
+    hashVector(this->y);
+    hashVector(this->tVisits);
+    hashVector(std::vector<uint8_t>(this->retiredR.begin(), this->retiredR.end()));
+
+    if(!this->symmetric) {
+        std::vector<double> lengthsU(this->numVertices);
+
+        for(unsigned u = 0; u < this->numVertices; u++) {
+            for(unsigned v = 0; v < this->numVertices; v++) {
+                lengthsU[v] = this->getLength(u, v);
+            }
+
+            hashVector(lengthsU);
+        }
+    }
+
+    return fingerprint;
 }
 
-bool Instance::isATarget(unsigned v) const {
-    return this->isTargetV[v];
+const std::shared_ptr<const Instance> & Instance::getParent() const {
+    return this->parent;
 }
 
-std::vector<double> Instance::getDemandsV() const {
-    return this->demandsV;
+ArrayView<unsigned> Instance::getParentsR() const {
+    return this->parentsR;
+}
+
+ArrayView<unsigned> Instance::getParentsK() const {
+    return this->parentsK;
+}
+
+ArrayView<unsigned> Instance::getParentsV() const {
+    return this->parentsV;
 }
 
-double Instance::getDemandV(unsigned v) const {
-    return this->demandsV[v];
+const SpatialIndex & Instance::getSpatialIndex() const {
+    return this->spatialIndex;
 }
 
-std::vector<std::vector<double>> Instance::getLengths() const {
+const Matrix & Instance::getLengths() const {
     return this->lengths;
 }
 
-double Instance::getLength(unsigned u, unsigned v) const {
-    return this->lengths[u][v];
+ArrayView<double> Instance::getLengths(unsigned u) const {
+    return this->lengths[u];
 }
 
-bool Instance::isValid(unsigned & error) const {
+void Instance::getLengths(unsigned u, ArrayView<unsigned> vertices, double * lengths) const {
+    if(this->distanceMode == DistanceMode::MATRIX) {
+        ArrayView<double> lengthsU = this->lengths[u];
+
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            lengths[i] = lengthsU[vertices[i]];
+        }
+    } else if(this->distanceMode == DistanceMode::VIEW) {
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            lengths[i] = this->getLength(u, vertices[i]);
+        }
+    } else {
+        const double * x = this->x.data();
+        const double * y = this->y.data();
+        const double xU = x[u];
+        const double yU = y[u];
+
+        // gather the squared lengths first so that the square roots are computed in packs
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            double dx = xU - x[vertices[i]];
+            double dy = yU - y[vertices[i]];
+
+            lengths[i] = dx*dx + dy*dy;
+        }
+
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            lengths[i] = sqrt(lengths[i]);
+        }
+    }
+}
+
+unsigned Instance::getNumSpeedClasses() const {
+    return this->speedsC.size();
+}
+
+unsigned Instance::getSpeedClass(unsigned k) const {
+    return this->speedClassesK[k];
+}
+
+const Matrix & Instance::getTravelTimes(unsigned k) const {
+    // only the MATRIX mode stores the travelling times, until requests are added
+    if(this->distanceMode != DistanceMode::MATRIX ||
+            this->speedClassesK[k] >= this->travelTimes.size()) {
+        static const Matrix empty;
+
+        return empty;
+    }
+
+    return this->travelTimes[this->speedClassesK[k]];
+}
+
+double Instance::getMinTFulfill(unsigned r, unsigned k) const {
+    unsigned sourceK = this->sourcesK[k];
+    unsigned sourceR = this->sourcesR[r];
+    unsigned targetR = this->targetsR[r];
+
+    return this->tStarts[k] + this->tVisits[sourceK] + this->getTravelTime(sourceK, sourceR, k) +
+        this->tVisits[sourceR] + this->getTravelTime(sourceR, targetR, k) +
+        this->tVisits[targetR] - this->tCreates[r];
+}
+
+void Instance::getTravelTimes(unsigned u, ArrayView<unsigned> vertices, unsigned k,
+        double * travelTimes) const {
+    if(this->distanceMode == DistanceMode::MATRIX &&
+            this->speedClassesK[k] < this->travelTimes.size()) {
+        ArrayView<double> travelTimesU = this->travelTimes[this->speedClassesK[k]][u];
+
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            travelTimes[i] = travelTimesU[vertices[i]];
+        }
+    } else if(this->distanceMode == DistanceMode::VIEW) {
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            travelTimes[i] = this->getTravelTime(u, vertices[i], k);
+        }
+    } else {
+        const double speed = this->speeds[k];
+
+        this->getLengths(u, vertices, travelTimes);
+
+        for(std::size_t i = 0; i < vertices.size(); i++) {
+            travelTimes[i] /= speed;
+        }
+    }
+}
+
+unsigned Instance::addRequest(double profit, double tCreate, double demand, double xSource,
+        double ySource, double tVisitSource, double xTarget, double yTarget,
+        double tVisitTarget) {
+    if(!this->symmetric) {
+        throw "Instances with a lengths file cannot be modified.";
+    }
+
+    if(this->parent) {
+        throw "Views cannot be modified.";
+    }
+
+    unsigned r = this->numRequests++;
+
+    // the vertices of the vehicles refer to |R| as the absence of a request
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        for(unsigned v : {this->sourcesK[k], this->targetsK[k]}) {
+            this->requestsV[v] = this->numRequests;
+            this->recordsV[v].request = this->numRequests;
+        }
+    }
+
+    this->profits.push_back(profit);
+    this->tCreates.push_back(tCreate);
+    this->demandsR.push_back(demand);
+    this->sourcesR.push_back(this->numVertices);
+    this->targetsR.push_back(this->numVertices + 1);
+    this->retiredR.push_back(false);
+    this->sumProfit += profit;
+
+    this->addVertex(xSource, ySource, tVisitSource, r, demand, VertexRole::REQUEST_SOURCE);
+    this->addVertex(xTarget, yTarget, tVisitTarget, r, -demand, VertexRole::REQUEST_TARGET);
+
+    this->eligibleRK.resize(this->numRequests * this->numWordsK, 0);
+
+    for(unsigned k = 0; k < this->numVehicles; k++) {
+        if(this->canServe(r, k)) {
+            this->eligibleRK[r * this->numWordsK + k / 64] |= uint64_t(1) << (k % 64);
+        }
+    }
+
+    return r;
+}
+
+void Instance::removeRequest(unsigned r) {
+    if(r >= this->numRequests || this->retiredR[r]) {
+        throw "Invalid request.";
+    }
+
+    if(this->parent) {
+        throw "Views cannot be modified.";
+    }
+
+    this->retiredR[r] = true;
+    this->sumProfit -= this->profits[r];
+
+    std::fill(this->eligibleRK.begin() + r * this->numWordsK,
+            this->eligibleRK.begin() + (r + 1) * this->numWordsK, 0);
+}
+
+void Instance::updateVehicle(unsigned k, double x, double y, double tStart, double tLimit,
+        double capacity) {
+    if(k >= this->numVehicles) {
+        throw "Invalid vehicle.";
+    }
+
+    if(!this->symmetric) {
+        throw "Instances with a lengths file cannot be modified.";
+    }
+
+    if(this->parent) {
+        throw "Views cannot be modified.";
+    }
+
+    unsigned sourceK = this->sourcesK[k];
+    uint64_t bit = uint64_t(1) << (k % 64);
+
+    this->x[sourceK] = x;
+    this->y[sourceK] = y;
+    this->tStarts[k] = tStart;
+    this->tLimits[k] = tLimit;
+    this->capacities[k] = capacity;
+
+    this->updateLengths(sourceK);
+
+    for(unsigned r = 0; r < this->numRequests; r++) {
+        uint64_t & word = this->eligibleRK[r * this->numWordsK + k / 64];
+
+        word = !this->retiredR[r] && this->canServe(r, k) ? word | bit : word & ~bit;
+    }
+
+    this->spatialIndex = SpatialIndex(this->x, this->y);
+}
+
+bool Instance::isRetired(unsigned r) const {
+    return this->retiredR[r];
+}
+
+bool Instance::isValid(unsigned & error, ValidationLevel level) const {
     error = 0;
 
     // check if there is 2 vertices for each request and each vehicle
@@ -432,13 +1145,13 @@ bool Instance::isValid(unsigned & error) const {
     }
 
     // check if there is a length value for each pair of vertices
-    if(this->lengths.size() != this->numVertices) {
-        error = 14;
-        return false;
-    }
+    if(this->distanceMode == DistanceMode::MATRIX) {
+        if(this->lengths.getNumRows() != this->numVertices) {
+            error = 14;
+            return false;
+        }
 
-    for(unsigned i = 0; i < this->numVertices; i++) {
-        if(this->lengths[i].size() != this->numVertices) {
+        if(this->lengths.getNumCols() != this->numVertices) {
             error = 15;
             return false;
         }
@@ -586,41 +1299,141 @@ bool Instance::isValid(unsigned & error) const {
         }
     }
 
+    if(level == ValidationLevel::STRUCTURAL) {
+        return true;
+    }
+
+    // euclidean lengths computed on the fly are non negative, symmetric and metric
+    if(this->distanceMode == DistanceMode::ON_THE_FLY) {
+        return true;
+    }
+
+    // a view checks the lengths between its own vertices, gathered from its parent, so that
+    // its cost only depends on the size of the view
+    Matrix viewLengths;
+
+    if(this->distanceMode == DistanceMode::VIEW) {
+        viewLengths = Matrix(this->numVertices, this->numVertices);
+
+        for(unsigned u = 0; u < this->numVertices; u++) {
+            for(unsigned v = 0; v < this->numVertices; v++) {
+                viewLengths.set(u, v, this->getLength(u, v));
+            }
+        }
+    }
+
+    const Matrix & lengths = this->distanceMode == DistanceMode::VIEW ? viewLengths :
+        this->lengths;
+
     // check if all length values are non negative
     for(unsigned u = 0; u < this->numVertices; u++) {
+        ArrayView<double> lengthsU = lengths[u];
+
         for(unsigned v = 0; v < this->numVertices; v++) {
-            if(this->lengths[u][v] < 0) {
+            if(lengthsU[v] < 0) {
                 error = 33;
                 return false;
             }
         }
     }
 
-    // check if the lengths are symmetric
-    for(unsigned u = 0; u < this->numVertices; u++) {
+    // check if the lengths are symmetric, noting whether they are the euclidean ones
+    bool euclidean = this->symmetric;
+
+    for(unsigned u = 0; u < this->numVertices && this->symmetric; u++) {
+        ArrayView<double> lengthsU = lengths[u];
+
         for(unsigned v = 0; v < this->numVertices; v++) {
-            if(fabs(this->lengths[u][v] - this->lengths[v][u]) >
+            if(fabs(lengthsU[v] - lengths.get(v, u)) >
                     std::numeric_limits<float>::epsilon()) {
                 error = 34;
                 return false;
             }
+
+            euclidean = euclidean && lengthsU[v] == sqrt((this->x[u] - this->x[v])*
+                    (this->x[u] - this->x[v]) + (this->y[u] - this->y[v])*(this->y[u] - this->y[v]));
         }
     }
 
+    if(level == ValidationLevel::METRIC || euclidean) {
+        return true;
+    }
+
     // check if the lengths respect the triangular inequality
-    for(unsigned u = 0; u < this->numVertices; u++) {
-        for(unsigned v = 0; v < this->numVertices; v++) {
-            for(unsigned w = 0; w < this->numVertices; w++) {
-                if(this->lengths[u][w] > this->lengths[u][v] + this->lengths[v][w] +
-                        std::numeric_limits<float>::epsilon()) {
-                    error = 35;
-                    return false;
+    if(!this->respectsTriangularInequality(lengths)) {
+        error = 35;
+        return false;
+    }
+
+    return true;
+}
+
+bool Instance::respectsTriangularInequality(const Matrix & lengths) const {
+    const unsigned numBlocks = (this->numVertices + VALIDATION_BLOCK_SIZE - 1) /
+        VALIDATION_BLOCK_SIZE;
+    const double epsilon = std::numeric_limits<float>::epsilon();
+    std::atomic<unsigned> nextBlock(0);
+    std::atomic<bool> violated(false);
+
+    // each thread checks the triples whose first vertex lies in the next unchecked block
+    auto check = [&]() {
+        for(unsigned ub = nextBlock++; ub < numBlocks && !violated; ub = nextBlock++) {
+            unsigned uEnd = std::min((ub + 1) * VALIDATION_BLOCK_SIZE, this->numVertices);
+
+            for(unsigned vb = 0; vb < numBlocks && !violated; vb++) {
+                unsigned vEnd = std::min((vb + 1) * VALIDATION_BLOCK_SIZE, this->numVertices);
+
+                for(unsigned wb = 0; wb < numBlocks; wb++) {
+                    unsigned wBegin = wb * VALIDATION_BLOCK_SIZE;
+                    unsigned wEnd = std::min(wBegin + VALIDATION_BLOCK_SIZE, this->numVertices);
+                    bool blockViolated = false;
+
+                    for(unsigned u = ub * VALIDATION_BLOCK_SIZE; u < uEnd; u++) {
+                        const double * lengthsU = lengths[u].data();
+
+                        for(unsigned v = vb * VALIDATION_BLOCK_SIZE; v < vEnd; v++) {
+                            const double * lengthsV = lengths[v].data();
+                            const double lengthUV = lengthsU[v];
+
+                            for(unsigned w = wBegin; w < wEnd; w++) {
+                                blockViolated |= lengthsU[w] > lengthUV + lengthsV[w] + epsilon;
+                            }
+                        }
+                    }
+
+                    if(blockViolated) {
+                        violated = true;
+                        return;
+                    }
                 }
             }
         }
+    };
+
+    unsigned numThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), numBlocks);
+    std::vector<std::thread> threads;
+
+    for(unsigned t = 1; t < numThreads; t++) {
+        threads.push_back(std::thread(check));
     }
 
-    return true;
+    check();
+
+    for(auto & thread : threads) {
+        thread.join();
+    }
+
+    return !violated;
+}
+
+bool Instance::isValid(unsigned & error) const {
+    return this->isValid(error, ValidationLevel::FULL);
+}
+
+bool Instance::isValid(ValidationLevel level) const {
+    unsigned error;
+
+    return this->isValid(error, level);
 }
 
 bool Instance::isValid() const {
@@ -661,18 +1474,171 @@ void Instance::write(std::ostream & os) const {
 }
 
 void Instance::write(const char * filename) const {
+    CompressedOutputStream os(filename);
+
+    this->write(os);
+    os.close();
+}
+
+void Instance::write() const {
+    this->write(std::cout);
+}
+
+/*******************************************************************************************
+ * Writes the specified matrix divided by the specified divisor, starting at the next
+ * aligned offset, with rows of the specified stride, which may differ from the stride of
+ * the matrix.
+ *
+ * @param os      the stream to write into.
+ * @param offset  the number of bytes already written, which is updated.
+ * @param matrix  the matrix to be written.
+ * @param stride  the distance, in doubles, between consecutive rows in the stream.
+ * @param divisor the value each entry is divided by.
+ *******************************************************************************************/
+static void writeMatrix(std::ostream & os, std::size_t & offset, const Matrix & matrix,
+        unsigned stride, double divisor) {
+    static const char padding[BINARY_ALIGNMENT] = {};
+    std::vector<double> row(stride, 0.0);
+
+    if(offset % BINARY_ALIGNMENT != 0) {
+        os.write(padding, BINARY_ALIGNMENT - offset % BINARY_ALIGNMENT);
+        offset += BINARY_ALIGNMENT - offset % BINARY_ALIGNMENT;
+    }
+
+    for(unsigned u = 0; u < matrix.size(); u++) {
+        ArrayView<double> matrixU = matrix[u];
+
+        for(unsigned v = 0; v < matrixU.size(); v++) {
+            row[v] = matrixU[v] / divisor;
+        }
+
+        os.write(reinterpret_cast<const char *>(row.data()), stride * sizeof(double));
+        offset += stride * sizeof(double);
+    }
+}
+
+void Instance::writeBinary(std::ostream & os) const {
+    BinaryHeader header;
+    std::size_t offset = 0;
+
+    if(this->distanceMode != DistanceMode::MATRIX) {
+        throw "Lengths not stored.";
+    }
+
+    memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.numRequests = this->numRequests;
+    header.numVehicles = this->numVehicles;
+    header.numVertices = this->numVertices;
+    header.numSpeedClasses = this->speedsC.size();
+    header.stride = this->lengths.getStride();
+    header.flags = this->symmetric ? 0 : BINARY_ASYMMETRIC;
+
+    // writes the specified bytes, starting at the next aligned offset
+    auto write = [&](const void * data, std::size_t size) {
+        static const char padding[BINARY_ALIGNMENT] = {};
+
+        if(offset % BINARY_ALIGNMENT != 0) {
+            os.write(padding, BINARY_ALIGNMENT - offset % BINARY_ALIGNMENT);
+            offset += BINARY_ALIGNMENT - offset % BINARY_ALIGNMENT;
+        }
+
+        os.write(static_cast<const char *>(data), size);
+        offset += size;
+    };
+
+    // writes the specified vector
+    auto writeVector = [&](const auto & values) {
+        write(values.data(), values.size() * sizeof(values[0]));
+    };
+
+    write(&header, sizeof(header));
+    writeVector(this->profits);
+    writeVector(this->tCreates);
+    writeVector(this->demandsR);
+    writeVector(this->sourcesR);
+    writeVector(this->targetsR);
+    writeVector(this->tStarts);
+    writeVector(this->tLimits);
+    writeVector(this->speeds);
+    writeVector(this->capacities);
+    writeVector(this->sourcesK);
+    writeVector(this->targetsK);
+    writeVector(this->speedClassesK);
+    writeVector(this->x);
+    writeVector(this->y);
+    writeVector(this->tVisits);
+
+    // the travelling times computed from a lengths file may have another stride
+    writeMatrix(os, offset, this->lengths, header.stride, 1.0);
+
+    // the speed classes without stored travelling times are written as the loader expects
+    for(unsigned c = 0; c < this->speedsC.size(); c++) {
+        if(c < this->travelTimes.size()) {
+            writeMatrix(os, offset, this->travelTimes[c], header.stride, 1.0);
+        } else {
+            writeMatrix(os, offset, this->lengths, header.stride, this->speedsC[c]);
+        }
+    }
+}
+
+void Instance::writeLengths(std::ostream & os) const {
+    LengthsHeader header;
+    std::size_t offset = 0;
+
+    if(this->distanceMode != DistanceMode::MATRIX) {
+        throw "Lengths not stored.";
+    }
+
+    memcpy(header.magic, LENGTHS_MAGIC, sizeof(LENGTHS_MAGIC));
+    header.version = LENGTHS_VERSION;
+    header.numVertices = this->numVertices;
+    header.numTravelTimes = this->travelTimes.size();
+    header.stride = this->lengths.getStride();
+
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    offset += sizeof(header);
+
+    // the travelling times computed from a lengths file may have another stride
+    writeMatrix(os, offset, this->lengths, header.stride, 1.0);
+
+    for(const auto & travelTimes : this->travelTimes) {
+        writeMatrix(os, offset, travelTimes, header.stride, 1.0);
+    }
+}
+
+void Instance::writeLengths(const char * filename) const {
     std::ofstream ofs;
-    ofs.open(filename);
+
+    // a failed call must not truncate an existing file
+    if(this->distanceMode != DistanceMode::MATRIX) {
+        throw "Lengths not stored.";
+    }
+
+    ofs.open(filename, std::ios::binary);
 
     if(ofs.is_open()) {
-        this->write(ofs);
+        this->writeLengths(ofs);
         ofs.close();
     } else {
         throw "File not created.";
     }
 }
 
-void Instance::write() const {
-    this->write(std::cout);
-}
+void Instance::writeBinary(const char * filename) const {
+    std::ofstream ofs;
+
+    // a failed call must not truncate an existing file
+    if(this->distanceMode != DistanceMode::MATRIX) {
+        throw "Lengths not stored.";
+    }
 
+    ofs.open(filename, std::ios::binary);
+
+    if(ofs.is_open()) {
+        this->writeBinary(ofs);
+        ofs.close();
+    } else {
+        throw "File not created.";
+    }
+}
@@ -1,11 +1,139 @@
 #pragma once
 
+#include "AlignedAllocator.hpp"
+#include "MappedFile.hpp"
+#include "Matrix.hpp"
+#include "SpatialIndex.hpp"
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <vector>
 
-/***************************************************
+/********************************************************************************************
+ * The levels of validation of an instance, each one including the checks of the previous.
+ ********************************************************************************************/
+enum class ValidationLevel {
+    /**************************************************************************
+     * Checks the sizes, indices and signs of the attributes, in O(|V|) time.
+     **************************************************************************/
+    STRUCTURAL,
+
+    /**************************************************************************
+     * Also checks that the lengths are non negative and, unless they come
+     * from a lengths file, symmetric, in O(|V|^2) time.
+     **************************************************************************/
+    METRIC,
+
+    /**************************************************************************
+     * Also checks that the lengths respect the triangular inequality, in
+     * O(|V|^3) time unless they are the euclidean lengths of the vertices.
+     **************************************************************************/
+    FULL
+};
+
+/********************************************************************************************
+ * The ways the lengths and travelling times of the edges of an instance can be obtained.
+ ********************************************************************************************/
+enum class DistanceMode {
+    /**************************************************************************
+     * The lengths and travelling times are stored in O(|V|^2) matrices.
+     **************************************************************************/
+    MATRIX,
+
+    /**************************************************************************
+     * The lengths and travelling times are computed from the coordinates of
+     * the vertices whenever they are needed, using O(|V|) memory.
+     **************************************************************************/
+    ON_THE_FLY,
+
+    /**************************************************************************
+     * The lengths and travelling times are those of the parent instance of a
+     * view, read through the parent of each vertex and vehicle.
+     **************************************************************************/
+    VIEW
+};
+
+/********************************************************************************************
+ * The roles a vertex can play.
+ ********************************************************************************************/
+enum class VertexRole : uint8_t {
+    /**************************************************************************
+     * The vertex is neither the source nor the target of anything, which only
+     * happens in invalid instances.
+     **************************************************************************/
+    NONE,
+
+    /**************************************************************************
+     * The vertex is the source of a request.
+     **************************************************************************/
+    REQUEST_SOURCE,
+
+    /**************************************************************************
+     * The vertex is the target of a request.
+     **************************************************************************/
+    REQUEST_TARGET,
+
+    /**************************************************************************
+     * The vertex is the source of a vehicle.
+     **************************************************************************/
+    VEHICLE_SOURCE,
+
+    /**************************************************************************
+     * The vertex is the target of a vehicle.
+     **************************************************************************/
+    VEHICLE_TARGET
+};
+
+/********************************************************************************************
+ * The attributes of a vertex needed to evaluate a path, packed into 32 bytes so that the
+ * record of a vertex never straddles two cache lines.
+ ********************************************************************************************/
+struct VertexRecord {
+    /*****************************
+     * The demand of the vertex.
+     *****************************/
+    double demand;
+
+    /**************************************************
+     * The amount of time needed to visit the vertex.
+     **************************************************/
+    double tVisit;
+
+    /*********************************************************************
+     * The request associated with the vertex, or |R| if there is none.
+     *********************************************************************/
+    unsigned request;
+
+    /*********************************************************************
+     * The vehicle associated with the vertex, or |K| if there is none.
+     *********************************************************************/
+    unsigned vehicle;
+
+    /*****************************
+     * The role of the vertex.
+     *****************************/
+    VertexRole role;
+};
+
+static_assert(sizeof(VertexRecord) == 32, "A vertex record must fill half a cache line.");
+
+/********************************************************************************************
  * The Instance class represents a MVRPPD instance.
- ***************************************************/
+ *
+ * An instance can also be a view of a parent instance restricted to some of its requests
+ * and vehicles, as needed by decompositions and other sub-problems. A view copies the
+ * attributes of its requests, vehicles and vertices, numbered as in a new instance, but
+ * reads the lengths and travelling times of the parent, so that it is built in time linear
+ * in the number of its requests and vehicles, plus the copy of their eligibility, whatever
+ * the distance mode of the parent. A view must not outlive the changes of its parent.
+ *
+ * An instance can absorb new requests while it is being dispatched. The vertices of a new
+ * request are appended after the existing ones, so the indices of the vertices, requests
+ * and vehicles never change, and a request is retired rather than erased. Any view of the
+ * arrays of an instance, and any structure derived from it, such as a solution or an arc
+ * filter, must be rebuilt after the instance changes.
+ ********************************************************************************************/
 class Instance {
     private:
         /**************************
@@ -108,37 +236,201 @@ class Instance {
          *******************************************/
         std::vector<unsigned> vehiclesV;
 
-        /***************************************************************************************
-         * Array of flags indicating whether each vertex is the source of a request or vehicle.
-         ***************************************************************************************/
-        std::vector<bool> isSourceV;
-
-        /***************************************************************************************
-         * Array of flags indicating whether each vertex is the target of a request or vehicle.
-         ***************************************************************************************/
-        std::vector<bool> isTargetV;
-
         /*****************************
          * The demand of each vertex.
          *****************************/
         std::vector<double> demandsV;
 
+        /****************************************************************************
+         * The record of each vertex, holding the attributes above that are read
+         * together when evaluating a path.
+         ****************************************************************************/
+        std::vector<VertexRecord, AlignedAllocator<VertexRecord>> recordsV;
+
+        /*************************************************************
+         * The way the lengths and travelling times are obtained.
+         *************************************************************/
+        DistanceMode distanceMode;
+
         /****************************************
          * The length of each edge.
          ****************************************/
-        std::vector<std::vector<double>> lengths;
+        Matrix lengths;
+
+        /*****************************************************
+         * Flag indicating whether the lengths are symmetric.
+         *****************************************************/
+        bool symmetric;
+
+        /********************************************************
+         * The speed class of each vehicle.
+         ********************************************************/
+        std::vector<unsigned> speedClassesK;
+
+        /**********************************
+         * The speed of each speed class.
+         **********************************/
+        std::vector<double> speedsC;
+
+        /******************************************************************************
+         * The travelling time of each edge for each speed class, or none once
+         * requests have been added, when they are derived from the lengths instead.
+         ******************************************************************************/
+        std::vector<Matrix> travelTimes;
+
+        /****************************************************
+         * The index over the coordinates of the vertices.
+         ****************************************************/
+        SpatialIndex spatialIndex;
+
+        /**********************************************************************
+         * The number of words in the eligibility bitset of each request.
+         **********************************************************************/
+        std::size_t numWordsK;
+
+        /**********************************************************************
+         * The bitset of the vehicles that can serve each request.
+         **********************************************************************/
+        std::vector<uint64_t> eligibleRK;
+
+        /********************************************************
+         * Flag indicating whether each request was retired.
+         ********************************************************/
+        std::vector<bool> retiredR;
+
+        /*************************************************************
+         * The parent instance of a view, or null for an instance.
+         *************************************************************/
+        std::shared_ptr<const Instance> parent;
+
+        /*************************************************
+         * The request of the parent of each request.
+         *************************************************/
+        std::vector<unsigned> parentsR;
+
+        /*************************************************
+         * The vehicle of the parent of each vehicle.
+         *************************************************/
+        std::vector<unsigned> parentsK;
+
+        /*************************************************
+         * The vertex of the parent of each vertex.
+         *************************************************/
+        std::vector<unsigned> parentsV;
 
         /************************************
          * Initializes a new instance.
          ************************************/
         void init();
 
-        /*******************************************
+        /********************************************************
+         * Computes the roles, demand and record of each vertex.
+         ********************************************************/
+        void initVertices();
+
+        /*********************************************************************
+         * Computes the speed classes and, in the MATRIX mode, the length and
+         * travelling times of each edge.
+         *********************************************************************/
+        void initLengths();
+
+        /*********************************************************************
+         * Computes the vehicles that can serve each request, which needs the
+         * travelling times.
+         *********************************************************************/
+        void initEligibility();
+
+        /*************************************************************************
+         * Verifies whether the specified vehicle can serve the specified
+         * request, regardless of whether the request was retired.
+         *
+         * @param r the request.
+         * @param k the vehicle.
+         *
+         * @return true if the specified vehicle can serve the specified request;
+         *         false otherwise.
+         *************************************************************************/
+        bool canServe(unsigned r, unsigned k) const;
+
+        /****************************************************************************
+         * Appends a vertex, growing the lengths and travelling times in the MATRIX
+         * mode by one row and one column.
+         *
+         * @param x       the x coordinate of the vertex.
+         * @param y       the y coordinate of the vertex.
+         * @param tVisit  the amount of time needed to visit the vertex.
+         * @param request the request associated with the vertex.
+         * @param demand  the demand of the vertex.
+         * @param role    the role of the vertex.
+         ****************************************************************************/
+        void addVertex(double x, double y, double tVisit, unsigned request, double demand,
+                VertexRole role);
+
+        /****************************************************************************
+         * Recomputes, in the MATRIX mode, the lengths and travelling times of the
+         * edges entering and leaving the specified vertex.
+         *
+         * @param v the vertex whose edges are to be recomputed.
+         ****************************************************************************/
+        void updateLengths(unsigned v);
+
+        /**************************************************************************
          * Initializes a new instance.
          *
-         * @param is the input stream to read from.
-         *******************************************/
-        void init(std::istream & is);
+         * @param is   the input stream to read from.
+         * @param size the expected size of the text, which the buffer holding it
+         *             is allocated with, or 0 if it is unknown.
+         **************************************************************************/
+        void init(std::istream & is, std::size_t size);
+
+        /**************************************************************************
+         * Reads the requests, vehicles and vertices of a new instance from an
+         * input stream, without computing the rest of the instance.
+         *
+         * @param is   the input stream to read from.
+         * @param size the expected size of the text, which the buffer holding it
+         *             is allocated with, or 0 if it is unknown.
+         **************************************************************************/
+        void read(std::istream & is, std::size_t size);
+
+        /*********************************************************
+         * Reads the requests, vehicles and vertices of a new
+         * instance from a text buffer, either in the text format
+         * or in the Li & Lim format, without computing the rest
+         * of the instance.
+         *
+         * @param begin the first character of the buffer.
+         * @param end   the character past the end of the buffer.
+         *********************************************************/
+        void read(const char * begin, const char * end);
+
+        /********************************************************************************
+         * Initializes a new instance from a binary instance file. The lengths and
+         * travelling times are used in place from the mapped file.
+         *
+         * @param file  the mapped binary instance file.
+         * @param start the offset of the binary instance in the file, a multiple of 64.
+         ********************************************************************************/
+        void init(const std::shared_ptr<MappedFile> & file, std::size_t start);
+
+        /*************************************************************************************
+         * Switches to the MATRIX mode with the asymmetric lengths and, if present, the
+         * travelling times of a lengths file, which are used in place from the mapped file.
+         *
+         * @param file the mapped lengths file.
+         *************************************************************************************/
+        void initLengths(const std::shared_ptr<MappedFile> & file);
+
+        /**************************************************************************************
+         * Verifies whether the specified lengths respect the triangular inequality. The
+         * triples of vertices are checked in cache-sized blocks, distributed among the
+         * hardware threads.
+         *
+         * @param lengths the lengths between the vertices of this instance.
+         *
+         * @return true if the lengths respect the triangular inequality; false otherwise.
+         **************************************************************************************/
+        bool respectsTriangularInequality(const Matrix & lengths) const;
 
     public:
         /***************************************************************************************
@@ -166,6 +458,33 @@ class Instance {
                 const std::vector<unsigned> & targetsK, const std::vector<double> x,
                 const std::vector<double> y, const std::vector<double> tVisits);
 
+        /***************************************************************************************
+         * Constructs a new instance.
+         *
+         * @param profits    the profit of each request.
+         * @param tCreates   the creation time of each request.
+         * @param demandsR   the demand of each request.
+         * @param sourcesR   the source vertex of each request.
+         * @param targetsR   the destination vertex of each request.
+         * @param tStarts    the starting time of operation of each vehicle.
+         * @param tLimits    the maximum time-limit of operation of each vehicle.
+         * @param speeds     the speed of each vehicle.
+         * @param capacities the capacity of each vehicle.
+         * @param sourcesK   the source vertex of each vehicle.
+         * @param targetsK   the destination vertex of each vehicle.
+         * @param G          the complete graph.
+         * @param tVisits    the amount of time needed to visit each vertex.
+         * @param mode       the way the lengths and travelling times are obtained.
+         ***************************************************************************************/
+        Instance(const std::vector<double> & profits, const std::vector<double> & tCreates,
+                const std::vector<double> & demandsR, const std::vector<unsigned> & sourcesR,
+                const std::vector<unsigned> & targetsR, const std::vector<double> & tStarts,
+                const std::vector<double> & tLimits, const std::vector<double> & speeds,
+                const std::vector<double> & capacities, const std::vector<unsigned> & sourcesK,
+                const std::vector<unsigned> & targetsK, const std::vector<double> x,
+                const std::vector<double> y, const std::vector<double> tVisits,
+                DistanceMode mode);
+
         /*******************************************
          * Constructs a new instance.
          *
@@ -173,13 +492,33 @@ class Instance {
          *******************************************/
         Instance(std::istream & is);
 
-        /*****************************************
+        /*********************************************************************
          * Constructs a new instance.
          *
+         * @param is   the input stream to read from.
+         * @param mode the way the lengths and travelling times are obtained.
+         *********************************************************************/
+        Instance(std::istream & is, DistanceMode mode);
+
+        /***********************************************************************************
+         * Constructs a new instance. The file can be in the text format, in the Li & Lim
+         * format or in the binary format written by writeBinary(), in which case it is
+         * mapped into memory.
+         *
          * @param filename the file to read from.
-         *****************************************/
+         ***********************************************************************************/
         Instance(const char * filename);
 
+        /************************************************************************************
+         * Constructs a new instance. The file can be in the text format, in the Li & Lim
+         * format or in the binary format, whose lengths and travelling times are only used
+         * in the MATRIX mode, unless they are asymmetric, in which case the mode is MATRIX.
+         *
+         * @param filename the file to read from.
+         * @param mode     the way the lengths and travelling times are obtained.
+         ************************************************************************************/
+        Instance(const char * filename, DistanceMode mode);
+
         /*****************************************
          * Constructs a new instance.
          *
@@ -187,6 +526,63 @@ class Instance {
          *****************************************/
         Instance(const std::string & filename);
 
+        /*************************************************************************
+         * Constructs a new instance.
+         *
+         * @param filename the file to read from.
+         * @param mode     the way the lengths and travelling times are obtained.
+         *************************************************************************/
+        Instance(const std::string & filename, DistanceMode mode);
+
+        /****************************************************************************************
+         * Constructs a new instance whose lengths, such as the road distances between the
+         * vertices, are not derived from the coordinates but read from a lengths file written
+         * by writeLengths(). The lengths may be asymmetric. The file is mapped into memory and
+         * its pages are only read when they are first accessed. It holds a header, with a
+         * magic number, a version, the number of vertices, the number of travelling time
+         * matrices and the stride of the rows, followed by the row-major matrix of lengths and
+         * either no travelling time matrix, in which case the travelling times are computed
+         * from the lengths, or one per speed class, each matrix starting on a 64-byte boundary.
+         *
+         * @param filename        the file to read from.
+         * @param lengthsFilename the lengths file to read from.
+         ****************************************************************************************/
+        Instance(const char * filename, const char * lengthsFilename);
+
+        /*************************************************************
+         * Constructs a new instance whose lengths are read from a
+         * lengths file.
+         *
+         * @param filename        the file to read from.
+         * @param lengthsFilename the lengths file to read from.
+         *************************************************************/
+        Instance(const std::string & filename, const std::string & lengthsFilename);
+
+        /*************************************************************************************
+         * Constructs a new instance from a binary instance written by writeBinary() at the
+         * specified offset of a mapped file, such as a cache file. The lengths and
+         * travelling times are used in place from the mapped file.
+         *
+         * @param file   the mapped file.
+         * @param offset the offset of the binary instance in the file, a multiple of 64.
+         * @param mode   the way the lengths and travelling times are obtained.
+         *************************************************************************************/
+        Instance(const std::shared_ptr<MappedFile> & file, std::size_t offset, DistanceMode mode);
+
+        /*************************************************************************************
+         * Constructs a new view of the specified instance restricted to the specified
+         * requests and vehicles, in the VIEW mode. The vertices of the view are the source
+         * and target of each vehicle followed by the source and target of each request,
+         * in the specified order. Its requests keep the eligibility and retirement of
+         * those of the parent.
+         *
+         * @param parent   the parent instance.
+         * @param requests the requests of the parent, indexed by their index in the view.
+         * @param vehicles the vehicles of the parent, indexed by their index in the view.
+         *************************************************************************************/
+        Instance(const std::shared_ptr<const Instance> & parent,
+                const std::vector<unsigned> & requests, const std::vector<unsigned> & vehicles);
+
         /*
          * Constructs a new empty instance.
          */
@@ -225,7 +621,7 @@ class Instance {
          *
          * @return the profit of each request.
          **************************************/
-        std::vector<double> getProfits() const;
+        ArrayView<double> getProfits() const;
 
         /*******************************************************
          * Returns the profit of the specified request.
@@ -241,7 +637,7 @@ class Instance {
          *
          * @return the creation time of each request.
          *********************************************/
-        std::vector<double> getTCreates() const;
+        ArrayView<double> getTCreates() const;
 
         /**************************************************************
          * Returns the creation time of the specified request.
@@ -257,7 +653,7 @@ class Instance {
          *
          * @return the demand of each request.
          ****************************************/
-        std::vector<double> getDemandsR() const;
+        ArrayView<double> getDemandsR() const;
 
         /*******************************************************
          * Returns the demand of the specified request.
@@ -273,7 +669,7 @@ class Instance {
          *
          * @return the source vertex of each request.
          *********************************************/
-        std::vector<unsigned> getSourcesR() const;
+        ArrayView<unsigned> getSourcesR() const;
 
         /**************************************************************
          * Returns the source vertex of the specified request.
@@ -289,7 +685,7 @@ class Instance {
          *
          * @return the target vertex of each request.
          *********************************************/
-        std::vector<unsigned> getTargetsR() const;
+        ArrayView<unsigned> getTargetsR() const;
 
         /**************************************************************
          * Returns the target vertex of the specified request.
@@ -305,7 +701,7 @@ class Instance {
          *
          * @return the starting time of operation of each vehicle.
          **********************************************************/
-        std::vector<double> getTStarts() const;
+        ArrayView<double> getTStarts() const;
 
         /***************************************************************************
          * Returns the starting time of operation of the specified vehicle.
@@ -321,7 +717,7 @@ class Instance {
          *
          * @return the maximum time-limit of operation of each vehicle.
          ***************************************************************/
-        std::vector<double> getTLimits() const;
+        ArrayView<double> getTLimits() const;
 
         /********************************************************************************
          * Returns the maximum time-limit of operation of the specified vehicle.
@@ -337,7 +733,7 @@ class Instance {
          *
          * @return the speed of each vehicle.
          *************************************/
-        std::vector<double> getSpeeds() const;
+        ArrayView<double> getSpeeds() const;
 
         /******************************************************
          * Returns the speed of the specified vehicle.
@@ -353,7 +749,7 @@ class Instance {
          *
          * @return the capacity of each vehicle.
          ******************************************/
-        std::vector<double> getCapacities() const;
+        ArrayView<double> getCapacities() const;
 
         /*********************************************************
          * Returns the capacity of the specified vehicle.
@@ -369,7 +765,7 @@ class Instance {
          *
          * @return the source vertex of each vehicle.
          *********************************************/
-        std::vector<unsigned> getSourcesK() const;
+        ArrayView<unsigned> getSourcesK() const;
 
         /************************************************************
          * Returns the source vertex of the specified vehicle.
@@ -385,7 +781,7 @@ class Instance {
          *
          * @return the target vertex of each vehicle.
          *********************************************/
-        std::vector<unsigned> getTargetsK() const;
+        ArrayView<unsigned> getTargetsK() const;
 
         /************************************************************
          * Returns the target vertex of the specified vehicle.
@@ -401,7 +797,7 @@ class Instance {
          *
          * @return the x coordinate of each vertex.
          *******************************************/
-        std::vector<double> getX() const;
+        ArrayView<double> getX() const;
 
         /************************************************************
          * Returns the x coordinate of the specified vertex.
@@ -417,7 +813,7 @@ class Instance {
          *
          * @return the y coordinate of each vertex.
          *******************************************/
-        std::vector<double> getY() const;
+        ArrayView<double> getY() const;
 
         /************************************************************
          * Returns the y coordinate of the specified vertex.
@@ -433,7 +829,7 @@ class Instance {
          *
          * @return the amount of time needed to visit each vertex.
          **********************************************************/
-        std::vector<double> getTVisits() const;
+        ArrayView<double> getTVisits() const;
 
         /***************************************************************************
          * Returns the amount of time needed to visit the specified vertex.
@@ -449,7 +845,7 @@ class Instance {
          *
          * @return the request associated with each vertex.
          ***************************************************/
-        std::vector<unsigned> getRequestsV() const;
+        ArrayView<unsigned> getRequestsV() const;
 
         /******************************************************************
          * Returns the request associated with the specified vertex.
@@ -465,7 +861,7 @@ class Instance {
          *
          * @return the vehicle associated with each vertex.
          ***************************************************/
-        std::vector<unsigned> getVehiclesV() const;
+        ArrayView<unsigned> getVehiclesV() const;
 
         /******************************************************************
          * Returns the vehicle associated with the specified vertex
@@ -476,6 +872,24 @@ class Instance {
          ******************************************************************/
         unsigned getVehicleV(unsigned v) const;
 
+        /****************************************************************
+         * Returns the record of the specified vertex.
+         *
+         * @param v the vertex whose record is to be returned.
+         *
+         * @return the record of the specified vertex.
+         ****************************************************************/
+        const VertexRecord & getVertex(unsigned v) const;
+
+        /****************************************************************
+         * Returns the role of the specified vertex.
+         *
+         * @param v the vertex whose role is to be returned.
+         *
+         * @return the role of the specified vertex.
+         ****************************************************************/
+        VertexRole getRole(unsigned v) const;
+
         /*************************************************************************************
          * Verifies whether the specified vertex is the source of a request or vehicle.
          *
@@ -499,7 +913,7 @@ class Instance {
          *
          * @return the demand of each vertex.
          ****************************************/
-        std::vector<double> getDemandsV() const;
+        ArrayView<double> getDemandsV() const;
 
         /******************************************************
          * Returns the demand of the specified vertex.
@@ -510,12 +924,86 @@ class Instance {
          ******************************************************/
         double getDemandV(unsigned v) const;
 
-        /****************************************************
-         * Returns the length of each edge.
+        /******************************************************************
+         * Returns the way the lengths and travelling times are obtained.
+         *
+         * @return the way the lengths and travelling times are obtained.
+         ******************************************************************/
+        DistanceMode getDistanceMode() const;
+
+        /**************************************************************
+         * Verifies whether the lengths are symmetric, which is only
+         * false for the lengths read from a lengths file, and for the
+         * views of such an instance.
+         *
+         * @return true if the lengths are symmetric; false otherwise.
+         **************************************************************/
+        bool isSymmetric() const;
+
+        /***************************************************************************************
+         * Returns a fingerprint of the data this instance was built from, which is the same
+         * for every instance built from the same data, whatever the format it was read from
+         * and the distance mode, and which keys the structures derived from the instance.
+         * It hashes the attributes of the requests, vehicles and vertices, the retired
+         * requests and, if they come from a lengths file, the lengths, in O(|V|) time, or
+         * O(|V|^2) time with a lengths file.
+         *
+         * @return a fingerprint of the data this instance was built from.
+         ***************************************************************************************/
+        uint64_t getFingerprint() const;
+
+        /**********************************************************************
+         * Returns the parent instance of this view.
+         *
+         * @return the parent instance of this view, or null for an instance.
+         **********************************************************************/
+        const std::shared_ptr<const Instance> & getParent() const;
+
+        /**********************************************************************
+         * Returns the request of the parent of each request of this view.
+         *
+         * @return the request of the parent of each request of this view.
+         **********************************************************************/
+        ArrayView<unsigned> getParentsR() const;
+
+        /**********************************************************************
+         * Returns the vehicle of the parent of each vehicle of this view.
+         *
+         * @return the vehicle of the parent of each vehicle of this view.
+         **********************************************************************/
+        ArrayView<unsigned> getParentsK() const;
+
+        /**********************************************************************
+         * Returns the vertex of the parent of each vertex of this view.
+         *
+         * @return the vertex of the parent of each vertex of this view.
+         **********************************************************************/
+        ArrayView<unsigned> getParentsV() const;
+
+        /*************************************************************
+         * Returns the index over the coordinates of the vertices.
+         *
+         * @return the index over the coordinates of the vertices.
+         *************************************************************/
+        const SpatialIndex & getSpatialIndex() const;
+
+        /****************************************************************
+         * Returns the length of each edge, which is empty outside the
+         * MATRIX mode.
          *
          * @return the length of each edge.
-         ****************************************************/
-        std::vector<std::vector<double>> getLengths() const;
+         ****************************************************************/
+        const Matrix & getLengths() const;
+
+        /***************************************************************************
+         * Returns the length of each edge leaving the specified vertex, which is
+         * empty outside the MATRIX mode.
+         *
+         * @param u the vertex whose leaving edges lengths are to be returned.
+         *
+         * @return the length of each edge leaving the specified vertex.
+         ***************************************************************************/
+        ArrayView<double> getLengths(unsigned u) const;
 
         /*************************************************************************
          * Returns the length of the specified edge.
@@ -527,20 +1015,206 @@ class Instance {
          *************************************************************************/
         double getLength(unsigned u, unsigned v) const;
 
-        /***********************************************************
-         * Verifies whether this instance is valid.
+        /*******************************************************************************
+         * Computes the length of the edges from the specified vertex to each of the
+         * specified vertices. In the ON_THE_FLY mode the loop is vectorised over the
+         * coordinates of the vertices.
+         *
+         * @param u        the first vertex of the edges.
+         * @param vertices the second vertex of each edge.
+         * @param lengths  the array receiving the length of each edge, with room for
+         *                 one value per vertex.
+         *******************************************************************************/
+        void getLengths(unsigned u, ArrayView<unsigned> vertices, double * lengths) const;
+
+        /************************************************************
+         * Returns the number of distinct vehicle speeds.
+         *
+         * @return the number of distinct vehicle speeds.
+         ************************************************************/
+        unsigned getNumSpeedClasses() const;
+
+        /*************************************************************
+         * Returns the speed class of the specified vehicle.
+         *
+         * @param k the vehicle whose speed class is to be returned.
+         *
+         * @return the speed class of the specified vehicle.
+         *************************************************************/
+        unsigned getSpeedClass(unsigned k) const;
+
+        /****************************************************************************
+         * Returns the travelling time of each edge for the specified vehicle, which
+         * is an empty matrix outside the MATRIX mode or once requests have been
+         * added.
+         *
+         * @param k the vehicle whose travelling times are to be returned.
+         *
+         * @return the travelling time of each edge for the specified vehicle.
+         ****************************************************************************/
+        const Matrix & getTravelTimes(unsigned k) const;
+
+        /**************************************************************************
+         * Returns the travelling time of the specified edge for the specified
+         * vehicle.
+         *
+         * @param u the first vertex of the edge whose travelling time is to be
+         *          returned.
+         * @param v the second vertex of the edge whose travelling time is to be
+         *          returned.
+         * @param k the vehicle whose travelling time is to be returned.
+         *
+         * @return the travelling time of the specified edge for the specified
+         *         vehicle.
+         **************************************************************************/
+        double getTravelTime(unsigned u, unsigned v, unsigned k) const;
+
+        /*******************************************************************************
+         * Computes the travelling time of the edges from the specified vertex to each
+         * of the specified vertices for the specified vehicle.
+         *
+         * @param u           the first vertex of the edges.
+         * @param vertices    the second vertex of each edge.
+         * @param k           the vehicle whose travelling times are to be computed.
+         * @param travelTimes the array receiving the travelling time of each edge,
+         *                    with room for one value per vertex.
+         *******************************************************************************/
+        void getTravelTimes(unsigned u, ArrayView<unsigned> vertices, unsigned k,
+                double * travelTimes) const;
+
+        /*************************************************************************************
+         * Verifies whether the specified vehicle can serve the specified request, that is,
+         * whether the demand of the request fits the capacity of the vehicle and the direct
+         * trip from the source of the vehicle through the source and the target of the
+         * request to the target of the vehicle fits its time-limit. A solution never
+         * assigns a request to a vehicle that cannot serve it.
+         *
+         * @param r the request.
+         * @param k the vehicle.
+         *
+         * @return true if the specified vehicle can serve the specified request; false
+         *         otherwise.
+         *************************************************************************************/
+        bool isEligible(unsigned r, unsigned k) const;
+
+        /*************************************************************************************
+         * Returns a lower bound on the fulfillment time of the specified request when served
+         * by the specified vehicle, which is reached by the direct trip from the source of
+         * the vehicle through the source and the target of the request.
+         *
+         * @param r the request.
+         * @param k the vehicle.
+         *
+         * @return a lower bound on the fulfillment time of the specified request when
+         *         served by the specified vehicle.
+         *************************************************************************************/
+        double getMinTFulfill(unsigned r, unsigned k) const;
+
+        /************************************************************************************
+         * Adds a new request, whose source and target are appended to the vertices, and
+         * returns it. The new lengths are computed in time linear in the number of
+         * vertices, amortized over the reallocations of the lengths, and the eligibility
+         * of the request in time linear in the number of vehicles. The travelling times
+         * are no longer stored, but derived from the lengths, and the new vertices are
+         * inserted into the spatial index rather than rebuilding it.
+         *
+         * Throws an exception if the instance uses the lengths of a lengths file or is a
+         * view.
+         *
+         * @param profit       the profit of the request.
+         * @param tCreate      the creation time of the request.
+         * @param demand       the demand of the request.
+         * @param xSource      the x coordinate of the source of the request.
+         * @param ySource      the y coordinate of the source of the request.
+         * @param tVisitSource the amount of time needed to visit the source of the request.
+         * @param xTarget      the x coordinate of the target of the request.
+         * @param yTarget      the y coordinate of the target of the request.
+         * @param tVisitTarget the amount of time needed to visit the target of the request.
+         *
+         * @return the new request.
+         ************************************************************************************/
+        unsigned addRequest(double profit, double tCreate, double demand, double xSource,
+                double ySource, double tVisitSource, double xTarget, double yTarget,
+                double tVisitTarget);
+
+        /************************************************************************************
+         * Retires the specified request, which no vehicle can serve afterwards and whose
+         * profit no longer counts towards the sum of the profits. The request and its
+         * vertices keep their indices.
+         *
+         * Throws an exception if the request does not exist or was already retired, or
+         * if the instance is a view.
+         *
+         * @param r the request to be retired.
+         ************************************************************************************/
+        void removeRequest(unsigned r);
+
+        /************************************************************************************
+         * Moves the source of the specified vehicle to its current position and updates
+         * its starting time, time-limit and capacity. The lengths of the source are
+         * recomputed in time linear in the number of vertices, and the eligibility of the
+         * vehicle in time linear in the number of requests. The speed of a vehicle, which
+         * defines its speed class, cannot be changed.
+         *
+         * Throws an exception if the vehicle does not exist or if the instance uses the
+         * lengths of a lengths file or is a view.
+         *
+         * @param k        the vehicle to be updated.
+         * @param x        the new x coordinate of the source of the vehicle.
+         * @param y        the new y coordinate of the source of the vehicle.
+         * @param tStart   the new starting time of operation of the vehicle.
+         * @param tLimit   the new maximum time-limit of operation of the vehicle.
+         * @param capacity the new capacity of the vehicle.
+         ************************************************************************************/
+        void updateVehicle(unsigned k, double x, double y, double tStart, double tLimit,
+                double capacity);
+
+        /*************************************************************
+         * Verifies whether the specified request was retired.
+         *
+         * @param r the request.
+         *
+         * @return true if the specified request was retired; false
+         *         otherwise.
+         *************************************************************/
+        bool isRetired(unsigned r) const;
+
+        /*************************************************************************************
+         * Verifies whether this instance is valid. A view does not validate its parent: it
+         * checks the lengths between its own vertices only, read from its parent, in time
+         * quadratic in its number of vertices at the METRIC level and cubic at the FULL
+         * level, and its error codes refer to its own vertices.
          *
          * @param error the error code.
+         * @param level the level of validation.
          *
          * @return true if this instance is valid; false otherwise.
-         ***********************************************************/
+         *************************************************************************************/
+        bool isValid(unsigned & error, ValidationLevel level) const;
+
+        /*************************************************************
+         * Verifies whether this instance is valid, with every check.
+         *
+         * @param error the error code.
+         *
+         * @return true if this instance is valid; false otherwise.
+         *************************************************************/
         bool isValid(unsigned & error) const;
 
         /***********************************************************
          * Verifies whether this instance is valid.
          *
+         * @param level the level of validation.
+         *
          * @return true if this instance is valid; false otherwise.
          ***********************************************************/
+        bool isValid(ValidationLevel level) const;
+
+        /*************************************************************
+         * Verifies whether this instance is valid, with every check.
+         *
+         * @return true if this instance is valid; false otherwise.
+         *************************************************************/
         bool isValid() const;
 
         /********************************************************
@@ -561,5 +1235,107 @@ class Instance {
          * Write this instance into the standard output stream.
          *******************************************************/
         void write() const;
+
+        /***************************************************************************************
+         * Write this instance, including the lengths and travelling times of the edges, into
+         * the specified output stream in the binary format. Only available in the MATRIX mode.
+         *
+         * @param os the output stream to write into.
+         ***************************************************************************************/
+        void writeBinary(std::ostream & os) const;
+
+        /**************************************************************************************
+         * Write this instance, including the lengths and travelling times of the edges, into
+         * the specified file in the binary format. Only available in the MATRIX mode.
+         *
+         * @param filename the file to write into.
+         **************************************************************************************/
+        void writeBinary(const char * filename) const;
+
+        /**************************************************************************************
+         * Write the lengths and travelling times of the edges of this instance into the
+         * specified output stream in the lengths file format. Only available in the MATRIX
+         * mode.
+         *
+         * @param os the output stream to write into.
+         **************************************************************************************/
+        void writeLengths(std::ostream & os) const;
+
+        /**************************************************************************************
+         * Write the lengths and travelling times of the edges of this instance into the
+         * specified file in the lengths file format. Only available in the MATRIX mode.
+         *
+         * @param filename the file to write into.
+         **************************************************************************************/
+        void writeLengths(const char * filename) const;
 };
 
+inline double Instance::getTVisit(unsigned v) const {
+    return this->recordsV[v].tVisit;
+}
+
+inline unsigned Instance::getRequestV(unsigned v) const {
+    return this->recordsV[v].request;
+}
+
+inline unsigned Instance::getVehicleV(unsigned v) const {
+    return this->recordsV[v].vehicle;
+}
+
+inline const VertexRecord & Instance::getVertex(unsigned v) const {
+    return this->recordsV[v];
+}
+
+inline VertexRole Instance::getRole(unsigned v) const {
+    return this->recordsV[v].role;
+}
+
+inline bool Instance::isASource(unsigned v) const {
+    return this->recordsV[v].role == VertexRole::REQUEST_SOURCE ||
+        this->recordsV[v].role == VertexRole::VEHICLE_SOURCE;
+}
+
+inline bool Instance::isATarget(unsigned v) const {
+    return this->recordsV[v].role == VertexRole::REQUEST_TARGET ||
+        this->recordsV[v].role == VertexRole::VEHICLE_TARGET;
+}
+
+inline double Instance::getDemandV(unsigned v) const {
+    return this->recordsV[v].demand;
+}
+
+inline double Instance::getLength(unsigned u, unsigned v) const {
+    if(this->distanceMode == DistanceMode::ON_THE_FLY) {
+        return sqrt((this->x[u] - this->x[v])*(this->x[u] - this->x[v]) +
+                (this->y[u] - this->y[v])*(this->y[u] - this->y[v]));
+    }
+
+    if(this->distanceMode == DistanceMode::VIEW) {
+        return this->parent->getLength(this->parentsV[u], this->parentsV[v]);
+    }
+
+    return this->lengths.get(u, v);
+}
+
+inline double Instance::getTravelTime(unsigned u, unsigned v, unsigned k) const {
+    if(this->distanceMode == DistanceMode::ON_THE_FLY) {
+        return this->getLength(u, v) / this->speeds[k];
+    }
+
+    if(this->distanceMode == DistanceMode::VIEW) {
+        return this->parent->getTravelTime(this->parentsV[u], this->parentsV[v],
+                this->parentsK[k]);
+    }
+
+    unsigned c = this->speedClassesK[k];
+
+    if(c < this->travelTimes.size()) {
+        return this->travelTimes[c].get(u, v);
+    }
+
+    return this->lengths.get(u, v) / this->speedsC[c];
+}
+
+inline bool Instance::isEligible(unsigned r, unsigned k) const {
+    return (this->eligibleRK[r * this->numWordsK + k / 64] >> (k % 64)) & 1;
+}
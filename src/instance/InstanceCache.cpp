@@ -0,0 +1,166 @@
+#include "InstanceCache.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*****************************************************
+ * The first bytes of a file of the cache.
+ *****************************************************/
+static const char CACHE_MAGIC[8] = {'M', 'V', 'R', 'P', 'P', 'D', 'C', '\0'};
+
+/*****************************************************
+ * The version of the layout of a file of the cache.
+ *****************************************************/
+static const uint32_t CACHE_VERSION = 1;
+
+/***********************************************************************
+ * The version of the binary instances in the cache, which must follow
+ * the version of the binary instance format.
+ ***********************************************************************/
+static const uint32_t INSTANCE_VERSION = 2;
+
+/*****************************************************
+ * The version of the arc filters in the cache.
+ *****************************************************/
+static const uint32_t ARC_FILTER_VERSION = 1;
+
+/*****************************************************
+ * The header of a file of the cache.
+ *****************************************************/
+struct CacheHeader {
+    char magic[8];
+    uint32_t cacheVersion;
+    uint32_t version;
+    uint64_t fingerprint;
+    char type[16];
+};
+
+static_assert(sizeof(CacheHeader) <= InstanceCache::PAYLOAD_OFFSET,
+        "The header of a file of the cache must fit before its structure.");
+
+/******************************************************
+ * Fills the header of the specified structure.
+ *
+ * @param fingerprint the fingerprint of the instance.
+ * @param type        the type of the structure.
+ * @param version     the version of the structure.
+ *
+ * @return the header of the specified structure.
+ ******************************************************/
+static CacheHeader getHeader(uint64_t fingerprint, const std::string & type, uint32_t version) {
+    CacheHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.cacheVersion = CACHE_VERSION;
+    header.version = version;
+    header.fingerprint = fingerprint;
+    strncpy(header.type, type.c_str(), sizeof(header.type) - 1);
+
+    return header;
+}
+
+InstanceCache::InstanceCache(const std::string & directory) : directory(directory) {
+    if(mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw "Cache directory not created.";
+    }
+}
+
+const std::string & InstanceCache::getDirectory() const {
+    return this->directory;
+}
+
+std::string InstanceCache::getFilename(uint64_t fingerprint, const std::string & type,
+        uint32_t version) const {
+    char name[17];
+
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long) fingerprint);
+
+    return this->directory + "/" + name + "." + type + ".v" + std::to_string(version);
+}
+
+std::shared_ptr<MappedFile> InstanceCache::find(uint64_t fingerprint, const std::string & type,
+        uint32_t version) const {
+    std::string filename = this->getFilename(fingerprint, type, version);
+    CacheHeader header = getHeader(fingerprint, type, version);
+
+    if(access(filename.c_str(), R_OK) != 0) {
+        return std::shared_ptr<MappedFile>();
+    }
+
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(filename.c_str());
+
+    if(file->size() < PAYLOAD_OFFSET || memcmp(file->getData(), &header, sizeof(header)) != 0) {
+        return std::shared_ptr<MappedFile>();
+    }
+
+    return file;
+}
+
+void InstanceCache::store(uint64_t fingerprint, const std::string & type, uint32_t version,
+        const std::function<void(std::ostream &)> & write) const {
+    static std::atomic<unsigned> numFiles(0);
+    std::string filename = this->getFilename(fingerprint, type, version);
+    std::string temporaryFilename = filename + ".tmp." + std::to_string(getpid()) + "." +
+        std::to_string(numFiles++);
+    CacheHeader header = getHeader(fingerprint, type, version);
+    char padding[PAYLOAD_OFFSET - sizeof(header)] = {};
+    std::ofstream ofs(temporaryFilename, std::ios::binary);
+
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(padding, sizeof(padding));
+    write(ofs);
+    ofs.close();
+
+    // the file only appears under its name once it is complete
+    if(!ofs || rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+        remove(temporaryFilename.c_str());
+        throw "Cache file not written.";
+    }
+}
+
+Instance InstanceCache::getInstance(const std::string & filename, DistanceMode mode) const {
+    // reading the file without computing the lengths is enough to fingerprint it
+    Instance instance(filename, DistanceMode::ON_THE_FLY);
+
+    if(mode == DistanceMode::ON_THE_FLY) {
+        return instance;
+    }
+
+    uint64_t fingerprint = instance.getFingerprint();
+    std::shared_ptr<MappedFile> file = this->find(fingerprint, "instance", INSTANCE_VERSION);
+
+    if(file) {
+        return Instance(file, PAYLOAD_OFFSET, mode);
+    }
+
+    instance = Instance(filename, mode);
+
+    this->store(fingerprint, "instance", INSTANCE_VERSION, [&](std::ostream & os) {
+        instance.writeBinary(os);
+    });
+
+    return instance;
+}
+
+ArcFilter InstanceCache::getArcFilter(const Instance & instance) const {
+    uint64_t fingerprint = instance.getFingerprint();
+    std::shared_ptr<MappedFile> file = this->find(fingerprint, "arcfilter", ARC_FILTER_VERSION);
+
+    if(file) {
+        return ArcFilter(file, PAYLOAD_OFFSET);
+    }
+
+    ArcFilter arcFilter(instance);
+
+    this->store(fingerprint, "arcfilter", ARC_FILTER_VERSION, [&](std::ostream & os) {
+        arcFilter.write(os);
+    });
+
+    return arcFilter;
+}
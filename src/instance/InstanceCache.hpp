@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ArcFilter.hpp"
+#include "Instance.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+
+/*********************************************************************************************
+ * The InstanceCache class represents a directory where the structures derived from an
+ * instance are kept between runs, so that the experiments repeated on the same instance,
+ * such as a sweep over seeds, pay for its preprocessing only once. Each structure is kept
+ * in its own file, named after the fingerprint of the instance, the type of the structure
+ * and the version of its format, and is mapped into memory when it is found again.
+ *
+ * Each file starts with a 64-byte header holding a magic number, the version of the cache,
+ * the fingerprint, the type and the version of the structure, followed by the structure.
+ * A file is written under a temporary name and then renamed, so that concurrent runs never
+ * read a partial file. Files whose header does not match are ignored and overwritten.
+ *********************************************************************************************/
+class InstanceCache {
+    private:
+        /******************************
+         * The directory of the cache.
+         ******************************/
+        std::string directory;
+
+    public:
+        /*************************************************************
+         * The offset of the structure in a file of the cache.
+         *************************************************************/
+        static const std::size_t PAYLOAD_OFFSET = 64;
+
+        /*************************************************************************
+         * Constructs a new cache over the specified directory, creating the
+         * directory if it does not exist.
+         *
+         * Throws an exception if the directory cannot be created.
+         *
+         * @param directory the directory of the cache.
+         *************************************************************************/
+        InstanceCache(const std::string & directory);
+
+        /*************************************************************************
+         * Returns the directory of this cache.
+         *
+         * @return the directory of this cache.
+         *************************************************************************/
+        const std::string & getDirectory() const;
+
+        /***************************************************************************
+         * Returns the name of the file holding the specified structure.
+         *
+         * @param fingerprint the fingerprint of the instance.
+         * @param type        the type of the structure.
+         * @param version     the version of the format of the structure.
+         *
+         * @return the name of the file holding the specified structure.
+         ***************************************************************************/
+        std::string getFilename(uint64_t fingerprint, const std::string & type,
+                uint32_t version) const;
+
+        /**************************************************************************************
+         * Maps the file holding the specified structure, whose structure starts at
+         * PAYLOAD_OFFSET.
+         *
+         * @param fingerprint the fingerprint of the instance.
+         * @param type        the type of the structure.
+         * @param version     the version of the format of the structure.
+         *
+         * @return the mapped file, or an empty pointer if the structure is not in this cache.
+         **************************************************************************************/
+        std::shared_ptr<MappedFile> find(uint64_t fingerprint, const std::string & type,
+                uint32_t version) const;
+
+        /**************************************************************************************
+         * Stores the specified structure, written by the specified function.
+         *
+         * Throws an exception if the file cannot be written.
+         *
+         * @param fingerprint the fingerprint of the instance.
+         * @param type        the type of the structure, of at most 15 characters.
+         * @param version     the version of the format of the structure.
+         * @param write       the function that writes the structure into an output stream.
+         **************************************************************************************/
+        void store(uint64_t fingerprint, const std::string & type, uint32_t version,
+                const std::function<void(std::ostream &)> & write) const;
+
+        /**************************************************************************************
+         * Reads the instance in the specified file. In the MATRIX mode, its lengths and
+         * travelling times are mapped from this cache, or computed and stored if missing.
+         *
+         * @param filename the file to read from.
+         * @param mode     the way the lengths and travelling times are obtained.
+         *
+         * @return the instance in the specified file.
+         **************************************************************************************/
+        Instance getInstance(const std::string & filename, DistanceMode mode) const;
+
+        /**************************************************************************************
+         * Returns the arc filter of the specified instance, mapped from this cache, or
+         * computed and stored if missing.
+         *
+         * @param instance the instance.
+         *
+         * @return the arc filter of the specified instance.
+         **************************************************************************************/
+        ArcFilter getArcFilter(const Instance & instance) const;
+};
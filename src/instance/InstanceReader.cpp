@@ -0,0 +1,187 @@
+#include "InstanceReader.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/****************************************************************************************
+ * The powers of ten that are exactly representable as doubles.
+ ****************************************************************************************/
+static const double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/********************************************************************************
+ * Verifies whether the specified character is a white space.
+ *
+ * @param c the character to be verified.
+ *
+ * @return true if the specified character is a white space; false otherwise.
+ ********************************************************************************/
+static inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void InstanceReader::skipSpaces() {
+    while(this->current < this->end && isSpace(* this->current)) {
+        if(* this->current == '\n') {
+            this->line++;
+            this->lineBegin = this->current + 1;
+        }
+
+        this->current++;
+    }
+}
+
+double InstanceReader::readNumber() {
+    this->skipSpaces();
+
+    const char * token = this->current;
+    const char * c = token;
+    bool negative = false;
+    unsigned long long mantissa = 0;
+    unsigned numDigits = 0, numDecimals = 0;
+
+    if(c < this->end && (* c == '-' || * c == '+')) {
+        negative = * c == '-';
+        c++;
+    }
+
+    while(c < this->end && * c >= '0' && * c <= '9') {
+        mantissa = mantissa * 10 + (* c - '0');
+        numDigits++;
+        c++;
+    }
+
+    if(c < this->end && * c == '.') {
+        c++;
+
+        while(c < this->end && * c >= '0' && * c <= '9') {
+            mantissa = mantissa * 10 + (* c - '0');
+            numDigits++;
+            numDecimals++;
+            c++;
+        }
+    }
+
+    if(numDigits == 0) {
+        this->error("number expected");
+    }
+
+    // a mantissa below 2^53 divided by an exact power of ten is correctly rounded
+    if((c == this->end || isSpace(* c)) && numDigits <= 15 && numDecimals <= 22) {
+        double value = ((double) mantissa) / POWERS_OF_TEN[numDecimals];
+
+        this->current = c;
+
+        return negative ? -value : value;
+    }
+
+    // otherwise fall back to strtod, which needs a terminated copy of the token
+    while(c < this->end && !isSpace(* c)) {
+        c++;
+    }
+
+    char buffer[64];
+    char * tokenEnd;
+
+    if(c - token >= (long) sizeof(buffer)) {
+        this->error("number too long");
+    }
+
+    memcpy(buffer, token, c - token);
+    buffer[c - token] = '\0';
+
+    double value = strtod(buffer, &tokenEnd);
+
+    if(tokenEnd != buffer + (c - token)) {
+        this->current = token + (tokenEnd - buffer);
+        this->error("malformed number");
+    }
+
+    this->current = c;
+
+    return value;
+}
+
+void InstanceReader::fail(const std::string & message) {
+    static thread_local std::string buffer;
+
+    buffer = message;
+
+    throw buffer.c_str();
+}
+
+void InstanceReader::error(const std::string & message) const {
+    fail("line " + std::to_string(this->line) + ", column " +
+            std::to_string(this->current - this->lineBegin + 1) + ": " + message + ".");
+}
+
+InstanceReader::InstanceReader(const char * begin, const char * end) :
+    begin(begin),
+    end(end),
+    current(begin),
+    line(1),
+    lineBegin(begin) {}
+
+void InstanceReader::read(std::vector<double> & profits, std::vector<double> & tCreates,
+        std::vector<double> & demandsR, std::vector<unsigned> & sourcesR,
+        std::vector<unsigned> & targetsR, std::vector<double> & tStarts,
+        std::vector<double> & tLimits, std::vector<double> & speeds,
+        std::vector<double> & capacities, std::vector<unsigned> & sourcesK,
+        std::vector<unsigned> & targetsK, std::vector<double> & x, std::vector<double> & y,
+        std::vector<double> & tVisits) {
+    // numbers never contain a 'k' or an 'r', so this counts the records
+    std::size_t numVehicles = std::count(this->begin, this->end, 'k');
+    std::size_t numRequests = std::count(this->begin, this->end, 'r');
+    std::size_t numVertices = x.size() + 2 * (numVehicles + numRequests);
+
+    profits.reserve(profits.size() + numRequests);
+    tCreates.reserve(tCreates.size() + numRequests);
+    demandsR.reserve(demandsR.size() + numRequests);
+    sourcesR.reserve(sourcesR.size() + numRequests);
+    targetsR.reserve(targetsR.size() + numRequests);
+    tStarts.reserve(tStarts.size() + numVehicles);
+    tLimits.reserve(tLimits.size() + numVehicles);
+    speeds.reserve(speeds.size() + numVehicles);
+    capacities.reserve(capacities.size() + numVehicles);
+    sourcesK.reserve(sourcesK.size() + numVehicles);
+    targetsK.reserve(targetsK.size() + numVehicles);
+    x.reserve(numVertices);
+    y.reserve(numVertices);
+    tVisits.reserve(numVertices);
+
+    this->skipSpaces();
+
+    while(this->current < this->end) {
+        char c = * this->current;
+
+        if(c == 'k') {
+            this->current++;
+
+            tStarts.push_back(this->readNumber());
+            tLimits.push_back(this->readNumber());
+            speeds.push_back(this->readNumber());
+            capacities.push_back(this->readNumber());
+            sourcesK.push_back(x.size());
+            targetsK.push_back(x.size() + 1);
+        } else if(c == 'r') {
+            this->current++;
+
+            profits.push_back(this->readNumber());
+            tCreates.push_back(this->readNumber());
+            demandsR.push_back(this->readNumber());
+            sourcesR.push_back(x.size());
+            targetsR.push_back(x.size() + 1);
+        } else {
+            this->error(std::string("unknown record type '") + c + "'");
+        }
+
+        for(unsigned i = 0; i < 2; i++) {
+            x.push_back(this->readNumber());
+            y.push_back(this->readNumber());
+            tVisits.push_back(this->readNumber());
+        }
+
+        this->skipSpaces();
+    }
+}
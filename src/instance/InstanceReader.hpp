@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*********************************************************************************************
+ * The InstanceReader class represents a parser of MVRPPD instances in the text format. It
+ * parses a whole buffer at once and reports the line and column of any malformed input.
+ *********************************************************************************************/
+class InstanceReader {
+    protected:
+        /**************************************
+         * The first character of the buffer.
+         **************************************/
+        const char * begin;
+
+        /********************************************
+         * The character past the end of the buffer.
+         ********************************************/
+        const char * end;
+
+        /***********************************
+         * The next character to be parsed.
+         ***********************************/
+        const char * current;
+
+        /*************************************
+         * The line of the next character.
+         *************************************/
+        unsigned line;
+
+        /*************************************************
+         * The first character of the line being parsed.
+         *************************************************/
+        const char * lineBegin;
+
+        /*****************************************************************
+         * Skips the white spaces before the next character to be parsed.
+         *****************************************************************/
+        void skipSpaces();
+
+        /*************************************
+         * Parses the next number.
+         *
+         * @return the next number.
+         *************************************/
+        double readNumber();
+
+        /*****************************************************************************************
+         * Throws the specified message as a string, like the rest of the library. The message
+         * is kept in a buffer of the calling thread, so it remains valid until the next error
+         * of a reader in the same thread.
+         *
+         * @param message the message to be thrown.
+         *****************************************************************************************/
+        [[noreturn]] static void fail(const std::string & message);
+
+        /****************************************************************************
+         * Throws an exception reporting the line and column of the next character.
+         *
+         * @param message the description of the error.
+         ****************************************************************************/
+        [[noreturn]] void error(const std::string & message) const;
+
+    public:
+        /*********************************************************
+         * Constructs a new reader.
+         *
+         * @param begin the first character of the buffer.
+         * @param end   the character past the end of the buffer.
+         *********************************************************/
+        InstanceReader(const char * begin, const char * end);
+
+        /***************************************************************************************
+         * Parses the buffer, appending each vehicle and request to the specified arrays. The
+         * vertices are numbered in the order they appear in the buffer.
+         *
+         * @param profits    the profit of each request.
+         * @param tCreates   the creation time of each request.
+         * @param demandsR   the demand of each request.
+         * @param sourcesR   the source vertex of each request.
+         * @param targetsR   the destination vertex of each request.
+         * @param tStarts    the starting time of operation of each vehicle.
+         * @param tLimits    the maximum time-limit of operation of each vehicle.
+         * @param speeds     the speed of each vehicle.
+         * @param capacities the capacity of each vehicle.
+         * @param sourcesK   the source vertex of each vehicle.
+         * @param targetsK   the destination vertex of each vehicle.
+         * @param x          the x coordinate of each vertex.
+         * @param y          the y coordinate of each vertex.
+         * @param tVisits    the amount of time needed to visit each vertex.
+         ***************************************************************************************/
+        void read(std::vector<double> & profits, std::vector<double> & tCreates,
+                std::vector<double> & demandsR, std::vector<unsigned> & sourcesR,
+                std::vector<unsigned> & targetsR, std::vector<double> & tStarts,
+                std::vector<double> & tLimits, std::vector<double> & speeds,
+                std::vector<double> & capacities, std::vector<unsigned> & sourcesK,
+                std::vector<unsigned> & targetsK, std::vector<double> & x,
+                std::vector<double> & y, std::vector<double> & tVisits);
+};
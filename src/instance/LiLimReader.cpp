@@ -0,0 +1,123 @@
+#include "LiLimReader.hpp"
+
+#include <algorithm>
+
+LiLimReader::LiLimReader(const char * begin, const char * end) : InstanceReader(begin, end) {}
+
+void LiLimReader::read(std::vector<double> & profits, std::vector<double> & tCreates,
+        std::vector<double> & demandsR, std::vector<unsigned> & sourcesR,
+        std::vector<unsigned> & targetsR, std::vector<double> & tStarts,
+        std::vector<double> & tLimits, std::vector<double> & speeds,
+        std::vector<double> & capacities, std::vector<unsigned> & sourcesK,
+        std::vector<unsigned> & targetsK, std::vector<double> & x, std::vector<double> & y,
+        std::vector<double> & tVisits) {
+    // the tasks are kept until every pickup task can be matched with its delivery task
+    std::size_t numLines = std::count(this->begin, this->end, '\n') + 1;
+    std::vector<double> xT, yT, demandsT, tReadysT, tDuesT, tVisitsT;
+    std::vector<unsigned> pickupsT, deliveriesT;
+
+    xT.reserve(numLines);
+    yT.reserve(numLines);
+    demandsT.reserve(numLines);
+    tReadysT.reserve(numLines);
+    tDuesT.reserve(numLines);
+    tVisitsT.reserve(numLines);
+    pickupsT.reserve(numLines);
+    deliveriesT.reserve(numLines);
+
+    unsigned numVehicles = this->readNumber();
+    double capacity = this->readNumber();
+    double speed = this->readNumber();
+
+    this->skipSpaces();
+
+    while(this->current < this->end) {
+        const char * task = this->current;
+
+        if(this->readNumber() != xT.size()) {
+            this->current = task;
+            this->error("task " + std::to_string(xT.size()) + " expected");
+        }
+
+        xT.push_back(this->readNumber());
+        yT.push_back(this->readNumber());
+        demandsT.push_back(this->readNumber());
+        tReadysT.push_back(this->readNumber());
+        tDuesT.push_back(this->readNumber());
+        tVisitsT.push_back(this->readNumber());
+        pickupsT.push_back(this->readNumber());
+        deliveriesT.push_back(this->readNumber());
+
+        this->skipSpaces();
+    }
+
+    if(xT.empty()) {
+        this->error("depot expected");
+    }
+
+    // reports an error in the line of the specified task
+    auto taskError = [&](unsigned t, const std::string & message) {
+        fail("line " + std::to_string(t + 2) + ": " + message + ".");
+    };
+
+    unsigned numRequests = (xT.size() - 1) / 2;
+
+    profits.reserve(profits.size() + numRequests);
+    tCreates.reserve(tCreates.size() + numRequests);
+    demandsR.reserve(demandsR.size() + numRequests);
+    sourcesR.reserve(sourcesR.size() + numRequests);
+    targetsR.reserve(targetsR.size() + numRequests);
+    x.reserve(x.size() + 2 * (numVehicles + numRequests));
+    y.reserve(y.size() + 2 * (numVehicles + numRequests));
+    tVisits.reserve(tVisits.size() + 2 * (numVehicles + numRequests));
+
+    // appends a vertex at the specified task
+    auto addVertex = [&](unsigned t) {
+        x.push_back(xT[t]);
+        y.push_back(yT[t]);
+        tVisits.push_back(tVisitsT[t]);
+    };
+
+    for(unsigned k = 0; k < numVehicles; k++) {
+        tStarts.push_back(tReadysT[0]);
+        tLimits.push_back(tDuesT[0] - tReadysT[0]);
+        speeds.push_back(speed);
+        capacities.push_back(capacity);
+        sourcesK.push_back(x.size());
+        addVertex(0);
+        targetsK.push_back(x.size());
+        addVertex(0);
+    }
+
+    for(unsigned t = 1; t < xT.size(); t++) {
+        if(pickupsT[t] != 0) {
+            if(pickupsT[t] >= xT.size() || deliveriesT[pickupsT[t]] != t) {
+                taskError(t, "unmatched delivery task");
+            }
+        } else {
+            unsigned d = deliveriesT[t];
+
+            if(d == 0 || d >= xT.size() || pickupsT[d] != t) {
+                taskError(t, "unmatched pickup task");
+            }
+
+            profits.push_back(demandsT[t]);
+            tCreates.push_back(tReadysT[t]);
+            demandsR.push_back(demandsT[t]);
+            sourcesR.push_back(x.size());
+            addVertex(t);
+            targetsR.push_back(x.size());
+            addVertex(d);
+        }
+    }
+}
+
+bool LiLimReader::isLiLim(const char * begin, const char * end) {
+    const char * c = begin;
+
+    while(c < end && (* c == ' ' || * c == '\t' || * c == '\r' || * c == '\n')) {
+        c++;
+    }
+
+    return c < end && * c >= '0' && * c <= '9';
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "InstanceReader.hpp"
+
+/*********************************************************************************************
+ * The LiLimReader class represents a parser of the pickup and delivery benchmark instances
+ * of Li & Lim. Their first line holds the number of vehicles, their capacity and speed, and
+ * each following line holds a task: its index, coordinates, demand, time window, service
+ * time and the indices of its pickup and delivery tasks. Task 0 is the depot.
+ *
+ * Every vehicle starts and ends at its own copy of the depot and operates during the time
+ * window of the depot. Every pickup task and its delivery task become a request created at
+ * the start of the time window of the pickup, whose profit is its demand. The remaining
+ * time windows are not part of the MVRPPD and are ignored.
+ *********************************************************************************************/
+class LiLimReader : public InstanceReader {
+    public:
+        /*********************************************************
+         * Constructs a new reader.
+         *
+         * @param begin the first character of the buffer.
+         * @param end   the character past the end of the buffer.
+         *********************************************************/
+        LiLimReader(const char * begin, const char * end);
+
+        /***************************************************************************************
+         * Parses the buffer, appending each vehicle and request to the specified arrays. The
+         * vertices of the vehicles come first, followed by the vertices of the requests in
+         * the order of their pickup tasks.
+         *
+         * @param profits    the profit of each request.
+         * @param tCreates   the creation time of each request.
+         * @param demandsR   the demand of each request.
+         * @param sourcesR   the source vertex of each request.
+         * @param targetsR   the destination vertex of each request.
+         * @param tStarts    the starting time of operation of each vehicle.
+         * @param tLimits    the maximum time-limit of operation of each vehicle.
+         * @param speeds     the speed of each vehicle.
+         * @param capacities the capacity of each vehicle.
+         * @param sourcesK   the source vertex of each vehicle.
+         * @param targetsK   the destination vertex of each vehicle.
+         * @param x          the x coordinate of each vertex.
+         * @param y          the y coordinate of each vertex.
+         * @param tVisits    the amount of time needed to visit each vertex.
+         ***************************************************************************************/
+        void read(std::vector<double> & profits, std::vector<double> & tCreates,
+                std::vector<double> & demandsR, std::vector<unsigned> & sourcesR,
+                std::vector<unsigned> & targetsR, std::vector<double> & tStarts,
+                std::vector<double> & tLimits, std::vector<double> & speeds,
+                std::vector<double> & capacities, std::vector<unsigned> & sourcesK,
+                std::vector<unsigned> & targetsK, std::vector<double> & x,
+                std::vector<double> & y, std::vector<double> & tVisits);
+
+        /*******************************************************************************
+         * Verifies whether the specified buffer looks like a Li & Lim instance, that
+         * is, whether it starts with a number instead of a record type.
+         *
+         * @param begin the first character of the buffer.
+         * @param end   the character past the end of the buffer.
+         *
+         * @return true if the buffer looks like a Li & Lim instance; false otherwise.
+         *******************************************************************************/
+        static bool isLiLim(const char * begin, const char * end);
+};
@@ -0,0 +1,52 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const char * filename) : 
+    address(nullptr),
+    length(0) {
+    int fd = open(filename, O_RDONLY);
+
+    if(fd < 0) {
+        throw "File not found.";
+    }
+
+    struct stat status;
+
+    if(fstat(fd, &status) != 0) {
+        close(fd);
+        throw "File not mapped.";
+    }
+
+    this->length = status.st_size;
+
+    if(this->length > 0) {
+        void * address = mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        if(address == MAP_FAILED) {
+            close(fd);
+            throw "File not mapped.";
+        }
+
+        this->address = static_cast<char *>(address);
+    }
+
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if(this->address != nullptr) {
+        munmap(this->address, this->length);
+    }
+}
+
+char * MappedFile::getData() const {
+    return this->address;
+}
+
+std::size_t MappedFile::size() const {
+    return this->length;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+
+/*******************************************************************************************
+ * The MappedFile class represents a file mapped into memory. The pages are private to this
+ * process and are only read from the disk when they are first accessed.
+ *******************************************************************************************/
+class MappedFile {
+    private:
+        /************************************
+         * The address of the mapped file.
+         ************************************/
+        char * address;
+
+        /*******************************
+         * The size of the file.
+         *******************************/
+        std::size_t length;
+
+    public:
+        /*****************************************
+         * Maps the specified file into memory.
+         *
+         * @param filename the file to be mapped.
+         *****************************************/
+        MappedFile(const char * filename);
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile & operator = (const MappedFile &) = delete;
+
+        /******************************
+         * Unmaps this file.
+         ******************************/
+        ~MappedFile();
+
+        /*****************************************
+         * Returns the contents of this file.
+         *
+         * @return the contents of this file.
+         *****************************************/
+        char * getData() const;
+
+        /*********************************
+         * Returns the size of this file.
+         *
+         * @return the size of this file.
+         *********************************/
+        std::size_t size() const;
+};
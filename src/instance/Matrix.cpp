@@ -0,0 +1,134 @@
+#include "Matrix.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+std::shared_ptr<double> Matrix::allocate(unsigned capacity, unsigned stride, bool zero) {
+    std::size_t size = (std::size_t) capacity * stride * sizeof(double);
+    void * buffer = nullptr;
+
+    if(size == 0) {
+        return std::shared_ptr<double>();
+    }
+
+    if(posix_memalign(&buffer, CACHE_LINE_SIZE * sizeof(double), size) != 0) {
+        throw std::bad_alloc();
+    }
+
+    if(zero) {
+        memset(buffer, 0, size);
+    }
+
+    return std::shared_ptr<double>(static_cast<double *>(buffer), free);
+}
+
+Matrix::Matrix(unsigned numRows, unsigned numCols) : 
+    numRows(numRows),
+    numCols(numCols),
+    capacity(numRows),
+    owned(true) {
+    this->stride = ((numCols + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+    this->data = Matrix::allocate(this->capacity, this->stride, true);
+}
+
+Matrix::Matrix(unsigned numRows, unsigned numCols, unsigned stride,
+        const std::shared_ptr<double> & data) :
+    numRows(numRows),
+    numCols(numCols),
+    stride(stride),
+    capacity(numRows),
+    data(data),
+    owned(false) {}
+
+Matrix::Matrix() : Matrix::Matrix(0, 0) {}
+
+unsigned Matrix::getNumRows() const {
+    return this->numRows;
+}
+
+unsigned Matrix::getNumCols() const {
+    return this->numCols;
+}
+
+unsigned Matrix::getStride() const {
+    return this->stride;
+}
+
+unsigned Matrix::size() const {
+    return this->numRows;
+}
+
+const double * Matrix::getData() const {
+    return this->data.get();
+}
+
+void Matrix::set(unsigned u, unsigned v, double value) {
+    // copy the buffer before modifying it if it is shared with another matrix
+    if(this->data.use_count() > 1 || !this->owned) {
+        std::shared_ptr<double> data = Matrix::allocate(this->capacity, this->stride, true);
+
+        memcpy(data.get(), this->data.get(),
+                (std::size_t) this->numRows * this->stride * sizeof(double));
+
+        this->data = data;
+        this->owned = true;
+    }
+
+    this->data.get()[(std::size_t) u * this->stride + v] = value;
+}
+
+void Matrix::resize(unsigned numRows, unsigned numCols) {
+    if(numRows > this->capacity || numCols > this->stride || this->data.use_count() > 1 ||
+            !this->owned) {
+        // grow geometrically, so that the buffer is rarely reallocated
+        unsigned capacity = numRows <= this->capacity ? this->capacity :
+            std::max(numRows, this->capacity + this->capacity / 2);
+        unsigned stride = numCols <= this->stride ? this->stride :
+            std::max(numCols, this->stride + this->stride / 2);
+
+        stride = ((stride + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+
+        std::shared_ptr<double> data = Matrix::allocate(capacity, stride, false);
+        unsigned numColsKept = std::min(numCols, this->numCols);
+
+        // only the rows in use are written, so the pages of the spare rows stay untouched
+        for(unsigned u = 0; u < numRows; u++) {
+            double * row = data.get() + (std::size_t) u * stride;
+
+            if(u < this->numRows) {
+                memcpy(row, this->data.get() + (std::size_t) u * this->stride,
+                        numColsKept * sizeof(double));
+                memset(row + numColsKept, 0, (stride - numColsKept) * sizeof(double));
+            } else {
+                memset(row, 0, stride * sizeof(double));
+            }
+        }
+
+        this->capacity = capacity;
+        this->stride = stride;
+        this->data = data;
+        this->owned = true;
+    } else {
+        // the entries past the old bounds may hold values from before a shrink
+        for(unsigned u = 0; u < std::min(numRows, this->numRows); u++) {
+            if(numCols > this->numCols) {
+                memset(this->data.get() + (std::size_t) u * this->stride + this->numCols, 0,
+                        (numCols - this->numCols) * sizeof(double));
+            }
+        }
+
+        for(unsigned u = this->numRows; u < numRows; u++) {
+            memset(this->data.get() + (std::size_t) u * this->stride, 0,
+                    numCols * sizeof(double));
+        }
+    }
+
+    this->numRows = numRows;
+    this->numCols = numCols;
+}
+
+ArrayView<double> Matrix::operator [] (unsigned u) const {
+    return ArrayView<double>(this->data.get() + (std::size_t) u * this->stride, this->numCols);
+}
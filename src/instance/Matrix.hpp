@@ -0,0 +1,164 @@
+#pragma once
+
+#include "ArrayView.hpp"
+#include <memory>
+
+/*********************************************************************************************
+ * The Matrix class represents a dense matrix of doubles stored in a single row-major buffer.
+ * Each row is padded to a whole number of cache lines and the buffer is cache line aligned,
+ * so every row starts on its own cache line and can be streamed through memory.
+ * Copies share the same buffer, which is only duplicated when a shared copy is modified.
+ * The buffer keeps room for extra rows and columns, so a matrix grown one row and column
+ * at a time is only reallocated a logarithmic number of times.
+ *********************************************************************************************/
+class Matrix {
+    private:
+        /*******************************************
+         * The number of doubles in a cache line.
+         *******************************************/
+        static const unsigned CACHE_LINE_SIZE = 64 / sizeof(double);
+
+        /**************************
+         * The number of rows.
+         **************************/
+        unsigned numRows;
+
+        /**************************
+         * The number of columns.
+         **************************/
+        unsigned numCols;
+
+        /*******************************************************
+         * The distance, in doubles, between consecutive rows.
+         *******************************************************/
+        unsigned stride;
+
+        /**************************************************
+         * The number of rows the buffer has room for.
+         **************************************************/
+        unsigned capacity;
+
+        /***************************
+         * The row-major buffer.
+         ***************************/
+        std::shared_ptr<double> data;
+
+        /******************************************************************
+         * Flag indicating whether the buffer is owned by this matrix.
+         ******************************************************************/
+        bool owned;
+
+        /**********************************************************************
+         * Allocates a new buffer.
+         *
+         * @param capacity the number of rows the buffer has room for.
+         * @param stride   the distance, in doubles, between consecutive rows.
+         * @param zero     whether the buffer is to be zero-filled.
+         *
+         * @return the new buffer.
+         **********************************************************************/
+        static std::shared_ptr<double> allocate(unsigned capacity, unsigned stride, bool zero);
+
+    public:
+        /***********************************************
+         * Constructs a new zero-filled matrix.
+         *
+         * @param numRows the number of rows.
+         * @param numCols the number of columns.
+         ***********************************************/
+        Matrix(unsigned numRows, unsigned numCols);
+
+        /*********************************************************************************
+         * Constructs a new matrix over an existing row-major buffer, such as a buffer in
+         * a mapped file. The buffer is copied before it is first modified.
+         *
+         * @param numRows the number of rows.
+         * @param numCols the number of columns.
+         * @param stride  the distance, in doubles, between consecutive rows.
+         * @param data    the buffer.
+         *********************************************************************************/
+        Matrix(unsigned numRows, unsigned numCols, unsigned stride,
+                const std::shared_ptr<double> & data);
+
+        /*********************************
+         * Constructs a new empty matrix.
+         *********************************/
+        Matrix();
+
+        /******************************
+         * Returns the number of rows.
+         *
+         * @return the number of rows.
+         ******************************/
+        unsigned getNumRows() const;
+
+        /*********************************
+         * Returns the number of columns.
+         *
+         * @return the number of columns.
+         *********************************/
+        unsigned getNumCols() const;
+
+        /***************************************************************
+         * Returns the distance, in doubles, between consecutive rows.
+         *
+         * @return the distance, in doubles, between consecutive rows.
+         ***************************************************************/
+        unsigned getStride() const;
+
+        /******************************
+         * Returns the number of rows.
+         *
+         * @return the number of rows.
+         ******************************/
+        unsigned size() const;
+
+        /***************************************
+         * Returns the row-major buffer.
+         *
+         * @return the row-major buffer.
+         ***************************************/
+        const double * getData() const;
+
+        /**********************************************
+         * Returns the specified entry.
+         *
+         * @param u the row of the entry.
+         * @param v the column of the entry.
+         *
+         * @return the specified entry.
+         **********************************************/
+        double get(unsigned u, unsigned v) const;
+
+        /**************************************************
+         * Sets the specified entry.
+         *
+         * @param u     the row of the entry.
+         * @param v     the column of the entry.
+         * @param value the new value of the entry.
+         **************************************************/
+        void set(unsigned u, unsigned v, double value);
+
+        /************************************************************************************
+         * Changes the number of rows and columns, keeping the entries that remain and
+         * zero-filling the new ones. Growing the matrix by one row and one column takes
+         * time linear in the number of rows, amortized over the reallocations.
+         *
+         * @param numRows the new number of rows.
+         * @param numCols the new number of columns.
+         ************************************************************************************/
+        void resize(unsigned numRows, unsigned numCols);
+
+        /**************************************************
+         * Returns the specified row.
+         *
+         * @param u the row to be returned.
+         *
+         * @return the specified row.
+         **************************************************/
+        ArrayView<double> operator [] (unsigned u) const;
+};
+
+inline double Matrix::get(unsigned u, unsigned v) const {
+    return this->data.get()[(std::size_t) u * this->stride + v];
+}
@@ -0,0 +1,244 @@
+#include "SpatialIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+unsigned SpatialIndex::getCol(double x) const {
+    double col = floor((x - this->minX) / this->cellSize);
+
+    return col <= 0 ? 0 : std::min((double) this->numCols - 1, col);
+}
+
+unsigned SpatialIndex::getRow(double y) const {
+    double row = floor((y - this->minY) / this->cellSize);
+
+    return row <= 0 ? 0 : std::min((double) this->numRows - 1, row);
+}
+
+SpatialIndex::SpatialIndex(ArrayView<double> x, ArrayView<double> y,
+        ArrayView<unsigned> vertices) : SpatialIndex::SpatialIndex() {
+    if(vertices.empty()) {
+        return;
+    }
+
+    double maxX = -std::numeric_limits<double>::infinity();
+    double maxY = -std::numeric_limits<double>::infinity();
+
+    this->minX = std::numeric_limits<double>::infinity();
+    this->minY = std::numeric_limits<double>::infinity();
+
+    for(unsigned v : vertices) {
+        this->minX = std::min(this->minX, x[v]);
+        this->minY = std::min(this->minY, y[v]);
+        maxX = std::max(maxX, x[v]);
+        maxY = std::max(maxY, y[v]);
+    }
+
+    // square cells holding a few vertices each on average, with no more cells than vertices
+    double width = maxX - this->minX, height = maxY - this->minY;
+    double numCells = std::max(1.0, (double) vertices.size() / VERTICES_PER_CELL);
+
+    this->cellSize = std::max(sqrt(width * height / numCells), std::max(width, height) / numCells);
+
+    if(this->cellSize <= 0) {
+        this->cellSize = 1.0;
+    }
+
+    this->numCols = std::min(floor(width / this->cellSize), numCells) + 1;
+    this->numRows = std::min(floor(height / this->cellSize), numCells) + 1;
+    this->maxSize = 2 * vertices.size();
+
+    // sort the vertices by cell with a counting sort
+    std::vector<unsigned> cells(vertices.size());
+
+    this->cellStarts = std::vector<unsigned>(this->numCols * this->numRows + 1, 0);
+
+    for(unsigned i = 0; i < vertices.size(); i++) {
+        cells[i] = this->getRow(y[vertices[i]]) * this->numCols + this->getCol(x[vertices[i]]);
+        this->cellStarts[cells[i] + 1]++;
+    }
+
+    std::partial_sum(this->cellStarts.begin(), this->cellStarts.end(), this->cellStarts.begin());
+
+    std::vector<unsigned> positions(this->cellStarts.begin(), this->cellStarts.end() - 1);
+
+    this->vertices = std::vector<unsigned>(vertices.size());
+    this->x = std::vector<double>(vertices.size());
+    this->y = std::vector<double>(vertices.size());
+
+    for(unsigned i = 0; i < vertices.size(); i++) {
+        unsigned position = positions[cells[i]]++;
+
+        this->vertices[position] = vertices[i];
+        this->x[position] = x[vertices[i]];
+        this->y[position] = y[vertices[i]];
+    }
+}
+
+SpatialIndex::SpatialIndex(ArrayView<double> x, ArrayView<double> y) : SpatialIndex::SpatialIndex() {
+    std::vector<unsigned> vertices(x.size());
+
+    std::iota(vertices.begin(), vertices.end(), 0);
+
+    *this = SpatialIndex(x, y, vertices);
+}
+
+SpatialIndex::SpatialIndex() :
+    minX(0.0),
+    minY(0.0),
+    cellSize(1.0),
+    numCols(0),
+    numRows(0),
+    maxSize(0) {}
+
+unsigned SpatialIndex::size() const {
+    return this->vertices.size();
+}
+
+void SpatialIndex::insert(unsigned v, double x, double y) {
+    if(this->vertices.size() >= this->maxSize) {
+        unsigned numVertices = v + 1;
+
+        for(unsigned u : this->vertices) {
+            numVertices = std::max(numVertices, u + 1);
+        }
+
+        // the coordinates of the indexed vertices are kept cell by cell, not by vertex
+        std::vector<double> xV(numVertices, 0.0), yV(numVertices, 0.0);
+        std::vector<unsigned> vertices = this->vertices;
+
+        for(unsigned i = 0; i < this->vertices.size(); i++) {
+            xV[this->vertices[i]] = this->x[i];
+            yV[this->vertices[i]] = this->y[i];
+        }
+
+        xV[v] = x;
+        yV[v] = y;
+        vertices.push_back(v);
+
+        *this = SpatialIndex(xV, yV, vertices);
+        return;
+    }
+
+    // a vertex outside the grid is clamped into a boundary cell, which the queries treat
+    // as extending past the grid
+    unsigned cell = this->getRow(y) * this->numCols + this->getCol(x);
+    unsigned position = this->cellStarts[cell + 1];
+
+    this->vertices.insert(this->vertices.begin() + position, v);
+    this->x.insert(this->x.begin() + position, x);
+    this->y.insert(this->y.begin() + position, y);
+
+    for(unsigned c = cell + 1; c < this->cellStarts.size(); c++) {
+        this->cellStarts[c]++;
+    }
+}
+
+void SpatialIndex::getNearest(double x, double y, unsigned k,
+        std::vector<unsigned> & nearest) const {
+    nearest.clear();
+
+    if(k == 0 || this->vertices.empty()) {
+        return;
+    }
+
+    // max-heap of the closest vertices found so far, by squared distance and then by vertex
+    std::vector<std::pair<double, unsigned>> heap;
+    const long col = this->getCol(x), row = this->getRow(y);
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    heap.reserve(std::min((std::size_t) k, this->vertices.size()));
+
+    auto visit = [&](long c, long r) {
+        unsigned cell = r * this->numCols + c;
+
+        for(unsigned i = this->cellStarts[cell]; i < this->cellStarts[cell + 1]; i++) {
+            double dx = x - this->x[i], dy = y - this->y[i];
+            std::pair<double, unsigned> candidate(dx*dx + dy*dy, this->vertices[i]);
+
+            if(heap.size() < k) {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end());
+            } else if(candidate < heap.front()) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+    };
+
+    // visit the rings of cells around the point until no unvisited cell can be closer
+    for(long ring = 0; ; ring++) {
+        long c0 = col - ring, c1 = col + ring, r0 = row - ring, r1 = row + ring;
+
+        for(long r = std::max(r0, 0l); r <= std::min(r1, (long) this->numRows - 1); r++) {
+            if(r == r0 || r == r1) {
+                for(long c = std::max(c0, 0l); c <= std::min(c1, (long) this->numCols - 1); c++) {
+                    visit(c, r);
+                }
+            } else {
+                if(c0 >= 0) {
+                    visit(c0, r);
+                }
+
+                if(c1 < (long) this->numCols) {
+                    visit(c1, r);
+                }
+            }
+        }
+
+        if(c0 <= 0 && r0 <= 0 && c1 >= (long) this->numCols - 1 &&
+                r1 >= (long) this->numRows - 1) {
+            break;
+        }
+
+        if(heap.size() == k) {
+            double bound = std::min(
+                    std::min(c0 <= 0 ? infinity : x - (this->minX + c0 * this->cellSize),
+                        c1 >= (long) this->numCols - 1 ? infinity :
+                        this->minX + (c1 + 1) * this->cellSize - x),
+                    std::min(r0 <= 0 ? infinity : y - (this->minY + r0 * this->cellSize),
+                        r1 >= (long) this->numRows - 1 ? infinity :
+                        this->minY + (r1 + 1) * this->cellSize - y));
+
+            if(bound > 0 && bound * bound > heap.front().first) {
+                break;
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+
+    for(const auto & candidate : heap) {
+        nearest.push_back(candidate.second);
+    }
+}
+
+void SpatialIndex::getWithinRadius(double x, double y, double radius,
+        std::vector<unsigned> & vertices) const {
+    vertices.clear();
+
+    if(radius < 0 || this->vertices.empty()) {
+        return;
+    }
+
+    unsigned c0 = this->getCol(x - radius), c1 = this->getCol(x + radius);
+    unsigned r0 = this->getRow(y - radius), r1 = this->getRow(y + radius);
+
+    for(unsigned r = r0; r <= r1; r++) {
+        for(unsigned c = c0; c <= c1; c++) {
+            unsigned cell = r * this->numCols + c;
+
+            for(unsigned i = this->cellStarts[cell]; i < this->cellStarts[cell + 1]; i++) {
+                double dx = x - this->x[i], dy = y - this->y[i];
+
+                if(dx*dx + dy*dy <= radius * radius) {
+                    vertices.push_back(this->vertices[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "ArrayView.hpp"
+#include <vector>
+
+/**********************************************************************************************
+ * The SpatialIndex class represents a uniform grid over the coordinates of a set of vertices,
+ * answering proximity queries without scanning every vertex. The vertices are stored cell by
+ * cell, together with their coordinates, so each visited cell is read contiguously.
+ **********************************************************************************************/
+class SpatialIndex {
+    private:
+        /********************************************
+         * The average number of vertices per cell.
+         ********************************************/
+        static const unsigned VERTICES_PER_CELL = 2;
+
+        /*****************************************
+         * The smallest x coordinate of the grid.
+         *****************************************/
+        double minX;
+
+        /*****************************************
+         * The smallest y coordinate of the grid.
+         *****************************************/
+        double minY;
+
+        /*******************************
+         * The side length of a cell.
+         *******************************/
+        double cellSize;
+
+        /*******************************
+         * The number of columns.
+         *******************************/
+        unsigned numCols;
+
+        /*******************************
+         * The number of rows.
+         *******************************/
+        unsigned numRows;
+
+        /*******************************************************************************
+         * The number of indexed vertices beyond which an insertion rebuilds the grid.
+         *******************************************************************************/
+        unsigned maxSize;
+
+        /*******************************************************************************
+         * The position of the first vertex of each cell, followed by the number of
+         * indexed vertices.
+         *******************************************************************************/
+        std::vector<unsigned> cellStarts;
+
+        /****************************************
+         * The indexed vertices, cell by cell.
+         ****************************************/
+        std::vector<unsigned> vertices;
+
+        /***********************************************
+         * The x coordinate of each indexed vertex.
+         ***********************************************/
+        std::vector<double> x;
+
+        /***********************************************
+         * The y coordinate of each indexed vertex.
+         ***********************************************/
+        std::vector<double> y;
+
+        /*************************************************************
+         * Returns the column containing the specified x coordinate.
+         *
+         * @param x the x coordinate.
+         *
+         * @return the column containing the specified x coordinate.
+         *************************************************************/
+        unsigned getCol(double x) const;
+
+        /**********************************************************
+         * Returns the row containing the specified y coordinate.
+         *
+         * @param y the y coordinate.
+         *
+         * @return the row containing the specified y coordinate.
+         **********************************************************/
+        unsigned getRow(double y) const;
+
+    public:
+        /***********************************************************************
+         * Constructs a new index over the specified vertices.
+         *
+         * @param x        the x coordinate of each vertex.
+         * @param y        the y coordinate of each vertex.
+         * @param vertices the vertices to be indexed.
+         ***********************************************************************/
+        SpatialIndex(ArrayView<double> x, ArrayView<double> y, ArrayView<unsigned> vertices);
+
+        /***************************************************
+         * Constructs a new index over every vertex.
+         *
+         * @param x the x coordinate of each vertex.
+         * @param y the y coordinate of each vertex.
+         ***************************************************/
+        SpatialIndex(ArrayView<double> x, ArrayView<double> y);
+
+        /*********************************
+         * Constructs a new empty index.
+         *********************************/
+        SpatialIndex();
+
+        /******************************************
+         * Returns the number of indexed vertices.
+         *
+         * @return the number of indexed vertices.
+         ******************************************/
+        unsigned size() const;
+
+        /**************************************************************************************
+         * Inserts the specified vertex into its cell, shifting the vertices of the following
+         * cells. The grid is rebuilt once it holds twice the vertices it was built for, so
+         * that its cells keep a few vertices each. A vertex outside the grid joins the
+         * closest cell on its border.
+         *
+         * @param v the vertex to be inserted.
+         * @param x the x coordinate of the vertex.
+         * @param y the y coordinate of the vertex.
+         **************************************************************************************/
+        void insert(unsigned v, double x, double y);
+
+        /**************************************************************************************
+         * Computes the indexed vertices closest to the specified point, in non decreasing
+         * order of distance. Fewer vertices are returned when fewer are indexed.
+         *
+         * @param x       the x coordinate of the point.
+         * @param y       the y coordinate of the point.
+         * @param k       the number of vertices to be returned.
+         * @param nearest the vector receiving the closest vertices.
+         **************************************************************************************/
+        void getNearest(double x, double y, unsigned k, std::vector<unsigned> & nearest) const;
+
+        /**************************************************************************************
+         * Computes the indexed vertices within the specified distance of the specified point,
+         * in no particular order.
+         *
+         * @param x        the x coordinate of the point.
+         * @param y        the y coordinate of the point.
+         * @param radius   the maximum distance.
+         * @param vertices the vector receiving the vertices within the distance.
+         **************************************************************************************/
+        void getWithinRadius(double x, double y, double radius,
+                std::vector<unsigned> & vertices) const;
+};
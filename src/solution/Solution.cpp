@@ -1,161 +1,273 @@
 #include "Solution.hpp"
+#include "../instance/CompressedStream.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cfloat>
-#include <fstream>
 #include <limits>
 
+/*****************************************************************************
+ * Mixes the bits of the specified value with the finalizer of splitmix64, so
+ * that close values give unrelated results.
+ *
+ * @param value the value to be mixed.
+ *
+ * @return the mixed value.
+ *****************************************************************************/
+static uint64_t mix(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+
+    return value ^ (value >> 31);
+}
+
 void Solution::init() {
-    this->tTravels = std::vector<double>(this->instance.getNumVehicles(), 0.0);
-    this->tFulfills = std::vector<double>(this->instance.getNumRequests(), 0.0);
+    // only the constructor from the decision variables sets them before the initialization
+    this->hasGivenDecisionVariables = this->decisionVariables != nullptr;
+    this->tTravels = std::vector<double>(this->instance->getNumVehicles(), 0.0);
+    this->tFulfills = std::vector<double>(this->instance->getNumRequests(), 0.0);
     this->totalProfit = 0.0;
     this->sumTFulfill = 0.0;
-    this->loads = std::vector<std::vector<double>>(this->instance.getNumVehicles());
-    this->times = std::vector<std::vector<double>>(this->instance.getNumVehicles());
-    this->vehiclesR = std::vector<unsigned>(this->instance.getNumRequests(),
-            this->instance.getNumVehicles());
-    this->vehiclesV = std::vector<unsigned>(this->instance.getNumVertices(),
-            this->instance.getNumVehicles());
-    this->vehiclesE = std::vector<std::vector<unsigned>>(this->instance.getNumVertices());
-    this->requestsK = std::vector<std::unordered_set<unsigned>>(this->instance.getNumVehicles());
-    this->indexesKV = std::vector<std::vector<unsigned>>(this->instance.getNumVehicles());
-
-    for(unsigned int v = 0; v < this->instance.getNumVertices(); v++) {
-        this->vehiclesE[v] = std::vector<unsigned>(this->instance.getNumVertices(),
-                this->instance.getNumVehicles());
-    }
-
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    this->loads = std::vector<std::vector<double>>(this->instance->getNumVehicles());
+    this->times = std::vector<std::vector<double>>(this->instance->getNumVehicles());
+    this->vehiclesR = std::vector<unsigned>(this->instance->getNumRequests(),
+            this->instance->getNumVehicles());
+    this->vehiclesV = std::vector<unsigned>(this->instance->getNumVertices(),
+            this->instance->getNumVehicles());
+    this->successors = std::vector<unsigned>(this->instance->getNumVertices(),
+            this->instance->getNumVertices());
+    this->positions = std::vector<unsigned>(this->instance->getNumVertices(), 0);
+    this->hash = 0;
+    this->requestsK = std::vector<std::unordered_set<unsigned>>(this->instance->getNumVehicles());
+
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         this->loads[k] = std::vector<double>(this->paths[k].size(), 0.0);
         this->times[k] = std::vector<double>(this->paths[k].size(), 0.0);
-        this->indexesKV[k] = std::vector<unsigned>(this->instance.getNumVertices(),
-                this->paths[k].size());
 
         for(unsigned i = 0; i < this->paths[k].size(); i++) {
             unsigned v = this->paths[k][i];
-            unsigned r = this->instance.getRequestV(v);
+            const VertexRecord & vertex = this->instance->getVertex(v);
+            unsigned r = vertex.request;
 
             if(i == 0) {
-                this->tTravels[k] = this->instance.getTVisit(v);
-                this->loads[k][i] = this->instance.getDemandV(v);
-                this->times[k][i] = this->instance.getTVisit(v);
+                this->tTravels[k] = vertex.tVisit;
+                this->loads[k][i] = vertex.demand;
+                this->times[k][i] = vertex.tVisit;
+                this->hash ^= getArcKey(k, this->instance->getNumVertices(), v);
             } else {
                 unsigned u = this->paths[k][i - 1];
 
-                this->tTravels[k] += this->instance.getLength(u, v)/this->instance.getSpeed(k) +
-                    this->instance.getTVisit(v);
-                this->loads[k][i] = this->loads[k][i - 1] +
-                    this->instance.getDemandV(v);
-                this->times[k][i] = this->times[k][i - 1] + this->instance.getLength(u,
-                        v)/this->instance.getSpeed(k) + this->instance.getTVisit(v);
-                this->vehiclesE[u][v] = k;
+                double tTravel = this->instance->getTravelTime(u, v, k);
+
+                this->tTravels[k] += tTravel + vertex.tVisit;
+                this->loads[k][i] = this->loads[k][i - 1] + vertex.demand;
+                this->times[k][i] = this->times[k][i - 1] + tTravel + vertex.tVisit;
+                this->successors[u] = v;
+                this->hash ^= getArcKey(k, u, v);
             }
 
-            if(r < this->instance.getNumRequests() && this->instance.isATarget(v)) {
-                this->tFulfills[r] = this->instance.getTStart(k) + this->times[k][i] -
-                    this->instance.getTCreate(r);
+            if(vertex.role == VertexRole::REQUEST_TARGET) {
+                this->tFulfills[r] = this->instance->getTStart(k) + this->times[k][i] -
+                    this->instance->getTCreate(r);
 
-                this->totalProfit += this->instance.getProfit(r);
+                this->totalProfit += this->instance->getProfit(r);
                 this->sumTFulfill += this->tFulfills[r];
                 this->vehiclesR[r] = k;
                 this->requestsK[k].insert(r);
             }
 
             this->vehiclesV[v] = k;
-            this->indexesKV[k][v] = i;
+            this->positions[v] = i;
         }
     }
-}
 
-void Solution::computeDecisionVariables() {
-    this->x = std::vector<std::vector<std::vector<bool>>>(this->instance.getNumVertices(),
-            std::vector<std::vector<bool>>(this->instance.getNumVertices(),
-                std::vector<bool>(this->instance.getNumVehicles(), false)));
-    this->y = std::vector<std::vector<bool>>(this->instance.getNumRequests(),
-            std::vector<bool>(this->instance.getNumVehicles(), false));
-    this->t = std::vector<std::vector<double>>(this->instance.getNumVertices(),
-            std::vector<double>(this->instance.getNumVehicles(), 0.0));
-    this->l = std::vector<std::vector<double>>(this->instance.getNumVertices(),
-            std::vector<double>(this->instance.getNumVehicles(), 0.0));
+    this->slacks = std::vector<double>(this->instance->getNumVehicles(), 0.0);
+    this->maxLoads = std::vector<std::vector<std::vector<double>>>(
+            this->instance->getNumVehicles());
+    this->numTargets = std::vector<std::vector<unsigned>>(this->instance->getNumVehicles());
+
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        unsigned size = this->paths[k].size();
+
+        this->slacks[k] = this->instance->getTLimit(k) - this->tTravels[k];
+        this->maxLoads[k].push_back(this->loads[k]);
+        this->numTargets[k] = std::vector<unsigned>(size + 1, 0);
+
+        for(unsigned p = 1; (1u << p) <= size; p++) {
+            const std::vector<double> & previous = this->maxLoads[k][p - 1];
+            std::vector<double> current(size - (1u << p) + 1);
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+            for(unsigned i = 0; i < current.size(); i++) {
+                current[i] = std::max(previous[i], previous[i + (1u << (p - 1))]);
+            }
+
+            this->maxLoads[k].push_back(current);
+        }
+
+        for(unsigned i = size; i > 0; i--) {
+            this->numTargets[k][i - 1] = this->numTargets[k][i] +
+                (this->instance->getVertex(this->paths[k][i - 1]).role ==
+                 VertexRole::REQUEST_TARGET ? 1 : 0);
+        }
+    }
+}
+
+std::shared_ptr<const DecisionVariables> Solution::computeDecisionVariables() const {
+    std::shared_ptr<DecisionVariables> variables = std::make_shared<DecisionVariables>();
+    std::vector<std::vector<std::vector<bool>>> & x = variables->x;
+    std::vector<std::vector<bool>> & y = variables->y;
+    std::vector<std::vector<double>> & t = variables->t;
+    std::vector<std::vector<double>> & l = variables->l;
+
+    x = std::vector<std::vector<std::vector<bool>>>(this->instance->getNumVertices(),
+            std::vector<std::vector<bool>>(this->instance->getNumVertices(),
+                std::vector<bool>(this->instance->getNumVehicles(), false)));
+    y = std::vector<std::vector<bool>>(this->instance->getNumRequests(),
+            std::vector<bool>(this->instance->getNumVehicles(), false));
+    t = std::vector<std::vector<double>>(this->instance->getNumVertices(),
+            std::vector<double>(this->instance->getNumVehicles(), 0.0));
+    l = std::vector<std::vector<double>>(this->instance->getNumVertices(),
+            std::vector<double>(this->instance->getNumVehicles(), 0.0));
+
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         for(unsigned i = 0; i < this->paths[k].size(); i++) {
             unsigned v = this->paths[k][i];
-            unsigned r = this->instance.getRequestV(v);
+            const VertexRecord & vertex = this->instance->getVertex(v);
+            unsigned r = vertex.request;
 
             if(i == 0) {
-                this->t[v][k] = this->instance.getTStart(k);
-                this->l[v][k] = 0.0;
+                t[v][k] = this->instance->getTStart(k);
+                l[v][k] = 0.0;
             } else {
                 unsigned u = this->paths[k][i - 1];
 
-                this->x[u][v][k] = true;
+                x[u][v][k] = true;
 
-                if(i < this->paths[k].size() - 1 && this->instance.isATarget(v) 
-                        && r < this->instance.getNumRequests()) {
-                    this->y[r][k] = true;
+                if(i < this->paths[k].size() - 1 && vertex.role == VertexRole::REQUEST_TARGET) {
+                    y[r][k] = true;
                 }
 
-                this->t[v][k] = this->t[u][k] + this->instance.getTVisit(u) +
-                    this->instance.getLength(u, v)/this->instance.getSpeed(k);
+                t[v][k] = t[u][k] + this->instance->getTVisit(u) +
+                    this->instance->getTravelTime(u, v, k);
 
-                if(this->instance.isASource(v) && r < this->instance.getNumRequests() 
-                        && this->t[v][k] < this->instance.getTCreate(r)) {
-                    this->t[v][k] = this->instance.getTCreate(r);
+                if(vertex.role == VertexRole::REQUEST_SOURCE &&
+                        t[v][k] < this->instance->getTCreate(r)) {
+                    t[v][k] = this->instance->getTCreate(r);
                 }
 
-                this->l[v][k] = this->l[u][k] + this->instance.getDemandV(v);
+                l[v][k] = l[u][k] + vertex.demand;
             }
         }
     }
+
+    return variables;
+}
+
+const DecisionVariables & Solution::getDecisionVariables() const {
+    std::shared_ptr<const DecisionVariables> variables =
+        std::atomic_load(&this->decisionVariables);
+
+    if(!variables) {
+        std::shared_ptr<const DecisionVariables> expected;
+
+        variables = this->computeDecisionVariables();
+
+        // another thread may have derived them first, in which case its values are kept
+        if(!std::atomic_compare_exchange_strong(&this->decisionVariables, &expected,
+                    variables)) {
+            variables = expected;
+        }
+    }
+
+    return *variables;
+}
+
+const DenseIndexes & Solution::getDenseIndexes() const {
+    std::shared_ptr<const DenseIndexes> indexes = std::atomic_load(&this->denseIndexes);
+
+    if(!indexes) {
+        std::shared_ptr<DenseIndexes> newIndexes = std::make_shared<DenseIndexes>();
+        std::shared_ptr<const DenseIndexes> expected;
+        unsigned numVertices = this->instance->getNumVertices();
+        unsigned numVehicles = this->instance->getNumVehicles();
+
+        newIndexes->vehiclesE = std::vector<std::vector<unsigned>>(numVertices,
+                std::vector<unsigned>(numVertices, numVehicles));
+        newIndexes->indexesKV = std::vector<std::vector<unsigned>>(numVehicles);
+
+        for(unsigned k = 0; k < numVehicles; k++) {
+            newIndexes->indexesKV[k] = std::vector<unsigned>(numVertices, this->paths[k].size());
+        }
+
+        for(unsigned v = 0; v < numVertices; v++) {
+            unsigned k = this->vehiclesV[v];
+
+            if(k < numVehicles) {
+                newIndexes->indexesKV[k][v] = this->positions[v];
+
+                if(this->successors[v] < numVertices) {
+                    newIndexes->vehiclesE[v][this->successors[v]] = k;
+                }
+            }
+        }
+
+        indexes = newIndexes;
+
+        // another thread may have derived them first, in which case its values are kept
+        if(!std::atomic_compare_exchange_strong(&this->denseIndexes, &expected, indexes)) {
+            indexes = expected;
+        }
+    }
+
+    return *indexes;
 }
 
 void Solution::init(std::istream & is) {
-    this->paths = std::vector<std::vector<unsigned>>(this->instance.getNumVehicles());
+    this->paths = std::vector<std::vector<unsigned>>(this->instance->getNumVehicles());
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         unsigned size;
 
         is >> size;
 
-        this->paths[k] = std::vector<unsigned>(size, this->instance.getNumVertices());
+        this->paths[k] = std::vector<unsigned>(size, this->instance->getNumVertices());
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         for(unsigned i = 0; i < this->paths[k].size(); i++) {
             is >> paths[k][i];
         }
     }
 
-    this->computeDecisionVariables();
-
     this->init();
 }
 
-Solution::Solution(const Instance & instance, const std::vector<std::vector<unsigned>> & paths) : 
+Solution::Solution(const std::shared_ptr<const Instance> & instance,
+        const std::vector<std::vector<unsigned>> & paths) : 
     instance(instance), 
     paths(paths) {
-    this->computeDecisionVariables();
     this->init();
 }
 
-Solution::Solution(const Instance & instance, 
+Solution::Solution(const Instance & instance, const std::vector<std::vector<unsigned>> & paths) :
+    Solution::Solution(std::make_shared<const Instance>(instance), paths) {}
+
+Solution::Solution(const std::shared_ptr<const Instance> & instance, 
         const std::vector<std::vector<std::vector<bool>>> & x, 
         const std::vector<std::vector<bool>> & y, const std::vector<std::vector<double>> & t, 
         const std::vector<std::vector<double>> & l) : 
     instance(instance), 
-    x(x), 
-    y(y), 
-    t(t), 
-    l(l) {
-    this->paths = std::vector<std::vector<unsigned>>(this->instance.getNumVehicles());
-
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        this->paths[k].push_back(this->instance.getSourceK(k));
-
-        while(this->paths[k].back() != this->instance.getTargetK(k)) {
-            for(unsigned v = 0; v < this->instance.getNumVertices(); v++) {
-                if(this->x[this->paths[k].back()][v][k]) {
+    decisionVariables(std::make_shared<const DecisionVariables>(DecisionVariables{x, y, t, l})) {
+    this->paths = std::vector<std::vector<unsigned>>(this->instance->getNumVehicles());
+
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        this->paths[k].push_back(this->instance->getSourceK(k));
+
+        while(this->paths[k].back() != this->instance->getTargetK(k)) {
+            for(unsigned v = 0; v < this->instance->getNumVertices(); v++) {
+                if(x[this->paths[k].back()][v][k]) {
                     this->paths[k].push_back(v);
                     break;
                 }
@@ -166,82 +278,153 @@ Solution::Solution(const Instance & instance,
     this->init();
 }
 
-Solution::Solution(const Instance & instance, std::istream & is) : 
+Solution::Solution(const Instance & instance,
+        const std::vector<std::vector<std::vector<bool>>> & x,
+        const std::vector<std::vector<bool>> & y, const std::vector<std::vector<double>> & t,
+        const std::vector<std::vector<double>> & l) :
+    Solution::Solution(std::make_shared<const Instance>(instance), x, y, t, l) {}
+
+Solution::Solution(const std::shared_ptr<const Instance> & instance, std::istream & is) : 
     instance(instance) {
     this->init(is);
 }
 
-Solution::Solution(const Instance & instance, const char * filename) : 
-    instance(instance) {
-    std::ifstream ifs;
+Solution::Solution(const Instance & instance, std::istream & is) :
+    Solution::Solution(std::make_shared<const Instance>(instance), is) {}
 
-    ifs.open(filename);
+Solution::Solution(const std::shared_ptr<const Instance> & instance, const char * filename) : 
+    instance(instance) {
+    CompressedInputStream is(filename);
 
-    if(ifs.is_open()) {
-        this->init(ifs);
-    } else {
-        throw "File not found.";
-    }
+    this->init(is);
 }
 
-Solution::Solution(const Instance & instance, const std::string & filename) :
+Solution::Solution(const Instance & instance, const char * filename) :
+    Solution::Solution(std::make_shared<const Instance>(instance), filename) {}
+
+Solution::Solution(const std::shared_ptr<const Instance> & instance,
+        const std::string & filename) :
     Solution::Solution(instance, filename.c_str()) {}
 
-Solution::Solution(const Instance & instance) : instance(instance) {
-    this->paths = std::vector<std::vector<unsigned>>(this->instance.getNumVehicles());
+Solution::Solution(const Instance & instance, const std::string & filename) :
+    Solution::Solution(std::make_shared<const Instance>(instance), filename.c_str()) {}
 
-    this->computeDecisionVariables();
+Solution::Solution(const std::shared_ptr<const Instance> & instance) : instance(instance) {
+    this->paths = std::vector<std::vector<unsigned>>(this->instance->getNumVehicles());
 
     this->init();
 }
 
+Solution::Solution(const Instance & instance) :
+    Solution::Solution(std::make_shared<const Instance>(instance)) {}
+
 Solution::Solution() : Solution::Solution(Instance()) {}
 
-Instance Solution::getInstance() const {
+// the values derived on first access may be published by another thread while copying
+Solution::Solution(const Solution & solution) :
+    instance(solution.instance),
+    paths(solution.paths),
+    decisionVariables(std::atomic_load(&solution.decisionVariables)),
+    hasGivenDecisionVariables(solution.hasGivenDecisionVariables),
+    tTravels(solution.tTravels),
+    tFulfills(solution.tFulfills),
+    totalProfit(solution.totalProfit),
+    sumTFulfill(solution.sumTFulfill),
+    loads(solution.loads),
+    times(solution.times),
+    vehiclesR(solution.vehiclesR),
+    vehiclesV(solution.vehiclesV),
+    successors(solution.successors),
+    positions(solution.positions),
+    requestsK(solution.requestsK),
+    denseIndexes(std::atomic_load(&solution.denseIndexes)),
+    slacks(solution.slacks),
+    maxLoads(solution.maxLoads),
+    numTargets(solution.numTargets),
+    hash(solution.hash) {}
+
+Solution::Solution(Solution && solution) = default;
+
+Solution & Solution::operator = (const Solution & solution) {
+    if(this != &solution) {
+        this->instance = solution.instance;
+        this->paths = solution.paths;
+        this->hasGivenDecisionVariables = solution.hasGivenDecisionVariables;
+        this->tTravels = solution.tTravels;
+        this->tFulfills = solution.tFulfills;
+        this->totalProfit = solution.totalProfit;
+        this->sumTFulfill = solution.sumTFulfill;
+        this->loads = solution.loads;
+        this->times = solution.times;
+        this->vehiclesR = solution.vehiclesR;
+        this->vehiclesV = solution.vehiclesV;
+        this->successors = solution.successors;
+        this->positions = solution.positions;
+        this->requestsK = solution.requestsK;
+        this->slacks = solution.slacks;
+        this->maxLoads = solution.maxLoads;
+        this->numTargets = solution.numTargets;
+        this->hash = solution.hash;
+
+        std::atomic_store(&this->decisionVariables,
+                std::atomic_load(&solution.decisionVariables));
+        std::atomic_store(&this->denseIndexes, std::atomic_load(&solution.denseIndexes));
+    }
+
+    return *this;
+}
+
+Solution & Solution::operator = (Solution && solution) = default;
+
+const Instance & Solution::getInstance() const {
+    return *this->instance;
+}
+
+const std::shared_ptr<const Instance> & Solution::getInstancePtr() const {
     return this->instance;
 }
 
-std::vector<std::vector<unsigned>> Solution::getPaths() const {
+const std::vector<std::vector<unsigned>> & Solution::getPaths() const {
     return this->paths;
 }
 
-std::vector<unsigned> Solution::getPath(unsigned k) const {
+const std::vector<unsigned> & Solution::getPath(unsigned k) const {
     return this->paths[k];
 }
 
-std::vector<std::vector<std::vector<bool>>> Solution::getX() const {
-    return this->x;
+const std::vector<std::vector<std::vector<bool>>> & Solution::getX() const {
+    return this->getDecisionVariables().x;
 }
 
 bool Solution::getX(unsigned i, unsigned j, unsigned k) const {
-    return this->x[i][j][k];
+    return this->getDecisionVariables().x[i][j][k];
 }
 
-std::vector<std::vector<bool>> Solution::getY() const {
-    return this->y;
+const std::vector<std::vector<bool>> & Solution::getY() const {
+    return this->getDecisionVariables().y;
 }
 
 bool Solution::getY(unsigned r, unsigned k) const {
-    return this->y[r][k];
+    return this->getDecisionVariables().y[r][k];
 }
 
-std::vector<std::vector<double>> Solution::getT() const {
-    return this->t;
+const std::vector<std::vector<double>> & Solution::getT() const {
+    return this->getDecisionVariables().t;
 }
 
 double Solution::getT(unsigned i, unsigned k) const {
-    return this->t[i][k];
+    return this->getDecisionVariables().t[i][k];
 }
 
-std::vector<std::vector<double>> Solution::getL() const {
-    return this->l;
+const std::vector<std::vector<double>> & Solution::getL() const {
+    return this->getDecisionVariables().l;
 }
 
 double Solution::getL(unsigned i, unsigned k) const {
-    return this->l[i][k];
+    return this->getDecisionVariables().l[i][k];
 }
 
-std::vector<double> Solution::getTTravels() const {
+const std::vector<double> & Solution::getTTravels() const {
     return this->tTravels;
 }
 
@@ -249,7 +432,7 @@ double Solution::getTTravel(unsigned k) const {
     return this->tTravels[k];
 }
 
-std::vector<double> Solution::getTFulfills() const {
+const std::vector<double> & Solution::getTFulfills() const {
     return this->tFulfills;
 }
 
@@ -265,7 +448,7 @@ double Solution::getSumTFulfill() const {
     return this->sumTFulfill;
 }
 
-std::vector<std::vector<double>> Solution::getLoads() const {
+const std::vector<std::vector<double>> & Solution::getLoads() const {
     return this->loads;
 }
 
@@ -273,7 +456,7 @@ double Solution::getLoad(unsigned k, unsigned i) const {
     return this->loads[k][i];
 }
 
-std::vector<std::vector<double>> Solution::getTimes() const {
+const std::vector<std::vector<double>> & Solution::getTimes() const {
     return this->times;
 }
 
@@ -281,7 +464,7 @@ double Solution::getTime(unsigned k, unsigned i) const {
     return this->times[k][i];
 }
 
-std::vector<unsigned> Solution::getVehiclesR() const {
+const std::vector<unsigned> & Solution::getVehiclesR() const {
     return this->vehiclesR;
 }
 
@@ -289,7 +472,7 @@ unsigned Solution::getVehicleR(unsigned r) const {
     return this->vehiclesR[r];
 }
 
-std::vector<unsigned> Solution::getVehiclesV() const {
+const std::vector<unsigned> & Solution::getVehiclesV() const {
     return this->vehiclesV;
 }
 
@@ -297,58 +480,167 @@ unsigned Solution::getVehicleV(unsigned v) const {
     return this->vehiclesV[v];
 }
 
-std::vector<std::vector<unsigned>> Solution::getVehiclesE() const {
-    return this->vehiclesE;
+const std::vector<unsigned> & Solution::getSuccessors() const {
+    return this->successors;
+}
+
+unsigned Solution::getSuccessor(unsigned v) const {
+    return this->successors[v];
+}
+
+const std::vector<unsigned> & Solution::getPositions() const {
+    return this->positions;
+}
+
+unsigned Solution::getPosition(unsigned v) const {
+    return this->positions[v];
+}
+
+const std::vector<std::vector<unsigned>> & Solution::getVehiclesE() const {
+    return this->getDenseIndexes().vehiclesE;
 }
 
 unsigned Solution::getVehicleE(unsigned u, unsigned v) const {
-    return this->vehiclesE[u][v];
+    unsigned k = this->vehiclesV[u];
+
+    return k < this->instance->getNumVehicles() && this->successors[u] == v ? k :
+        this->instance->getNumVehicles();
 }
 
-std::vector<std::unordered_set<unsigned>> Solution::getRequestsK() const {
+const std::vector<std::unordered_set<unsigned>> & Solution::getRequestsK() const {
     return this->requestsK;
 }
 
-std::unordered_set<unsigned> Solution::getRequestsK(unsigned k) const {
+const std::unordered_set<unsigned> & Solution::getRequestsK(unsigned k) const {
     return this->requestsK[k];
 }
 
-std::vector<std::vector<unsigned>> Solution::getIndexesKV() const {
-    return this->indexesKV;
+const std::vector<std::vector<unsigned>> & Solution::getIndexesKV() const {
+    return this->getDenseIndexes().indexesKV;
 }
 
 unsigned Solution::getIndexKV(unsigned k, unsigned v) const {
-    return this->indexesKV[k][v];
+    return this->vehiclesV[v] == k ? this->positions[v] : this->paths[k].size();
+}
+
+const std::vector<double> & Solution::getSlacks() const {
+    return this->slacks;
+}
+
+double Solution::getSlack(unsigned k) const {
+    return this->slacks[k];
+}
+
+double Solution::getMaxLoad(unsigned k, unsigned i, unsigned j) const {
+    unsigned p = 0;
+
+    while((2u << p) <= j - i + 1) {
+        p++;
+    }
+
+    return std::max(this->maxLoads[k][p][i], this->maxLoads[k][p][j + 1 - (1u << p)]);
+}
+
+uint64_t Solution::getHash() const {
+    return this->hash;
+}
+
+uint64_t Solution::getArcKey(unsigned k, unsigned u, unsigned v) {
+    return mix(mix(mix(k) ^ u) ^ v);
+}
+
+Insertion Solution::evaluateInsertion(unsigned r, unsigned k, unsigned i, unsigned j) const {
+    Insertion insertion = {0.0, 0.0, 0.0, false, this->hash};
+    const std::vector<unsigned> & path = this->paths[k];
+
+    if(i == 0 || i > j || j >= path.size()) {
+        return insertion;
+    }
+
+    unsigned sourceR = this->instance->getSourceR(r);
+    unsigned targetR = this->instance->getTargetR(r);
+    const VertexRecord & source = this->instance->getVertex(sourceR);
+    const VertexRecord & target = this->instance->getVertex(targetR);
+    double tSource, tTarget, deltaSource, deltaTarget = 0.0;
+
+    // the vertices after the source are delayed by deltaSource, and those after the
+    // target by deltaTarget as well
+    if(i == j) {
+        tSource = this->instance->getTravelTime(path[i - 1], sourceR, k) + source.tVisit;
+        tTarget = tSource + this->instance->getTravelTime(sourceR, targetR, k) + target.tVisit;
+        deltaSource = tTarget + this->instance->getTravelTime(targetR, path[i], k) -
+            this->instance->getTravelTime(path[i - 1], path[i], k);
+        insertion.hash ^= getArcKey(k, path[i - 1], path[i]) ^
+            getArcKey(k, path[i - 1], sourceR) ^ getArcKey(k, sourceR, targetR) ^
+            getArcKey(k, targetR, path[i]);
+    } else {
+        tSource = this->instance->getTravelTime(path[i - 1], sourceR, k) + source.tVisit;
+        deltaSource = tSource + this->instance->getTravelTime(sourceR, path[i], k) -
+            this->instance->getTravelTime(path[i - 1], path[i], k);
+        tTarget = deltaSource + this->instance->getTravelTime(path[j - 1], targetR, k) +
+            target.tVisit;
+        deltaTarget = this->instance->getTravelTime(path[j - 1], targetR, k) + target.tVisit +
+            this->instance->getTravelTime(targetR, path[j], k) -
+            this->instance->getTravelTime(path[j - 1], path[j], k);
+        insertion.hash ^= getArcKey(k, path[i - 1], path[i]) ^
+            getArcKey(k, path[i - 1], sourceR) ^ getArcKey(k, sourceR, path[i]) ^
+            getArcKey(k, path[j - 1], path[j]) ^ getArcKey(k, path[j - 1], targetR) ^
+            getArcKey(k, targetR, path[j]);
+    }
+
+    insertion.deltaTotalProfit = this->instance->getProfit(r);
+    insertion.deltaTTravel = deltaSource + deltaTarget;
+    insertion.deltaSumTFulfill = deltaSource * this->numTargets[k][i] +
+        deltaTarget * this->numTargets[k][j] + this->instance->getTStart(k) +
+        this->times[k][j - 1] + tTarget - this->instance->getTCreate(r);
+
+    // the loads between the source and the target grow by the demand of the source, and
+    // the loads after the target by the demands of both
+    double capacity = this->instance->getCapacity(k);
+    double deltaLoad = source.demand + target.demand;
+
+    insertion.isFeasible = this->vehiclesV[sourceR] == this->instance->getNumVehicles() &&
+        this->vehiclesV[targetR] == this->instance->getNumVehicles() &&
+        this->instance->isEligible(r, k) &&
+        path.front() == this->instance->getSourceK(k) &&
+        path.back() == this->instance->getTargetK(k) &&
+        insertion.deltaTTravel <= this->slacks[k] &&
+        this->getMaxLoad(k, 0, i - 1) <= capacity &&
+        this->getMaxLoad(k, i - 1, j - 1) + source.demand <= capacity &&
+        this->loads[k][j - 1] + deltaLoad <= capacity &&
+        this->getMaxLoad(k, j, path.size() - 1) + deltaLoad <= capacity;
+
+    return insertion;
 }
 
 bool Solution::isValidPath(unsigned k, unsigned & error) const {
     error = 0;
 
-    if(this->paths[k].front() != this->instance.getSourceK(k)) {
+    if(this->paths[k].front() != this->instance->getSourceK(k)) {
         error = 1;
         return false;
     }
 
-    if(this->paths[k].back() != this->instance.getTargetK(k)) {
+    if(this->paths[k].back() != this->instance->getTargetK(k)) {
         error = 2;
         return false;
     }
 
-    if(this->tTravels[k] > this->instance.getTLimit(k)) {
+    if(this->tTravels[k] > this->instance->getTLimit(k)) {
         error = 3;
         return false;
     }
 
     for(unsigned j = 0; j < this->paths[k].size(); j++) {
-        if(this->loads[k][j] > this->instance.getCapacity(k)) {
+        if(this->loads[k][j] > this->instance->getCapacity(k)) {
             error = 4;
             return false;
         }
     }
 
     for(auto r : this->requestsK[k]) {
-        if(this->indexesKV[k][this->instance.getSourceR(r)] >=
-                this->indexesKV[k][this->instance.getTargetR(r)]) {
+        if(this->getIndexKV(k, this->instance->getSourceR(r)) >=
+                this->getIndexKV(k, this->instance->getTargetR(r))) {
             error = 5;
             return false;
         }
@@ -369,7 +661,7 @@ bool Solution::isValidPath(unsigned k) const {
 bool Solution::isFeasible(unsigned int & error) const {
     error = 0;
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         if(!this->isValidPath(k)) {
             error = k + 1;
             return false;
@@ -389,16 +681,22 @@ bool Solution::isFeasible() const {
 }
 
 
-bool Solution::areConstraintsSatisfied(unsigned & error) const {
+bool Solution::areDecisionVariablesSatisfied(unsigned & error) const {
+    const DecisionVariables & variables = this->getDecisionVariables();
+    const std::vector<std::vector<std::vector<bool>>> & x = variables.x;
+    const std::vector<std::vector<bool>> & y = variables.y;
+    const std::vector<std::vector<double>> & t = variables.t;
+    const std::vector<std::vector<double>> & l = variables.l;
+
     error = 0;
 
-    for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
+    for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
         unsigned sumXorik = 0;
 
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(i != this->instance.getSourceR(r)) {
-                for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                    if(this->x[this->instance.getSourceR(r)][i][k]) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(i != this->instance->getSourceR(r)) {
+                for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                    if(x[this->instance->getSourceR(r)][i][k]) {
                         sumXorik++;
                     }
                 }
@@ -411,13 +709,13 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
+    for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
         unsigned sumXidrk = 0;
 
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(i != this->instance.getTargetR(r)) {
-                for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                    if(this->x[i][this->instance.getTargetR(r)][k]) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(i != this->instance->getTargetR(r)) {
+                for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                    if(x[i][this->instance->getTargetR(r)][k]) {
                         sumXidrk++;
                     }
                 }
@@ -430,17 +728,17 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
             unsigned sumXorik = 0, sumXidrk = 0;
 
-            for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-                if(i != this->instance.getSourceR(r) 
-                        && this->x[this->instance.getSourceR(r)][i][k]) {
+            for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+                if(i != this->instance->getSourceR(r) 
+                        && x[this->instance->getSourceR(r)][i][k]) {
                     sumXorik++;
                 }
-                if(i != this->instance.getTargetR(r) 
-                        && this->x[i][this->instance.getTargetR(r)][k]) {
+                if(i != this->instance->getTargetR(r) 
+                        && x[i][this->instance->getTargetR(r)][k]) {
                     sumXidrk++;
                 }
             }
@@ -452,13 +750,13 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         unsigned sumXokik = 0;
 
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(((this->instance.isASource(i) && i != this->instance.getSourceK(k)) 
-                        || i == this->instance.getTargetK(k)) 
-                    && this->x[this->instance.getSourceK(k)][i][k]) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(((this->instance->isASource(i) && i != this->instance->getSourceK(k)) 
+                        || i == this->instance->getTargetK(k)) 
+                    && x[this->instance->getSourceK(k)][i][k]) {
                 sumXokik++;
             }
         }
@@ -469,13 +767,13 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         unsigned sumXidkk = 0;
 
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(((this->instance.isATarget(i) && i != this->instance.getTargetK(k)) 
-                        || i == this->instance.getSourceK(k)) 
-                    && this->x[i][this->instance.getTargetK(k)][k]) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(((this->instance->isATarget(i) && i != this->instance->getTargetK(k)) 
+                        || i == this->instance->getSourceK(k)) 
+                    && x[i][this->instance->getTargetK(k)][k]) {
                 sumXidkk++;
             }
         }
@@ -486,17 +784,17 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(i != this->instance.getSourceK(k) && i != this->instance.getTargetK(k)) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(i != this->instance->getSourceK(k) && i != this->instance->getTargetK(k)) {
                 unsigned sumXjik = 0, sumXijk = 0;
 
-                for(unsigned j = 0; j < this->instance.getNumVertices(); j++) {
-                    if(j != this->instance.getTargetK(k) && this->x[j][i][k]) {
+                for(unsigned j = 0; j < this->instance->getNumVertices(); j++) {
+                    if(j != this->instance->getTargetK(k) && x[j][i][k]) {
                         sumXjik++;
                     }
 
-                    if(j != this->instance.getSourceK(k) && this->x[i][j][k]) {
+                    if(j != this->instance->getSourceK(k) && x[i][j][k]) {
                         sumXijk++;
                     }
                 }
@@ -509,18 +807,18 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
             unsigned int sumXorik = 0;
             unsigned int yrk = 0;
 
-            if(this->y[r][k]) {
+            if(y[r][k]) {
                 yrk = 1;
             }
 
-            for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-                if(i != this->instance.getSourceR(r) 
-                        && this->x[this->instance.getSourceR(r)][i][k]) {
+            for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+                if(i != this->instance->getSourceR(r) 
+                        && x[this->instance->getSourceR(r)][i][k]) {
                     sumXorik++;
                 }
             }
@@ -532,18 +830,18 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
             unsigned sumXidrk = 0;
             unsigned yrk = 0;
 
-            if(this->y[r][k]) {
+            if(y[r][k]) {
                 yrk = 1;
             }
 
-            for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-                if(i != this->instance.getTargetR(r) 
-                        && this->x[i][this->instance.getTargetR(r)][k]) {
+            for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+                if(i != this->instance->getTargetR(r) 
+                        && x[i][this->instance->getTargetR(r)][k]) {
                     sumXidrk++;
                 }
             }
@@ -555,31 +853,31 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        if(this->t[this->instance.getSourceK(k)][k] < this->instance.getTStart(k)) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        if(t[this->instance->getSourceK(k)][k] < this->instance->getTStart(k)) {
             error = 9;
             return false;
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        if(this->t[this->instance.getTargetK(k)][k] > this->instance.getTStart(k) +
-                this->instance.getTLimit(k) -
-                this->instance.getTVisit(this->instance.getTargetK(k))) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        if(t[this->instance->getTargetK(k)][k] > this->instance->getTStart(k) +
+                this->instance->getTLimit(k) -
+                this->instance->getTVisit(this->instance->getTargetK(k))) {
             error = 10;
             return false;
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-            if(this->y[r][k]) {
-                if(this->t[this->instance.getSourceK(k)][k] - this->instance.getTCreate(r) < 0.0) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+            if(y[r][k]) {
+                if(t[this->instance->getSourceK(k)][k] - this->instance->getTCreate(r) < 0.0) {
                     error = 11;
                     return false;
                 }
             } else {
-                if(this->t[this->instance.getSourceK(k)][k] < 0.0) {
+                if(t[this->instance->getSourceK(k)][k] < 0.0) {
                     error = 11;
                     return false;
                 }
@@ -587,17 +885,17 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-            if(this->y[r][k]) {
-                if(this->t[this->instance.getTargetR(r)][k] - this->instance.getTStart(k) -
-                        this->instance.getTLimit(k) +
-                        this->instance.getTVisit(this->instance.getTargetK(k)) > 0.0) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+            if(y[r][k]) {
+                if(t[this->instance->getTargetR(r)][k] - this->instance->getTStart(k) -
+                        this->instance->getTLimit(k) +
+                        this->instance->getTVisit(this->instance->getTargetK(k)) > 0.0) {
                     error = 12;
                     return false;
                 }
             } else {
-                if(this->t[this->instance.getTargetR(r)][k] > 0.0) {
+                if(t[this->instance->getTargetR(r)][k] > 0.0) {
                     error = 12;
                     return false;
                 }
@@ -605,19 +903,19 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-            if(this->y[r][k]) {
-                if(this->t[this->instance.getTargetK(k)][k] -
-                        this->t[this->instance.getSourceK(k)][k] -
-                        this->instance.getLength(this->instance.getSourceR(r),
-                            this->instance.getTargetR(r)) / this->instance.getSpeed(k) < 0.0) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+            if(y[r][k]) {
+                if(t[this->instance->getTargetK(k)][k] -
+                        t[this->instance->getSourceK(k)][k] -
+                        this->instance->getTravelTime(this->instance->getSourceR(r),
+                            this->instance->getTargetR(r), k) < 0.0) {
                     error = 13;
                     return false;
                 }
             } else {
-                if(this->t[this->instance.getTargetK(k)][k] -
-                        this->t[this->instance.getSourceK(k)][k] < 0.0) {
+                if(t[this->instance->getTargetK(k)][k] -
+                        t[this->instance->getSourceK(k)][k] < 0.0) {
                     error = 13;
                     return false;
                 }
@@ -625,22 +923,22 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            for(unsigned j = 0; j < this->instance.getNumVertices(); j++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            for(unsigned j = 0; j < this->instance->getNumVertices(); j++) {
                 unsigned xijk = 0;
 
-                if(this->x[i][j][k]) {
+                if(x[i][j][k]) {
                     xijk = 1;
                 }
 
-                if(this->t[j][k] - this->t[i][k] - (this->instance.getTStart(k) +
-                            this->instance.getTLimit(k) -
-                            this->instance.getTVisit(this->instance.getTargetK(k)) +
-                            this->instance.getTVisit(i) + this->instance.getLength(i, j) /
-                            this->instance.getSpeed(k)) * xijk <
-                        this->instance.getTVisit(this->instance.getTargetK(k)) -
-                        this->instance.getTStart(k) - this->instance.getTLimit(k) -
+                if(t[j][k] - t[i][k] - (this->instance->getTStart(k) +
+                            this->instance->getTLimit(k) -
+                            this->instance->getTVisit(this->instance->getTargetK(k)) +
+                            this->instance->getTVisit(i) +
+                            this->instance->getTravelTime(i, j, k)) * xijk <
+                        this->instance->getTVisit(this->instance->getTargetK(k)) -
+                        this->instance->getTStart(k) - this->instance->getTLimit(k) -
                         std::numeric_limits<float>::epsilon()) {
                     error = 14;
                     return false;
@@ -649,29 +947,29 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        if(fabs(this->l[this->instance.getSourceK(k)][k]) > std::numeric_limits<float>::epsilon()) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        if(fabs(l[this->instance->getSourceK(k)][k]) > std::numeric_limits<float>::epsilon()) {
             error = 15;
             return false;
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        if(fabs(this->l[this->instance.getTargetK(k)][k]) > std::numeric_limits<float>::epsilon()) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        if(fabs(l[this->instance->getTargetK(k)][k]) > std::numeric_limits<float>::epsilon()) {
             error = 16;
             return false;
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-            if(this->y[r][k]) {
-                if(this->l[this->instance.getSourceR(r)][k] - this->instance.getDemandR(r) < 0.0) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+            if(y[r][k]) {
+                if(l[this->instance->getSourceR(r)][k] - this->instance->getDemandR(r) < 0.0) {
                     error = 17;
                     return false;
                 }
             } else {
-                if(this->l[this->instance.getSourceR(r)][k] < 0.0) {
+                if(l[this->instance->getSourceR(r)][k] < 0.0) {
                     error = 17;
                     return false;
                 }
@@ -679,36 +977,36 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-            if(this->l[this->instance.getSourceR(r)][k] > this->instance.getCapacity(k)) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+            if(l[this->instance->getSourceR(r)][k] > this->instance->getCapacity(k)) {
                 error = 18;
                 return false;
             }
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-            if(this->l[this->instance.getTargetR(r)][k] > this->instance.getCapacity(k) -
-                    this->instance.getDemandR(r)) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+            if(l[this->instance->getTargetR(r)][k] > this->instance->getCapacity(k) -
+                    this->instance->getDemandR(r)) {
                 error = 19;
                 return false;
             }
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            for(unsigned j = 0; j < this->instance.getNumVertices(); j++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            for(unsigned j = 0; j < this->instance->getNumVertices(); j++) {
                 unsigned xijk = 0;
 
-                if(this->x[i][j][k]) {
+                if(x[i][j][k]) {
                     xijk = 1;
                 }
 
-                if(this->l[i][k] - this->l[j][k] + (this->instance.getCapacity(k) +
-                            this->instance.getDemandV(j)) * xijk > this->instance.getCapacity(k) +
+                if(l[i][k] - l[j][k] + (this->instance->getCapacity(k) +
+                            this->instance->getDemandV(j)) * xijk > this->instance->getCapacity(k) +
                         std::numeric_limits<float>::epsilon()) {
                     error = 20;
                     return false;
@@ -717,18 +1015,18 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(this->t[i][k] < 0.0) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(t[i][k] < 0.0) {
                 error = 21;
                 return false;
             }
         }
     }
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-        for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-            if(this->l[i][k] < 0.0) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+        for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+            if(l[i][k] < 0.0) {
                 error = 22;
                 return false;
             }
@@ -738,6 +1036,300 @@ bool Solution::areConstraintsSatisfied(unsigned & error) const {
     return true;
 }
 
+bool Solution::areConstraintsSatisfied(unsigned & error) const {
+    unsigned numVertices = this->instance->getNumVertices();
+    unsigned numRequests = this->instance->getNumRequests();
+    unsigned numVehicles = this->instance->getNumVehicles();
+    double epsilon = std::numeric_limits<float>::epsilon();
+    double maxDemand = -std::numeric_limits<double>::infinity();
+
+    if(this->hasGivenDecisionVariables) {
+        return this->areDecisionVariablesSatisfied(error);
+    }
+
+    // a vertex in more than one position overwrites the vehicle and the position of the others
+    for(unsigned k = 0; k < numVehicles; k++) {
+        for(unsigned i = 0; i < this->paths[k].size(); i++) {
+            unsigned v = this->paths[k][i];
+
+            if(this->vehiclesV[v] != k || this->positions[v] != i) {
+                return this->areDecisionVariablesSatisfied(error);
+            }
+        }
+    }
+
+    for(unsigned r = 0; r < numRequests; r++) {
+        maxDemand = std::max(maxDemand, this->instance->getDemandR(r));
+    }
+
+    error = 0;
+
+    // keeps the number of the first constraint not satisfied, whatever the order of the checks
+    auto violate = [&](unsigned constraint) {
+        if(error == 0 || constraint < error) {
+            error = constraint;
+        }
+    };
+
+    // every vertex is in a single position, so that no vertex is left or entered twice and
+    // the constraints 1 and 2 are satisfied
+    for(unsigned k = 0; k < numVehicles; k++) {
+        const std::vector<unsigned> & path = this->paths[k];
+        unsigned size = path.size();
+        unsigned sourceK = this->instance->getSourceK(k);
+        unsigned targetK = this->instance->getTargetK(k);
+        double tStart = this->instance->getTStart(k);
+        double tLimit = this->instance->getTLimit(k);
+        double capacity = this->instance->getCapacity(k);
+        std::vector<double> t(size, tStart), l(size, 0.0);
+
+        // the values of the decision variables t and l along the path, as derived by
+        // computeDecisionVariables, which are zero at the vertices out of the path
+        for(unsigned i = 1; i < size; i++) {
+            const VertexRecord & vertex = this->instance->getVertex(path[i]);
+
+            t[i] = t[i - 1] + this->instance->getTVisit(path[i - 1]) +
+                this->instance->getTravelTime(path[i - 1], path[i], k);
+
+            if(vertex.role == VertexRole::REQUEST_SOURCE &&
+                    t[i] < this->instance->getTCreate(vertex.request)) {
+                t[i] = this->instance->getTCreate(vertex.request);
+            }
+
+            l[i] = l[i - 1] + vertex.demand;
+        }
+
+        auto getIndex = [&](unsigned v) {
+            return this->vehiclesV[v] == k ? this->positions[v] : size;
+        };
+
+        auto getT = [&](unsigned v) {
+            return getIndex(v) < size ? t[getIndex(v)] : 0.0;
+        };
+
+        auto getL = [&](unsigned v) {
+            return getIndex(v) < size ? l[getIndex(v)] : 0.0;
+        };
+
+        auto getOutDegree = [&](unsigned v) {
+            return getIndex(v) + 1 < size ? 1u : 0u;
+        };
+
+        auto getInDegree = [&](unsigned v) {
+            return getIndex(v) > 0 && getIndex(v) < size ? 1u : 0u;
+        };
+
+        unsigned iSourceK = getIndex(sourceK), iTargetK = getIndex(targetK);
+
+        if(iSourceK + 1 >= size || !((this->instance->isASource(path[iSourceK + 1]) &&
+                        path[iSourceK + 1] != sourceK) || path[iSourceK + 1] == targetK)) {
+            violate(4);
+        }
+
+        if(iTargetK == 0 || iTargetK >= size || !((this->instance->isATarget(path[iTargetK - 1])
+                        && path[iTargetK - 1] != targetK) || path[iTargetK - 1] == sourceK)) {
+            violate(5);
+        }
+
+        if(getT(sourceK) < tStart) {
+            violate(9);
+        }
+
+        if(getT(targetK) > tStart + tLimit - this->instance->getTVisit(targetK)) {
+            violate(10);
+        }
+
+        if(fabs(getL(sourceK)) > epsilon) {
+            violate(15);
+        }
+
+        if(fabs(getL(targetK)) > epsilon) {
+            violate(16);
+        }
+
+        unsigned numServed = 0, numSources = 0;
+
+        for(unsigned i = 0; i < size; i++) {
+            unsigned v = path[i];
+            const VertexRecord & vertex = this->instance->getVertex(v);
+
+            if(v != sourceK && v != targetK && (i > 0 && path[i - 1] != targetK) !=
+                    (i + 1 < size && path[i + 1] != sourceK)) {
+                violate(6);
+            }
+
+            if(t[i] < 0.0) {
+                violate(21);
+            }
+
+            if(l[i] < 0.0) {
+                violate(22);
+            }
+
+            if(vertex.role != VertexRole::REQUEST_SOURCE &&
+                    vertex.role != VertexRole::REQUEST_TARGET) {
+                continue;
+            }
+
+            unsigned r = vertex.request;
+            unsigned sourceR = this->instance->getSourceR(r);
+            unsigned targetR = this->instance->getTargetR(r);
+            unsigned iTargetR = getIndex(targetR);
+            bool y = iTargetR > 0 && iTargetR + 1 < size;
+
+            if(getOutDegree(sourceR) != getInDegree(targetR)) {
+                violate(3);
+            }
+
+            if(y != (getOutDegree(sourceR) == 1)) {
+                violate(7);
+            }
+
+            if(y != (getInDegree(targetR) == 1)) {
+                violate(8);
+            }
+
+            if(vertex.role == VertexRole::REQUEST_SOURCE) {
+                numSources++;
+
+                if(!y && l[i] < 0.0) {
+                    violate(17);
+                }
+
+                if(l[i] > capacity) {
+                    violate(18);
+                }
+
+                continue;
+            }
+
+            if(y) {
+                numServed++;
+
+                if(getT(sourceK) - this->instance->getTCreate(r) < 0.0) {
+                    violate(11);
+                }
+
+                if(t[i] - tStart - tLimit + this->instance->getTVisit(targetK) > 0.0) {
+                    violate(12);
+                }
+
+                if(getT(targetK) - getT(sourceK) -
+                        this->instance->getTravelTime(sourceR, targetR, k) < 0.0) {
+                    violate(13);
+                }
+
+                if(getL(sourceR) - this->instance->getDemandR(r) < 0.0) {
+                    violate(17);
+                }
+            } else if(t[i] > 0.0) {
+                violate(12);
+            }
+
+            if(l[i] > capacity - this->instance->getDemandR(r)) {
+                violate(19);
+            }
+        }
+
+        // the requests out of the path, whose variables are zero
+        if(numServed < numRequests) {
+            if(getT(sourceK) < 0.0) {
+                violate(11);
+            }
+
+            if(getT(targetK) - getT(sourceK) < 0.0) {
+                violate(13);
+            }
+        }
+
+        if(numSources < numRequests && 0.0 > capacity) {
+            violate(18);
+        }
+
+        if(maxDemand > capacity) {
+            for(unsigned r = 0; r < numRequests; r++) {
+                if(getIndex(this->instance->getTargetR(r)) == size &&
+                        0.0 > capacity - this->instance->getDemandR(r)) {
+                    violate(19);
+                }
+            }
+        }
+
+        double minTDifference = this->instance->getTVisit(targetK) - tStart - tLimit - epsilon;
+
+        for(unsigned i = 1; i < size; i++) {
+            unsigned u = path[i - 1], v = path[i];
+
+            if(t[i] - t[i - 1] - (tStart + tLimit - this->instance->getTVisit(targetK) +
+                        this->instance->getTVisit(u) + this->instance->getTravelTime(u, v, k)) <
+                    minTDifference) {
+                violate(14);
+            }
+
+            if(l[i - 1] - l[i] + (capacity + this->instance->getDemandV(v)) >
+                    capacity + epsilon) {
+                violate(20);
+            }
+        }
+
+        // the pairs of vertices that are not edges of the path only bound the differences of
+        // their values, which are the widest between two of the highest and two of the lowest
+        // values, since a vertex has a single successor and a single predecessor; the entries
+        // from the size of the path onwards stand for vertices out of it
+        unsigned numEntries = size + std::min(2u, numVertices - size);
+
+        auto getValue = [&](const std::vector<double> & values, unsigned e) {
+            return e < size ? values[e] : 0.0;
+        };
+
+        auto getExtremes = [&](const std::vector<double> & values, bool isHighest) {
+            std::array<unsigned, 2> extremes = {{numEntries, numEntries}};
+
+            for(unsigned e = 0; e < numEntries; e++) {
+                unsigned entry = e;
+
+                for(unsigned & extreme : extremes) {
+                    if(extreme == numEntries || (isHighest ?
+                                getValue(values, entry) > getValue(values, extreme) :
+                                getValue(values, entry) < getValue(values, extreme))) {
+                        std::swap(entry, extreme);
+                    }
+
+                    if(entry == numEntries) {
+                        break;
+                    }
+                }
+            }
+
+            return extremes;
+        };
+
+        auto isEdge = [&](unsigned a, unsigned b) {
+            return b < size && a + 1 == b;
+        };
+
+        for(unsigned a : getExtremes(t, true)) {
+            for(unsigned b : getExtremes(t, false)) {
+                if(a < numEntries && b < numEntries && !isEdge(a, b) &&
+                        getValue(t, b) - getValue(t, a) < minTDifference) {
+                    violate(14);
+                }
+            }
+        }
+
+        for(unsigned a : getExtremes(l, true)) {
+            for(unsigned b : getExtremes(l, false)) {
+                if(a < numEntries && b < numEntries && !isEdge(a, b) &&
+                        getValue(l, a) - getValue(l, b) > capacity + epsilon) {
+                    violate(20);
+                }
+            }
+        }
+    }
+
+    return error == 0;
+}
+
 bool Solution::areConstraintsSatisfied() const {
     bool result;
     unsigned error;
@@ -748,13 +1340,13 @@ bool Solution::areConstraintsSatisfied() const {
 }
 
 void Solution::write(std::ostream & os) const {
-    for(unsigned k = 0; k < this->instance.getNumVehicles() - 1; k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles() - 1; k++) {
         os << this->paths[k].size() << " ";
     }
 
-    os << this->paths[this->paths.size() - 1].size();
+    os << this->paths[this->paths.size() - 1].size() << std::endl;
 
-    for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
+    for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
         for(unsigned i = 0; i < this->paths[k].size() - 1; i++) {
             os << this->paths[k][i] << " ";
         }
@@ -764,15 +1356,10 @@ void Solution::write(std::ostream & os) const {
 }
 
 void Solution::write(const char * filename) const {
-    std::ofstream ofs;
-    ofs.open(filename);
+    CompressedOutputStream os(filename);
 
-    if(ofs.is_open()) {
-        this->write(ofs);
-        ofs.close();
-    } else {
-        throw "File not created.";
-    }
+    this->write(os);
+    os.close();
 }
 
 void Solution::write(const std::string & filename) const {
@@ -1,42 +1,110 @@
 #pragma once
 
 #include "../instance/Instance.hpp"
+#include <memory>
 #include <unordered_set>
 
+/********************************************************************************************
+ * The values of the decision variables of the MVRPPD formulation for a solution.
+ ********************************************************************************************/
+struct DecisionVariables {
+    /*************************************************************************************
+     * x[i][j][k] == true if and only if the vehicle k ∈ K traverses the edge (i, j) ∈ E.
+     *************************************************************************************/
+    std::vector<std::vector<std::vector<bool>>> x;
+
+    /*************************************************************************
+     * y[r][k] == true if and only if the vehicle k ∈ K serves request r ∈ R.
+     *************************************************************************/
+    std::vector<std::vector<bool>> y;
+
+    /**********************************************************************
+     * t[i][k] is the time when vehicle k ∈ K starts serving vertex i ∈ V.
+     **********************************************************************/
+    std::vector<std::vector<double>> t;
+
+    /*******************************************************************
+     * l[i][k] is the load of vehicle k ∈ K after serving vertex i ∈ V.
+     *******************************************************************/
+    std::vector<std::vector<double>> l;
+};
+
+/********************************************************************************************
+ * The vehicle that traverses each edge and the index of each vertex in each path of a
+ * solution, as dense matrices.
+ ********************************************************************************************/
+struct DenseIndexes {
+    /**********************************************************************************
+     * vehiclesE[u][v] is the vehicle that traverses the edge (u, v) ∈ E, or |K| if
+     * there is none.
+     **********************************************************************************/
+    std::vector<std::vector<unsigned>> vehiclesE;
+
+    /**********************************************************************************
+     * indexesKV[k][v] is the index of vertex v ∈ V in the path of vehicle k ∈ K, or
+     * the size of the path if the vertex is not in it.
+     **********************************************************************************/
+    std::vector<std::vector<unsigned>> indexesKV;
+};
+
+/********************************************************************************************
+ * The effect of inserting the source and the target of a request into the path of a vehicle
+ * on the objectives of a solution, and whether the path remains valid.
+ ********************************************************************************************/
+struct Insertion {
+    /****************************************
+     * The change of the total profit.
+     ****************************************/
+    double deltaTotalProfit;
+
+    /***********************************************************************
+     * The change of the sum of the fulfill time of the served requests.
+     ***********************************************************************/
+    double deltaSumTFulfill;
+
+    /***********************************************************
+     * The change of the travelling time of the vehicle.
+     ***********************************************************/
+    double deltaTTravel;
+
+    /****************************************************************
+     * Whether the path of the vehicle is valid after the insertion.
+     ****************************************************************/
+    bool isFeasible;
+
+    /****************************************************************
+     * The hash of the solution after the insertion.
+     ****************************************************************/
+    uint64_t hash;
+};
+
 /***************************************************
  * The Solution class represents a MVRPPD solution.
  ***************************************************/
 class Solution {
     private:
-        /************************************
-         * The MVRPPD instance being solved.
-         ************************************/
-        Instance instance;
+        /****************************************************************************
+         * The MVRPPD instance being solved, shared with the other solutions of the
+         * same instance.
+         ****************************************************************************/
+        std::shared_ptr<const Instance> instance;
 
         /*****************************************************
          * A set of paths with a valid path for each vehicle.
          *****************************************************/
         std::vector<std::vector<unsigned>> paths;
 
-        /*************************************************************************************
-         * x[i][j][k] == true if and only if the vehicle k ∈ K traverses the edge (i, j) ∈ E.
-         *************************************************************************************/
-        std::vector<std::vector<std::vector<bool>>> x;
-
-        /*************************************************************************
-         * y[r][k] == true if and only if the vehicle k ∈ K serves request r ∈ R.
-         *************************************************************************/
-        std::vector<std::vector<bool>> y;
-
-        /**********************************************************************
-         * t[i][k] is the time when vehicle k ∈ K starts serving vertex i ∈ V.
-         **********************************************************************/
-        std::vector<std::vector<double>> t;
+        /**************************************************************************************
+         * The values of the decision variables, derived from the paths on first access and
+         * shared by the copies of the solution, or null until then.
+         **************************************************************************************/
+        mutable std::shared_ptr<const DecisionVariables> decisionVariables;
 
-        /*******************************************************************
-         * l[i][k] is the load of vehicle k ∈ K after serving vertex i ∈ V.
-         *******************************************************************/
-        std::vector<std::vector<double>> l;
+        /*********************************************************************
+         * Whether the decision variables were given rather than derived from
+         * the paths.
+         *********************************************************************/
+        bool hasGivenDecisionVariables;
 
         /****************************************************************************************
          * The amount of time each vehicle needs to visit each vertex and traverses each edge in
@@ -79,30 +147,79 @@ class Solution {
          ***************************************/
         std::vector<unsigned> vehiclesV;
 
-        /*************************************************
-         * The vehicle that traverses each edge.
-         *************************************************/
-        std::vector<std::vector<unsigned>> vehiclesE;
+        /****************************************************************************
+         * The vertex that follows each vertex in its path, or |V| if there is none.
+         ****************************************************************************/
+        std::vector<unsigned> successors;
+
+        /*************************************************************************
+         * The index of each vertex in the path of the vehicle that serves it.
+         *************************************************************************/
+        std::vector<unsigned> positions;
 
         /**********************************************
          * The requests fulfilled by each vehicle.
          **********************************************/
         std::vector<std::unordered_set<unsigned>> requestsK;
 
-        /*************************************************
-         * The indexes of each vertex in each path
-         *************************************************/
-        std::vector<std::vector<unsigned>> indexesKV;
+        /**************************************************************************************
+         * The vehicle of each edge and the index of each vertex in each path as dense
+         * matrices, derived from the successors and positions on the first access to either,
+         * or null until then.
+         **************************************************************************************/
+        mutable std::shared_ptr<const DenseIndexes> denseIndexes;
+
+        /**********************************************************************
+         * The travelling time each vehicle can still spend within its limit.
+         **********************************************************************/
+        std::vector<double> slacks;
+
+        /*************************************************************************************
+         * maxLoads[k][p][i] is the maximum load of vehicle k ∈ K after serving the vertices
+         * i to i + 2^p - 1 of its path, so that the maximum load between any two positions
+         * is read from two entries.
+         *************************************************************************************/
+        std::vector<std::vector<std::vector<double>>> maxLoads;
+
+        /****************************************************************************
+         * numTargets[k][i] is the number of request targets served by vehicle k ∈ K
+         * from the vertex i of its path onwards.
+         ****************************************************************************/
+        std::vector<std::vector<unsigned>> numTargets;
+
+        /************************************************************************************
+         * The hash of the paths, which is the exclusive or of the keys of the arcs of every
+         * path, including a virtual arc from |V| to the first vertex of each path.
+         ************************************************************************************/
+        uint64_t hash;
 
         /******************************
          * Initializes a new solution.
          ******************************/
         void init();
 
-        /*****************************************
-         * Compute the decision variables values.
-         *****************************************/
-        void computeDecisionVariables();
+        /*****************************************************
+         * Computes the values of the decision variables.
+         *
+         * @return the values of the decision variables.
+         *****************************************************/
+        std::shared_ptr<const DecisionVariables> computeDecisionVariables() const;
+
+        /*****************************************************************************
+         * Returns the values of the decision variables, computing them on the first
+         * call. Concurrent first calls all return the values kept by the solution.
+         *
+         * @return the values of the decision variables.
+         *****************************************************************************/
+        const DecisionVariables & getDecisionVariables() const;
+
+        /*****************************************************************************
+         * Returns the dense matrices of the vehicle of each edge and the index of
+         * each vertex in each path, computing them on the first call.
+         *
+         * @return the dense matrices of the indexes.
+         *****************************************************************************/
+        const DenseIndexes & getDenseIndexes() const;
 
         /*******************************************
          * Initializes a new solution.
@@ -118,6 +235,15 @@ class Solution {
          * @param instance the instance been solved.
          * @param paths    a set of paths.
          **************************************************************************************/
+        Solution(const std::shared_ptr<const Instance> & instance,
+                const std::vector<std::vector<unsigned>> & paths);
+
+        /**************************************************************************************
+         * Constructs a new solution that holds a copy of the specified instance.
+         *
+         * @param instance the instance been solved.
+         * @param paths    a set of paths.
+         **************************************************************************************/
         Solution(const Instance & instance, const std::vector<std::vector<unsigned>> & paths);
 
         /**************************************************************
@@ -129,6 +255,21 @@ class Solution {
          * @param t        the decision variables t.
          * @param l        the decision variables l.
          **************************************************************/
+        Solution(const std::shared_ptr<const Instance> & instance,
+                const std::vector<std::vector<std::vector<bool>>> & x,
+                const std::vector<std::vector<bool>> & y,
+                const std::vector<std::vector<double>> & t,
+                const std::vector<std::vector<double>> & l);
+
+        /*************************************************************************
+         * Constructs a new solution that holds a copy of the specified instance.
+         *
+         * @param instance the instance been solved.
+         * @param x        the decision variables x.
+         * @param y        the decision variables y.
+         * @param t        the decision variables t.
+         * @param l        the decision variables l.
+         *************************************************************************/
         Solution(const Instance & instance,
                 const std::vector<std::vector<std::vector<bool>>> & x,
                 const std::vector<std::vector<bool>> & y,
@@ -141,6 +282,14 @@ class Solution {
          * @param instance the instance been solved.
          * @param is       the input stream to read from.
          *******************************************************/
+        Solution(const std::shared_ptr<const Instance> & instance, std::istream & is);
+
+        /*************************************************************************
+         * Constructs a new solution that holds a copy of the specified instance.
+         *
+         * @param instance the instance been solved.
+         * @param is       the input stream to read from.
+         *************************************************************************/
         Solution(const Instance & instance, std::istream & is);
 
         /***********************************************************
@@ -149,6 +298,14 @@ class Solution {
          * @param instance the instance been solved.
          * @param filename the file to read from.
          ***********************************************************/
+        Solution(const std::shared_ptr<const Instance> & instance, const char * filename);
+
+        /*************************************************************************
+         * Constructs a new solution that holds a copy of the specified instance.
+         *
+         * @param instance the instance been solved.
+         * @param filename the file to read from.
+         *************************************************************************/
         Solution(const Instance & instance, const char * filename);
 
         /******************************************************************
@@ -157,6 +314,14 @@ class Solution {
          * @param instance the instance been solved.
          * @param filename the file to read from.
          ******************************************************************/
+        Solution(const std::shared_ptr<const Instance> & instance, const std::string & filename);
+
+        /*************************************************************************
+         * Constructs a new solution that holds a copy of the specified instance.
+         *
+         * @param instance the instance been solved.
+         * @param filename the file to read from.
+         *************************************************************************/
         Solution(const Instance & instance, const std::string & filename);
 
         /********************************************
@@ -164,6 +329,13 @@ class Solution {
          *
          * @param instance the instance been solved.
          ********************************************/
+        Solution(const std::shared_ptr<const Instance> & instance);
+
+        /*************************************************************************
+         * Constructs a new solution that holds a copy of the specified instance.
+         *
+         * @param instance the instance been solved.
+         *************************************************************************/
         Solution(const Instance & instance);
 
         /***********************************
@@ -171,19 +343,61 @@ class Solution {
          ***********************************/
         Solution();
 
+        /*************************************************************************************
+         * Constructs a copy of the specified solution. The values derived on first access
+         * are read atomically, so the solution can be copied while another thread derives
+         * them.
+         *
+         * @param solution the solution to be copied.
+         *************************************************************************************/
+        Solution(const Solution & solution);
+
+        /*********************************************************
+         * Constructs a new solution from the specified solution.
+         *
+         * @param solution the solution to be moved.
+         *********************************************************/
+        Solution(Solution && solution);
+
+        /*************************************************************************************
+         * Assigns a copy of the specified solution to this solution. The values derived on
+         * first access are read atomically, as in the copy constructor.
+         *
+         * @param solution the solution to be copied.
+         *
+         * @return this solution.
+         *************************************************************************************/
+        Solution & operator = (const Solution & solution);
+
+        /*********************************************************
+         * Moves the specified solution into this solution.
+         *
+         * @param solution the solution to be moved.
+         *
+         * @return this solution.
+         *********************************************************/
+        Solution & operator = (Solution && solution);
+
         /************************************
          * Returns the instance been solved.
          *
          * @return the instance been solved.
          ************************************/
-        Instance getInstance() const;
+        const Instance & getInstance() const;
+
+        /*********************************************************
+         * Returns the shared handle of the instance been solved.
+         *
+         * @return the shared handle of the instance been solved.
+         *********************************************************/
+        const std::shared_ptr<const Instance> & getInstancePtr() const;
 
         /****************************************************
          * Returns the path of each vehicle.
          *
          * @return the path of each vehicle.
          ****************************************************/
-        std::vector<std::vector<unsigned>> getPaths() const;
+        const std::vector<std::vector<unsigned>> & getPaths() const;
 
         /*****************************************************
          * Returns the path of the specified vehicle.
@@ -192,14 +406,14 @@ class Solution {
          *
          * @return the path of the specified vehicle.
          *****************************************************/
-        std::vector<unsigned> getPath(unsigned k) const;
+        const std::vector<unsigned> & getPath(unsigned k) const;
 
         /*********************************************************
          * Returns the values of the decision variables x.
          *
          * @return the values of the decision variables x.
          *********************************************************/
-        std::vector<std::vector<std::vector<bool>>> getX() const;
+        const std::vector<std::vector<std::vector<bool>>> & getX() const;
 
         /************************************************************************************
          * Returns the values of the decision variable x associated with the edge (i, j) and
@@ -220,7 +434,7 @@ class Solution {
          *
          * @return the values of the decision variables y.
          **************************************************/
-        std::vector<std::vector<bool>> getY() const;
+        const std::vector<std::vector<bool>> & getY() const;
 
         /**************************************************************************************
          * Returns the values of the decision variable y associated with the request r and the
@@ -238,7 +452,7 @@ class Solution {
          *
          * @return the values of the decision variables t.
          **************************************************/
-        std::vector<std::vector<double>> getT() const;
+        const std::vector<std::vector<double>> & getT() const;
 
         /*************************************************************************************
          * Returns the values of the decision variable t associated with the vertex i and the
@@ -256,7 +470,7 @@ class Solution {
          *
          * @return the values of the decision variables l.
          **************************************************/
-        std::vector<std::vector<double>> getL() const;
+        const std::vector<std::vector<double>> & getL() const;
 
         /**************************************************************************************
          * Returns the values of the decision variables l associated with the vertex i and the
@@ -274,7 +488,7 @@ class Solution {
          *
          * @return the travelling time of each vehicle.
          ***********************************************/
-        std::vector<double> getTTravels() const;
+        const std::vector<double> & getTTravels() const;
 
         /****************************************************************
          * Returns the travelling time of the specified vehicle.
@@ -290,7 +504,7 @@ class Solution {
          *
          * @return the fulfill time of each request.
          ********************************************/
-        std::vector<double> getTFulfills() const;
+        const std::vector<double> & getTFulfills() const;
 
         /*************************************************************
          * Returns the fulfill time of the specified request.
@@ -320,9 +534,9 @@ class Solution {
          *
          * @return the load of each vehicle after serving each vertex in its path.
          **************************************************************************/
-        std::vector<std::vector<double>> getLoads() const;
+        const std::vector<std::vector<double>> & getLoads() const;
 
-        /**************************************************************************************
+        /***************************************************************************************
          * Returns the load of the specified vehicle after serving the specified vertex of its 
          * path.
          *
@@ -331,7 +545,7 @@ class Solution {
          *
          * @return the load of the specified vehicle after serving the specified vertex of its
          * path.
-         **************************************************************************************/
+         ***************************************************************************************/
         double getLoad(unsigned k, unsigned i) const;
 
         /****************************************************************
@@ -339,7 +553,7 @@ class Solution {
          *
          * @return the travelling time of each sub path of each vehicle.
          ****************************************************************/
-        std::vector<std::vector<double>> getTimes() const;
+        const std::vector<std::vector<double>> & getTimes() const;
 
         /*************************************************************************************
          * Returns the travelling time of the sub path of the specified vehicle ending at the
@@ -358,7 +572,7 @@ class Solution {
          *
          * @return the vehicle that fulfills each request.
          **************************************************/
-        std::vector<unsigned> getVehiclesR() const;
+        const std::vector<unsigned> & getVehiclesR() const;
 
         /***********************************************************
          * Returns the vehicle that fulfills the specified request.
@@ -374,7 +588,7 @@ class Solution {
          *
          * @return the vehicle that serves each vertex.
          ***********************************************/
-        std::vector<unsigned> getVehiclesV() const;
+        const std::vector<unsigned> & getVehiclesV() const;
 
         /********************************************************
          * Returns the vehicle that serves the specified vertex.
@@ -385,12 +599,47 @@ class Solution {
          ********************************************************/
         unsigned getVehicleV(unsigned v) const;
 
-        /********************************************************
-         * Returns the vehicle that traverses each edge.
+        /*******************************************************************
+         * Returns the vertex that follows each vertex in its path.
+         *
+         * @return the vertex that follows each vertex in its path.
+         *******************************************************************/
+        const std::vector<unsigned> & getSuccessors() const;
+
+        /******************************************************************************
+         * Returns the vertex that follows the specified vertex in its path.
+         *
+         * @param v the vertex whose successor is to be returned.
+         *
+         * @return the vertex that follows the specified vertex in its path, or |V| if
+         *         there is none.
+         ******************************************************************************/
+        unsigned getSuccessor(unsigned v) const;
+
+        /******************************************************************************
+         * Returns the index of each vertex in the path of the vehicle that serves it.
+         *
+         * @return the index of each vertex in the path of the vehicle that serves it.
+         ******************************************************************************/
+        const std::vector<unsigned> & getPositions() const;
+
+        /***************************************************************************************
+         * Returns the index of the specified vertex in the path of the vehicle that serves it.
+         *
+         * @param v the vertex whose index is to be returned.
+         *
+         * @return the index of the specified vertex in the path of the vehicle that serves
+         *         it.
+         ***************************************************************************************/
+        unsigned getPosition(unsigned v) const;
+
+        /***************************************************************************
+         * Returns the vehicle that traverses each edge, as a dense matrix computed
+         * on the first call.
          *
          * @return the vehicle that traverses each edge.
-         ********************************************************/
-        std::vector<std::vector<unsigned>> getVehiclesE() const;
+         ***************************************************************************/
+        const std::vector<std::vector<unsigned>> & getVehiclesE() const;
 
         /****************************************************************************
          * Returns the vehicle that serves the specified edge.
@@ -407,7 +656,7 @@ class Solution {
          *
          * @return the requests fulfilled by each vehicle.
          ***************************************************************/
-        std::vector<std::unordered_set<unsigned>> getRequestsK() const;
+        const std::vector<std::unordered_set<unsigned>> & getRequestsK() const;
 
         /********************************************************************
          * Returns the requests fulfilled by the specified vehicle.
@@ -416,14 +665,15 @@ class Solution {
          *
          * @return the requests fulfilled by the specified vehicle.
          ********************************************************************/
-        std::unordered_set<unsigned> getRequestsK(unsigned k) const;
+        const std::unordered_set<unsigned> & getRequestsK(unsigned k) const;
 
-        /********************************************************
-         * Returns the indexes of each vertex in each path.
+        /**************************************************************************
+         * Returns the indexes of each vertex in each path, as a dense matrix
+         * computed on the first call.
          *
          * @return the indices of each vertex in each path.
-         ********************************************************/
-        std::vector<std::vector<unsigned>> getIndexesKV() const;
+         **************************************************************************/
+        const std::vector<std::vector<unsigned>> & getIndexesKV() const;
 
         /**********************************************************************************
          * Returns the index of the specified vertex in the path of the specified vehicle.
@@ -435,6 +685,81 @@ class Solution {
          **********************************************************************************/
         unsigned getIndexKV(unsigned k, unsigned v) const;
 
+        /*****************************************************************************
+         * Returns the travelling time each vehicle can still spend within its limit.
+         *
+         * @return the travelling time each vehicle can still spend within its limit.
+         *****************************************************************************/
+        const std::vector<double> & getSlacks() const;
+
+        /*********************************************************************************
+         * Returns the travelling time the specified vehicle can still spend within its
+         * limit.
+         *
+         * @param k the vehicle whose slack is to be returned.
+         *
+         * @return the travelling time the specified vehicle can still spend within its
+         *         limit.
+         *********************************************************************************/
+        double getSlack(unsigned k) const;
+
+        /**************************************************************************************
+         * Returns the maximum load of the specified vehicle after serving each vertex between
+         * the specified positions of its path, in logarithmic time.
+         *
+         * @param k the vehicle whose load is to be returned.
+         * @param i the index of the first vertex.
+         * @param j the index of the last vertex, not less than i.
+         *
+         * @return the maximum load of the specified vehicle after serving the vertices i to
+         *         j of its path.
+         **************************************************************************************/
+        double getMaxLoad(unsigned k, unsigned i, unsigned j) const;
+
+        /***************************************************************************************
+         * Returns the hash of this solution, which is the same for solutions with the same
+         * paths and which the insertions update in O(1) time. Solutions with different paths
+         * have the same hash with probability 2^-64.
+         *
+         * @return the hash of this solution.
+         ***************************************************************************************/
+        uint64_t getHash() const;
+
+        /********************************************************************************
+         * Returns the random key of the specified arc in the path of the specified
+         * vehicle, from which the hashes of the solutions are built.
+         *
+         * @param k the vehicle whose path contains the arc.
+         * @param u the tail of the arc, or |V| for the virtual arc to the first vertex.
+         * @param v the head of the arc.
+         *
+         * @return the random key of the specified arc.
+         ********************************************************************************/
+        static uint64_t getArcKey(unsigned k, unsigned u, unsigned v);
+
+        /**************************************************************************************
+         * Evaluates, without going through the path, the insertion of the source of the
+         * specified request before the vertex i of the path of the specified vehicle and of
+         * its target before the vertex j, that is, the path
+         *
+         *     path[0..i - 1], sourceR, path[i..j - 1], targetR, path[j..]
+         *
+         * The changes of the objectives are exactly those of the solution built from the
+         * new paths. The insertion is feasible if the request is not served yet, the vehicle
+         * can serve it, and the new path is valid provided that the requests already in the
+         * path are served in order. An insertion with positions out of 1 <= i <= j < |path|
+         * is infeasible and changes nothing.
+         *
+         * @param r the request to be inserted.
+         * @param k the vehicle whose path receives the request.
+         * @param i the index of the vertex before which the source is inserted.
+         * @param j the index of the vertex before which the target is inserted.
+         *
+         * @return the changes of the objectives, whether the insertion is feasible and the
+         *         hash of the solution after it.
+         **************************************************************************************/
+        Insertion evaluateInsertion(unsigned r, unsigned k, unsigned i, unsigned j) const;
+
         /*******************************************************************************
          * Verifies whether the path of the specified vehicle is valid.
          *
@@ -470,13 +795,18 @@ class Solution {
          **************************************************************/
         bool isFeasible() const;
 
-        /****************************************************************************
+        /**************************************************************************************
          * Verifies whether this solutions satisfies all constraints.
          *
+         * The constraints are derived from the paths, in time linear in their length and in
+         * the number of requests, unless the decision variables were given or a vertex is in
+         * more than one position of the paths, in which case the decision variables are
+         * verified. Either way, the error code is that of areDecisionVariablesSatisfied.
+         *
          * @param error the error code.
          *
          * @return true if this instance satisfies all constraints; false otherwise.
-         ****************************************************************************/
+         **************************************************************************************/
         bool areConstraintsSatisfied(unsigned & error) const;
 
         /****************************************************************************
@@ -486,6 +816,16 @@ class Solution {
          ****************************************************************************/
         bool areConstraintsSatisfied() const;
 
+        /*************************************************************************************
+         * Verifies whether the decision variables of this solution satisfy all constraints,
+         * going through every pair of vertices for every vehicle.
+         *
+         * @param error the number of the first constraint not satisfied.
+         *
+         * @return true if the decision variables satisfy all constraints; false otherwise.
+         *************************************************************************************/
+        bool areDecisionVariablesSatisfied(unsigned & error) const;
+
         /********************************************************
          * Write this solution into the specified output stream.
          *
@@ -3,7 +3,7 @@
 #include <cfloat>
 #include <limits>
 
-void SolutionSet::sort() {
+void SolutionSet::sort() const {
     // non-dominated sorting
     std::vector<std::vector<std::pair<Solution, unsigned>>> frontsAux(1);
     std::vector<std::pair<Solution, unsigned>> solutionsVector;
@@ -128,6 +128,12 @@ void SolutionSet::sort() {
         }
     }
 
+    this->sorted = true;
+}
+
+void SolutionSet::reduce() {
+    this->sort();
+
     while(this->solutions.size() > this->maxSize) {
         if(this->fronts.empty()) {
             break;
@@ -139,19 +145,33 @@ void SolutionSet::sort() {
 
         auto solution = this->fronts.back().back();
         this->fronts.back().pop_back();
-        this->solutions.erase(solution);
+
+        if(this->solutions.erase(solution) > 0) {
+            this->hashes.erase(solution.getHash());
+        }
     }
+}
 
-    this->sorted = true;
+bool SolutionSet::add(const Solution & solution) {
+    // a solution with the same hash has the same paths, but for a 2^-64 chance
+    if(!this->hashes.insert(solution.getHash()).second) {
+        return false;
+    }
+
+    if(!this->solutions.insert(solution).second) {
+        this->hashes.erase(solution.getHash());
+        return false;
+    }
+
+    this->sorted = false;
+
+    return true;
 }
 
 SolutionSet::SolutionSet(unsigned maxSize, const std::set<Solution> & solutions) :
     maxSize(maxSize),
-    solutions(solutions),
     sorted(false) {
-    if(this->solutions.size() > this->maxSize) {
-        this->sort();
-    }
+    this->insert(solutions);
 }
 
 SolutionSet::SolutionSet(unsigned maxSize) : 
@@ -166,11 +186,11 @@ unsigned SolutionSet::getMaxSize() const {
     return this->maxSize;
 }
 
-std::set<Solution> SolutionSet::getSolutions() const {
+const std::set<Solution> & SolutionSet::getSolutions() const {
     return this->solutions;
 }
 
-std::vector<std::vector<Solution>> SolutionSet::getFronts() {
+const std::vector<std::vector<Solution>> & SolutionSet::getFronts() const {
     if(!this->sorted) {
         this->sort();
     }
@@ -178,7 +198,7 @@ std::vector<std::vector<Solution>> SolutionSet::getFronts() {
     return this->fronts;
 }
 
-std::vector<Solution> SolutionSet::getFront(unsigned f) {
+const std::vector<Solution> & SolutionSet::getFront(unsigned f) const {
     if(!this->sorted) {
         this->sort();
     }
@@ -186,7 +206,7 @@ std::vector<Solution> SolutionSet::getFront(unsigned f) {
     return this->fronts[f];
 }
 
-std::vector<double> SolutionSet::getMinTotalProfitsF() {
+const std::vector<double> & SolutionSet::getMinTotalProfitsF() const {
     if(!this->sorted) {
         this->sort();
     }
@@ -194,7 +214,7 @@ std::vector<double> SolutionSet::getMinTotalProfitsF() {
     return this->minTotalProfitsF;
 }
 
-double SolutionSet::getMinTotalProfitF(unsigned f) {
+double SolutionSet::getMinTotalProfitF(unsigned f) const {
     if(!this->sorted) {
         this->sort();
     }
@@ -202,7 +222,7 @@ double SolutionSet::getMinTotalProfitF(unsigned f) {
     return this->minTotalProfitsF[f];
 }
 
-std::vector<double> SolutionSet::getMaxTotalProfitsF() {
+const std::vector<double> & SolutionSet::getMaxTotalProfitsF() const {
     if(!this->sorted) {
         this->sort();
     }
@@ -210,7 +230,7 @@ std::vector<double> SolutionSet::getMaxTotalProfitsF() {
     return this->maxTotalProfitsF;
 }
 
-double SolutionSet::getMaxTotalProfitF(unsigned f) {
+double SolutionSet::getMaxTotalProfitF(unsigned f) const {
     if(!this->sorted) {
         this->sort();
     }
@@ -218,7 +238,7 @@ double SolutionSet::getMaxTotalProfitF(unsigned f) {
     return this->maxTotalProfitsF[f];
 }
 
-std::vector<double> SolutionSet::getMinSumTFulfillsF() {
+const std::vector<double> & SolutionSet::getMinSumTFulfillsF() const {
     if(!this->sorted) {
         this->sort();
     }
@@ -226,7 +246,7 @@ std::vector<double> SolutionSet::getMinSumTFulfillsF() {
     return this->minSumTFulfillsF;
 }
 
-double SolutionSet::getMinSumTFulfillF(unsigned f) {
+double SolutionSet::getMinSumTFulfillF(unsigned f) const {
     if(!this->sorted) {
         this->sort();
     }
@@ -234,7 +254,7 @@ double SolutionSet::getMinSumTFulfillF(unsigned f) {
     return this->minSumTFulfillsF[f];
 }
 
-std::vector<double> SolutionSet::getMaxSumTFulfillsF() {
+const std::vector<double> & SolutionSet::getMaxSumTFulfillsF() const {
     if(!this->sorted) {
         this->sort();
     }
@@ -242,7 +262,7 @@ std::vector<double> SolutionSet::getMaxSumTFulfillsF() {
     return this->maxSumTFulfillsF;
 }
 
-double SolutionSet::getMaxSumTFulfillF(unsigned f) {
+double SolutionSet::getMaxSumTFulfillF(unsigned f) const {
     if(!this->sorted) {
         this->sort();
     }
@@ -250,21 +270,23 @@ double SolutionSet::getMaxSumTFulfillF(unsigned f) {
     return this->maxSumTFulfillsF[f];
 }
 
-void SolutionSet::insert(const Solution & solution) {
-    this->solutions.insert(solution);
-    this->sorted = false;
+unsigned SolutionSet::size() const {
+    return this->solutions.size();
+}
 
-    if(this->solutions.size() > this->maxSize) {
-        this->sort();
+void SolutionSet::insert(const Solution & solution) {
+    if(this->add(solution) && this->solutions.size() > this->maxSize) {
+        this->reduce();
     }
 }
 
 void SolutionSet::insert(const std::set<Solution> & solutions) {
-    this->solutions.insert(solutions.begin(), solutions.end());
-    this->sorted = false;
+    for(const Solution & solution : solutions) {
+        this->add(solution);
+    }
 
     if(this->solutions.size() > this->maxSize) {
-        this->sort();
+        this->reduce();
     }
 }
 
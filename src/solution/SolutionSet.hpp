@@ -2,6 +2,7 @@
 
 #include "Solution.hpp"
 #include <set>
+#include <unordered_set>
 
 /***************************************************************
  * The SolutionsSet class represents a set of MVRPPD solutions.
@@ -18,40 +19,62 @@ class SolutionSet {
          *****************************/
         std::set<Solution> solutions;
 
+        /***************************************************************************
+         * The hashes of the solutions, through which the duplicates are rejected
+         * without comparing their paths.
+         ***************************************************************************/
+        std::unordered_set<uint64_t> hashes;
+
         /******************************************
          * The fronts of non-dominated solutions.
          ******************************************/
-        std::vector<std::vector<Solution>> fronts;
+        mutable std::vector<std::vector<Solution>> fronts;
 
         /******************************************
          * The minimum total profit of each front.
          ******************************************/
-        std::vector<double> minTotalProfitsF;
+        mutable std::vector<double> minTotalProfitsF;
 
         /******************************************
          * The maximum total profit of each front.
          ******************************************/
-        std::vector<double> maxTotalProfitsF;
+        mutable std::vector<double> maxTotalProfitsF;
 
         /*****************************************************
          * The minimum sum of the fulfill time of each front.
          *****************************************************/
-        std::vector<double> minSumTFulfillsF;
+        mutable std::vector<double> minSumTFulfillsF;
 
         /*****************************************************
          * The maximum sum of the fulfill time of each front.
          *****************************************************/
-        std::vector<double> maxSumTFulfillsF;
+        mutable std::vector<double> maxSumTFulfillsF;
 
         /****************************************************
          * Flag indicating whether the solutions are sorted.
          ****************************************************/
-        bool sorted;
+        mutable bool sorted;
 
         /**********************
          * Sort the solutions.
          **********************/
-        void sort();
+        void sort() const;
+
+        /**********************************************************************************
+         * Removes the most crowded solutions of the last fronts until the maximum size is
+         * respected.
+         **********************************************************************************/
+        void reduce();
+
+        /***********************************************************************************
+         * Adds the specified solution, unless a solution with the same hash is already in
+         * the set, without respecting the maximum size.
+         *
+         * @param solution the solution to be added.
+         *
+         * @return true if the solution was added; false otherwise.
+         ***********************************************************************************/
+        bool add(const Solution & solution);
 
     public:
         /********************************************************************
@@ -86,14 +109,14 @@ class SolutionSet {
          *
          * @return the set of solutions.
          ****************************************/
-        std::set<Solution> getSolutions() const;
+        const std::set<Solution> & getSolutions() const;
 
         /*****************************************************
          * Returns the fronts.
          *
          * @return the fronts.
          *****************************************************/
-        std::vector<std::vector<Solution>> getFronts();
+        const std::vector<std::vector<Solution>> & getFronts() const;
 
         /*************************************************
          * Returns the f-th front.
@@ -102,14 +125,14 @@ class SolutionSet {
          *
          * @return the f-th front.
          *************************************************/
-        std::vector<Solution> getFront(unsigned f);
+        const std::vector<Solution> & getFront(unsigned f) const;
 
         /**************************************************
          * Returns the minimum total profit of each front.
          *
          * @return the minimum total profit of each front.
          **************************************************/
-        std::vector<double> getMinTotalProfitsF();
+        const std::vector<double> & getMinTotalProfitsF() const;
 
         /*******************************************************************
          * Returns the minimum total profit of the specified front.
@@ -118,14 +141,14 @@ class SolutionSet {
          *
          * @return the minimum total profit of the specified front.
          *******************************************************************/
-        double getMinTotalProfitF(unsigned f);
+        double getMinTotalProfitF(unsigned f) const;
 
         /**************************************************
          * Returns the maximum total profit of each front.
          *
          * @return the maximum total profit of each front.
          **************************************************/
-        std::vector<double> getMaxTotalProfitsF();
+        const std::vector<double> & getMaxTotalProfitsF() const;
 
         /*******************************************************************
          * Returns the maximum total profit of the specified front.
@@ -134,14 +157,14 @@ class SolutionSet {
          *
          * @return the maximum total profit of the specified front.
          *******************************************************************/
-        double getMaxTotalProfitF(unsigned f);
+        double getMaxTotalProfitF(unsigned f) const;
 
         /*************************************************************
          * Returns the minimum sum of the fulfill time of each front.
          *
          * @return the minimum sum of the fulfill time of each front.
          *************************************************************/
-        std::vector<double> getMinSumTFulfillsF();
+        const std::vector<double> & getMinSumTFulfillsF() const;
 
         /******************************************************************************
          * Returns the minimum sum of the fulfill time of the specified front.
@@ -150,14 +173,14 @@ class SolutionSet {
          *
          * @return the minimum sum of the fulfill time of the specified front.
          ******************************************************************************/
-        double getMinSumTFulfillF(unsigned f);
+        double getMinSumTFulfillF(unsigned f) const;
 
         /*************************************************************
          * Returns the maximum sum of the fulfill time of each front.
          *
          * @return the maximum sum of the fulfill time of each front.
          *************************************************************/
-        std::vector<double> getMaxSumTFulfillsF();
+        const std::vector<double> & getMaxSumTFulfillsF() const;
 
         /******************************************************************************
          * Returns the maximum sum of the fulfill time of the specified front.
@@ -166,7 +189,7 @@ class SolutionSet {
          *
          * @return the maximum sum of the fulfill time of the specified front.
          ******************************************************************************/
-        double getMaxSumTFulfillF(unsigned f);
+        double getMaxSumTFulfillF(unsigned f) const;
 
         /********************************
          * Returns the size of this set.
@@ -176,14 +199,16 @@ class SolutionSet {
         unsigned size() const;
 
         /**************************************************
-         * Inserts the specified solutions.
+         * Inserts the specified solutions, except those
+         * with the same hash as a solution in the set.
          *
          * @param solutions the solutions to be inserted.
          **************************************************/
         void insert(const std::set<Solution> & solutions);
 
         /***********************************************
-         * Inserts the specifies solution.
+         * Inserts the specified solution, unless a
+         * solution with the same hash is in the set.
          *
          * @param solution the solution to be inserted.
          ***********************************************/
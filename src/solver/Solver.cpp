@@ -1,9 +1,8 @@
 #include "Solver.hpp"
+#include "../instance/CompressedStream.hpp"
 
-#include <fstream>
-
-Solver::Solver(const Instance & instance, unsigned timeLimit, unsigned seed, 
-        unsigned maxNumSolutions) : 
+Solver::Solver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+        unsigned seed, unsigned maxNumSolutions) : 
     instance(instance), 
     timeLimit(timeLimit), 
     seed(seed),
@@ -11,16 +10,30 @@ Solver::Solver(const Instance & instance, unsigned timeLimit, unsigned seed,
     solvingTime(0),
     solutionSet(maxNumSolutions) {}
 
+Solver::Solver(const Instance & instance, unsigned timeLimit, unsigned seed, 
+        unsigned maxNumSolutions) : 
+    Solver::Solver(std::make_shared<const Instance>(instance), timeLimit, seed,
+            maxNumSolutions) {}
 
-Solver::Solver(const Instance & instance, unsigned timeLimit, unsigned seed) :
-    Solver::Solver(instance, timeLimit, seed, 2 * instance.getNumVertices()) {}
+Solver::Solver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+        unsigned seed) :
+    Solver::Solver(instance, timeLimit, seed, 2 * instance->getNumVertices()) {}
 
+Solver::Solver(const Instance & instance, unsigned timeLimit, unsigned seed) :
+    Solver::Solver(std::make_shared<const Instance>(instance), timeLimit, seed) {}
 
-Solver::Solver(const Instance & instance, unsigned timeLimit) : 
+Solver::Solver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit) : 
     Solver::Solver(instance, timeLimit, 
             std::chrono::system_clock::now().time_since_epoch().count()) {}
 
-Solver::Solver(const Instance & instance) : Solver::Solver(instance, 3600) {}
+Solver::Solver(const Instance & instance, unsigned timeLimit) : 
+    Solver::Solver(std::make_shared<const Instance>(instance), timeLimit) {}
+
+Solver::Solver(const std::shared_ptr<const Instance> & instance) :
+    Solver::Solver(instance, 3600) {}
+
+Solver::Solver(const Instance & instance) :
+    Solver::Solver(std::make_shared<const Instance>(instance)) {}
 
 Solver::Solver() : Solver::Solver(Instance(), 0) {}
 
@@ -32,8 +45,8 @@ bool Solver::areTerminationCriteriaMet() const {
     return false;
 }
 
-Instance Solver::getInstance() const {
-    return this->instance;
+const Instance & Solver::getInstance() const {
+    return *this->instance;
 }
 
 unsigned Solver::getMaxNumSolutions() const {
@@ -44,7 +57,7 @@ unsigned Solver::getSolvingTime() const {
     return this->solvingTime;
 }
 
-SolutionSet Solver::getSolutionSet() const {
+const SolutionSet & Solver::getSolutionSet() const {
     return this->solutionSet;
 }
 
@@ -81,15 +94,10 @@ void Solver::write(std::ostream & os) const {
 }
 
 void Solver::write(const char * filename) const {
-    std::ofstream ofs;
-    ofs.open(filename);
-
-    if(ofs.is_open()) {
-        this->write(ofs);
-        ofs.close();
-    } else {
-        throw "File not created.";
-    }
+    CompressedOutputStream os(filename);
+
+    this->write(os);
+    os.close();
 }
 
 void Solver::write(const std::string & filename) const {
@@ -12,7 +12,7 @@ class Solver {
         /*****************************
          * The instance to be solved.
          *****************************/
-        Instance instance;
+        std::shared_ptr<const Instance> instance;
 
         /*****************************
          * The time limit in seconds.
@@ -65,6 +65,17 @@ class Solver {
          * @param seed            the  seed for the pseudo-random numbers generator.
          * @param maxNumSolutions the maximum number of solutions
          ***********************************************************************************************/
+        Solver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit, unsigned seed,
+                unsigned maxNumSolutions);
+
+        /***********************************************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance        the instance to be solved.
+         * @param timeLimit       the time limit in seconds.
+         * @param seed            the  seed for the pseudo-random numbers generator.
+         * @param maxNumSolutions the maximum number of solutions
+         ***********************************************************************************************/
         Solver(const Instance & instance, unsigned timeLimit, unsigned seed, unsigned maxNumSolutions);
 
         /**********************************************************************
@@ -74,6 +85,15 @@ class Solver {
          * @param timeLimit the time limit in seconds.
          * @param seed      the  seed for the pseudo-random numbers generator.
          **********************************************************************/
+        Solver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit, unsigned seed);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         * @param seed      the  seed for the pseudo-random numbers generator.
+         ***********************************************************************/
         Solver(const Instance & instance, unsigned timeLimit, unsigned seed);
 
         /******************************************************
@@ -82,6 +102,14 @@ class Solver {
          * @param instance  the instance to be solved.
          * @param timeLimit the time limit in seconds.
          ******************************************************/
+        Solver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         ***********************************************************************/
         Solver(const Instance & instance, unsigned timeLimit);
 
         /*********************************************
@@ -89,6 +117,13 @@ class Solver {
          *
          * @param instance the instance to be solved.
          *********************************************/
+        Solver(const std::shared_ptr<const Instance> & instance);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance the instance to be solved.
+         ***********************************************************************/
         Solver(const Instance & instance);
 
         /******************************
@@ -101,7 +136,7 @@ class Solver {
          *
          * @return the instance to be solved.
          *************************************/
-        Instance getInstance() const;
+        const Instance & getInstance() const;
 
         /*******************************************
          * Returns the maximum number of solutions.
@@ -122,7 +157,7 @@ class Solver {
          *
          * @return the set solutions found.
          ***********************************/
-        SolutionSet getSolutionSet() const;
+        const SolutionSet & getSolutionSet() const;
 
         /*****************************************************************************************
          * Returns the elapsed time.
@@ -16,6 +16,17 @@ class BnBSolver : public Solver {
          * @param seed            the  seed for the pseudo-random numbers generator.
          * @param maxNumSolutions the maximum number of solutions
          ****************************************************************************/
+        BnBSolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+                unsigned seed, unsigned maxNumSolutions);
+
+        /****************************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance        the instance to be solved.
+         * @param timeLimit       the time limit in seconds.
+         * @param seed            the  seed for the pseudo-random numbers generator.
+         * @param maxNumSolutions the maximum number of solutions
+         ****************************************************************************/
         BnBSolver(const Instance & instance, unsigned timeLimit, unsigned seed,
                 unsigned maxNumSolutions);
 
@@ -26,6 +37,16 @@ class BnBSolver : public Solver {
          * @param timeLimit the time limit in seconds.
          * @param seed      the  seed for the pseudo-random numbers generator.
          ************************************************************************/
+        BnBSolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+                unsigned seed);
+
+        /************************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         * @param seed      the  seed for the pseudo-random numbers generator.
+         ************************************************************************/
         BnBSolver(const Instance & instance, unsigned timeLimit, unsigned seed);
 
         /*********************************************************
@@ -34,6 +55,14 @@ class BnBSolver : public Solver {
          * @param instance  the instance to be solved.
          * @param timeLimit the time limit in seconds.
          *********************************************************/
+        BnBSolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         ***********************************************************************/
         BnBSolver(const Instance & instance, unsigned timeLimit);
 
         /*********************************************
@@ -41,6 +70,13 @@ class BnBSolver : public Solver {
          *
          * @param instance the instance to be solved.
          *********************************************/
+        BnBSolver(const std::shared_ptr<const Instance> & instance);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance the instance to be solved.
+         ***********************************************************************/
         BnBSolver(const Instance & instance);
 
         /******************************
@@ -1,10 +1,11 @@
 #include "BnBSolverCallback.hpp"
 
-BnBSolverCallback::BnBSolverCallback(const Instance & instance,
-        const std::vector<std::vector<std::vector<GRBVar>>> & x,
+BnBSolverCallback::BnBSolverCallback(const std::shared_ptr<const Instance> & instance,
+        const ArcFilter & arcFilter, const std::vector<std::vector<std::vector<GRBVar>>> & x,
         const std::vector<std::vector<GRBVar>> & y, const std::vector<std::vector<GRBVar>> & t,
         const std::vector<std::vector<GRBVar>> & l, const std::list<double> minTotalProfits) :
     instance(instance), 
+    arcFilter(arcFilter), 
     x(x), 
     y(y), 
     t(t), 
@@ -14,19 +15,19 @@ BnBSolverCallback::BnBSolverCallback(const Instance & instance,
 void BnBSolverCallback::callback() {
     try {
         if(this->where == GRB_CB_MIPSOL) {
-            std::vector<std::vector<std::vector<bool>>> xAux(this->instance.getNumVertices(),
-                    std::vector<std::vector<bool>>(this->instance.getNumVertices(),
-                        std::vector<bool>(this->instance.getNumVehicles(), false)));
-            std::vector<std::vector<bool>> yAux(this->instance.getNumRequests(),
-                    std::vector<bool>(this->instance.getNumVehicles(), false));
-            std::vector<std::vector<double>> tAux(this->instance.getNumVertices(),
-                    std::vector<double>(this->instance.getNumVehicles(), 0.0));
-            std::vector<std::vector<double>> lAux(this->instance.getNumVertices(),
-                    std::vector<double>(this->instance.getNumVehicles(), 0.0));
+            std::vector<std::vector<std::vector<bool>>> xAux(this->instance->getNumVertices(),
+                    std::vector<std::vector<bool>>(this->instance->getNumVertices(),
+                        std::vector<bool>(this->instance->getNumVehicles(), false)));
+            std::vector<std::vector<bool>> yAux(this->instance->getNumRequests(),
+                    std::vector<bool>(this->instance->getNumVehicles(), false));
+            std::vector<std::vector<double>> tAux(this->instance->getNumVertices(),
+                    std::vector<double>(this->instance->getNumVehicles(), 0.0));
+            std::vector<std::vector<double>> lAux(this->instance->getNumVertices(),
+                    std::vector<double>(this->instance->getNumVehicles(), 0.0));
 
-            for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
-                    for(unsigned j = 0; j < this->instance.getNumVertices(); j++) {
+            for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
+                    for(unsigned j : this->arcFilter.getSuccessors(i, k)) {
                         if(this->getSolution(this->x[i][j][k]) >= 0.5) {
                             xAux[i][j][k] = true;
                         }
@@ -34,27 +35,27 @@ void BnBSolverCallback::callback() {
                 }
             }
 
-            for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
+            for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
                     if(this->getSolution(this->y[r][k]) >= 0.5) {
                         yAux[r][k] = true;
                     }
                 }
             }
 
-            for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
+            for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
                     tAux[i][k] = this->getSolution(this->t[i][k]);
                 }
             }
 
-            for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                for(unsigned i = 0; i < this->instance.getNumVertices(); i++) {
+            for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                for(unsigned i = 0; i < this->instance->getNumVertices(); i++) {
                     lAux[i][k] = this->getSolution(this->l[i][k]);
                 }
             }
 
-            Solution solution (instance, xAux, yAux, tAux, lAux);
+            Solution solution (this->instance, xAux, yAux, tAux, lAux);
 
             this->solutions.push_back(solution);
 
@@ -66,9 +67,9 @@ void BnBSolverCallback::callback() {
             if(!this->minTotalProfits.empty()) {
                 GRBLinExpr lhs = 0.0;
 
-                for(unsigned k = 0; k < this->instance.getNumVehicles(); k++) {
-                    for(unsigned r = 0; r < this->instance.getNumRequests(); r++) {
-                        lhs += this->instance.getProfit(r) * this->y[r][k];
+                for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+                    for(unsigned r = 0; r < this->instance->getNumRequests(); r++) {
+                        lhs += this->instance->getProfit(r) * this->y[r][k];
                     }
                 }
 
@@ -83,7 +84,7 @@ void BnBSolverCallback::callback() {
     }
 }
 
-std::vector<Solution> BnBSolverCallback::getSolutions() const {
+const std::vector<Solution> & BnBSolverCallback::getSolutions() const {
     return this->solutions;
 }
 
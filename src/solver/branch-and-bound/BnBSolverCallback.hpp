@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../instance/ArcFilter.hpp"
 #include "../../solution/Solution.hpp"
 #include "gurobi_c++.h"
 #include <list>
@@ -13,7 +14,12 @@ class BnBSolverCallback : public GRBCallback {
         /****************************
          * The instance been solved.
          ****************************/
-        Instance instance;
+        std::shared_ptr<const Instance> instance;
+
+        /************************************************************
+         * The arcs whose x decision variables have been created.
+         ************************************************************/
+        const ArcFilter & arcFilter;
 
         /************************************************
          * The x decision variables.
@@ -52,23 +58,25 @@ class BnBSolverCallback : public GRBCallback {
         void callback();
 
     public:
-        /****************************************************************
+        /********************************************************************************
          * Constructs a new callback.
          *
          * @param instance        the instance been solved.
+         * @param arcFilter       the arcs whose x decision variables have been created.
          * @param x               the x decision variables.
          * @param y               the y decision variables.
          * @param t               the t decision variables.
          * @param l               the l decision variables.
          * @param minTotalProfits the minimum total profits.
-         ****************************************************************/
-        BnBSolverCallback(const Instance & instance, 
+         ********************************************************************************/
+        BnBSolverCallback(const std::shared_ptr<const Instance> & instance, 
+                const ArcFilter & arcFilter,
                 const std::vector<std::vector<std::vector<GRBVar>>> & x, 
                 const std::vector<std::vector<GRBVar>> & y, 
                 const std::vector<std::vector<GRBVar>> & t, 
                 const std::vector<std::vector<GRBVar>> & l, 
                 const std::list<double> minTotalProfits);
 
-        std::vector<Solution> getSolutions() const;
+        const std::vector<Solution> & getSolutions() const;
 };
 
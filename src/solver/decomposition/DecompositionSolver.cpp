@@ -0,0 +1,201 @@
+#include "DecompositionSolver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/********************************************************************************
+ * The Combination struct represents one solution of each of the first clusters.
+ ********************************************************************************/
+struct Combination {
+    /*******************************************
+     * The total profit of the solutions.
+     *******************************************/
+    double totalProfit;
+
+    /*******************************************************
+     * The sum of the fulfillment times of the solutions.
+     *******************************************************/
+    double sumTFulfill;
+
+    /***********************************************************
+     * The index of the solution of each cluster in its front.
+     ***********************************************************/
+    std::vector<unsigned> solutions;
+};
+
+DecompositionSolver::DecompositionSolver(const std::shared_ptr<const Instance> & instance,
+        unsigned numClusters, unsigned numThreads, const SubSolverFactory & subSolverFactory,
+        unsigned timeLimit, unsigned seed, unsigned maxNumSolutions) :
+    Solver::Solver(instance, timeLimit, seed, maxNumSolutions),
+    numClusters(numClusters),
+    numThreads(numThreads),
+    subSolverFactory(subSolverFactory) {}
+
+DecompositionSolver::DecompositionSolver(const Instance & instance, unsigned numClusters,
+        unsigned numThreads, const SubSolverFactory & subSolverFactory, unsigned timeLimit,
+        unsigned seed, unsigned maxNumSolutions) :
+    DecompositionSolver::DecompositionSolver(std::make_shared<const Instance>(instance),
+            numClusters, numThreads, subSolverFactory, timeLimit, seed, maxNumSolutions) {}
+
+DecompositionSolver::DecompositionSolver() : Solver::Solver(), numClusters(1), numThreads(1) {}
+
+const Decomposition & DecompositionSolver::getDecomposition() const {
+    return this->decomposition;
+}
+
+const SolutionSet & DecompositionSolver::getClusterSolutionSet(unsigned c) const {
+    return this->solutionSetsC[c];
+}
+
+void DecompositionSolver::solveClusters() {
+    this->startTime = std::chrono::steady_clock::now();
+    this->decomposition = Decomposition(this->instance, this->numClusters);
+
+    unsigned numClusters = this->decomposition.getNumClusters();
+    unsigned numThreads = this->numThreads == 0 ? std::thread::hardware_concurrency() :
+        this->numThreads;
+
+    numThreads = std::min(std::max(numThreads, 1u), numClusters);
+
+    std::atomic<unsigned> nextCluster(0);
+    std::vector<std::thread> threads;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    this->solutionSetsC = std::vector<SolutionSet>(numClusters,
+            SolutionSet(this->maxNumSolutions));
+
+    // each thread solves the next cluster left until there is none, and the first exception
+    // of a sub-solver stops every thread and is rethrown once they are joined
+    auto solve = [&]() {
+        try {
+            for(unsigned c = nextCluster++; c < numClusters; c = nextCluster++) {
+                // the remaining time is shared among the waves of clusters left, so that the
+                // first clusters do not exhaust the time of the last ones
+                unsigned elapsedTime = this->getElapsedTime();
+                unsigned remainingTime = elapsedTime < this->timeLimit ?
+                    this->timeLimit - elapsedTime : 0;
+                unsigned numWaves = (numClusters - c + numThreads - 1) / numThreads;
+                unsigned timeLimit = (remainingTime + numWaves - 1) / numWaves;
+                std::unique_ptr<Solver> solver = this->subSolverFactory(
+                        this->decomposition.getSubInstance(c), timeLimit, this->seed + c,
+                        this->maxNumSolutions);
+
+                solver->solve();
+                this->solutionSetsC[c] = solver->getSolutionSet();
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+
+            if(!exception) {
+                exception = std::current_exception();
+            }
+
+            nextCluster = numClusters;
+        }
+    };
+
+    for(unsigned i = 1; i < numThreads; i++) {
+        threads.push_back(std::thread(solve));
+    }
+
+    solve();
+
+    for(std::thread & thread : threads) {
+        thread.join();
+    }
+
+    if(exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void DecompositionSolver::merge() {
+    unsigned numClusters = this->decomposition.getNumClusters();
+    std::vector<std::vector<Solution>> fronts(numClusters);
+    std::vector<Combination> combinations(1, Combination{0.0, 0.0, {}});
+
+    for(unsigned c = 0; c < numClusters; c++) {
+        const std::shared_ptr<const Instance> & subInstance =
+            this->decomposition.getSubInstance(c);
+
+        // a cluster without solutions leaves its vehicles idle
+        if(this->solutionSetsC[c].size() > 0) {
+            fronts[c] = this->solutionSetsC[c].getFront(0);
+        } else {
+            std::vector<std::vector<unsigned>> paths(subInstance->getNumVehicles());
+
+            for(unsigned k = 0; k < subInstance->getNumVehicles(); k++) {
+                paths[k] = {subInstance->getSourceK(k), subInstance->getTargetK(k)};
+            }
+
+            fronts[c].push_back(Solution(subInstance, paths));
+        }
+
+        std::vector<Combination> nextCombinations;
+
+        for(const Combination & combination : combinations) {
+            for(unsigned i = 0; i < fronts[c].size(); i++) {
+                Combination nextCombination = combination;
+
+                nextCombination.totalProfit += fronts[c][i].getTotalProfit();
+                nextCombination.sumTFulfill += fronts[c][i].getSumTFulfill();
+                nextCombination.solutions.push_back(i);
+                nextCombinations.push_back(nextCombination);
+            }
+        }
+
+        // keep the non-dominated combinations, then thin them out evenly
+        std::sort(nextCombinations.begin(), nextCombinations.end(),
+                [](const Combination & a, const Combination & b) {
+            return a.totalProfit > b.totalProfit ||
+                (a.totalProfit == b.totalProfit && a.sumTFulfill < b.sumTFulfill);
+        });
+
+        combinations.clear();
+
+        for(const Combination & combination : nextCombinations) {
+            if(combinations.empty() || combination.sumTFulfill < combinations.back().sumTFulfill) {
+                combinations.push_back(combination);
+            }
+        }
+
+        if(combinations.size() > this->maxNumSolutions) {
+            std::vector<Combination> thinnedCombinations;
+
+            for(unsigned i = 0; i < this->maxNumSolutions; i++) {
+                std::size_t j = this->maxNumSolutions == 1 ? 0 :
+                    (std::size_t) i * (combinations.size() - 1) / (this->maxNumSolutions - 1);
+
+                thinnedCombinations.push_back(combinations[j]);
+            }
+
+            combinations = thinnedCombinations;
+        }
+    }
+
+    for(const Combination & combination : combinations) {
+        std::vector<std::vector<unsigned>> paths(this->instance->getNumVehicles());
+
+        for(unsigned k = 0; k < this->instance->getNumVehicles(); k++) {
+            paths[k] = {this->instance->getSourceK(k), this->instance->getTargetK(k)};
+        }
+
+        for(unsigned c = 0; c < numClusters; c++) {
+            this->decomposition.toGlobal(c, fronts[c][combination.solutions[c]].getPaths(),
+                    paths);
+        }
+
+        this->solutionSet.insert(Solution(this->instance, paths));
+    }
+}
+
+void DecompositionSolver::solve() {
+    this->solveClusters();
+    this->merge();
+
+    this->solvingTime = this->getElapsedTime();
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../Solver.hpp"
+#include "../../instance/Decomposition.hpp"
+#include <functional>
+#include <memory>
+
+/*********************************************************************************************
+ * The SubSolverFactory type represents a function that constructs the solver of a cluster
+ * from its sub-instance, time limit, seed and maximum number of solutions.
+ *********************************************************************************************/
+typedef std::function<std::unique_ptr<Solver>(const std::shared_ptr<const Instance> & instance,
+        unsigned timeLimit, unsigned seed, unsigned maxNumSolutions)> SubSolverFactory;
+
+/*********************************************************************************************
+ * The DecompositionSolver class represents a solver for large MVRPPD instances that splits
+ * the instance into geographic clusters, solves the sub-instance of each cluster with its
+ * own solver on a separate thread, and merges the first fronts of the clusters. Since the
+ * clusters share no request nor vehicle, the total profit and the sum of the fulfillment
+ * times of a combination of solutions, one per cluster, are the sums of theirs, so the
+ * fronts are merged one cluster at a time keeping only the non-dominated combinations, up
+ * to the maximum number of solutions. The routes of the combinations kept are then joined
+ * into solutions of the instance.
+ *********************************************************************************************/
+class DecompositionSolver : public Solver {
+    private:
+        /*******************************
+         * The number of clusters.
+         *******************************/
+        unsigned numClusters;
+
+        /***************************************************************************
+         * The maximum number of clusters solved at once, or 0 to use every core.
+         ***************************************************************************/
+        unsigned numThreads;
+
+        /***********************************************************
+         * The function that constructs the solver of each cluster.
+         ***********************************************************/
+        SubSolverFactory subSolverFactory;
+
+        /*************************************
+         * The decomposition of the instance.
+         *************************************/
+        Decomposition decomposition;
+
+        /***********************************************
+         * The set of solutions found for each cluster.
+         ***********************************************/
+        std::vector<SolutionSet> solutionSetsC;
+
+    public:
+        /*************************************************************************************
+         * Constructs a new solver.
+         *
+         * @param instance         the instance to be solved.
+         * @param numClusters      the number of clusters.
+         * @param numThreads       the maximum number of clusters solved at once, or 0 to
+         *                         use every core.
+         * @param subSolverFactory the function that constructs the solver of each cluster.
+         * @param timeLimit        the time limit in seconds.
+         * @param seed             the seed for the pseudo-random numbers generator.
+         * @param maxNumSolutions  the maximum number of solutions.
+         *************************************************************************************/
+        DecompositionSolver(const std::shared_ptr<const Instance> & instance,
+                unsigned numClusters, unsigned numThreads,
+                const SubSolverFactory & subSolverFactory, unsigned timeLimit, unsigned seed,
+                unsigned maxNumSolutions);
+
+        /*************************************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance         the instance to be solved.
+         * @param numClusters      the number of clusters.
+         * @param numThreads       the maximum number of clusters solved at once, or 0 to
+         *                         use every core.
+         * @param subSolverFactory the function that constructs the solver of each cluster.
+         * @param timeLimit        the time limit in seconds.
+         * @param seed             the seed for the pseudo-random numbers generator.
+         * @param maxNumSolutions  the maximum number of solutions.
+         *************************************************************************************/
+        DecompositionSolver(const Instance & instance, unsigned numClusters, unsigned numThreads,
+                const SubSolverFactory & subSolverFactory, unsigned timeLimit, unsigned seed,
+                unsigned maxNumSolutions);
+
+        /******************************
+         * Constructs an empty solver.
+         ******************************/
+        DecompositionSolver();
+
+        /**********************************************
+         * Returns the decomposition of the instance.
+         *
+         * @return the decomposition of the instance.
+         **********************************************/
+        const Decomposition & getDecomposition() const;
+
+        /**************************************************************************
+         * Returns the set of solutions found for the specified cluster.
+         *
+         * @param c the cluster whose set of solutions is to be returned.
+         *
+         * @return the set of solutions found for the specified cluster.
+         **************************************************************************/
+        const SolutionSet & getClusterSolutionSet(unsigned c) const;
+
+        /******************************************************************************
+         * Decomposes the instance and solves the sub-instance of each cluster. Each
+         * sub-solver gets the remaining time divided by the number of waves of
+         * clusters left, rounded up. The first exception thrown by a sub-solver stops
+         * the other threads and is rethrown once they are joined.
+         ******************************************************************************/
+        void solveClusters();
+
+        /**************************************************************************
+         * Merges the first fronts of the clusters into the set of solutions.
+         **************************************************************************/
+        void merge();
+
+        /**********************
+         * Solve the instance.
+         **********************/
+        void solve();
+};
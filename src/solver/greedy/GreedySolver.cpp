@@ -0,0 +1,130 @@
+#include "GreedySolver.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+GreedySolver::GreedySolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+        unsigned seed, unsigned maxNumSolutions) : 
+    Solver::Solver(instance, timeLimit, seed, maxNumSolutions) {}
+
+GreedySolver::GreedySolver(const Instance & instance, unsigned timeLimit, unsigned seed, 
+        unsigned maxNumSolutions) : 
+    Solver::Solver(instance, timeLimit, seed, maxNumSolutions) {}
+
+GreedySolver::GreedySolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+        unsigned seed) :
+    Solver::Solver(instance, timeLimit, seed) {}
+
+GreedySolver::GreedySolver(const Instance & instance, unsigned timeLimit, unsigned seed) :
+    Solver::Solver(instance, timeLimit, seed) {}
+
+GreedySolver::GreedySolver(const std::shared_ptr<const Instance> & instance,
+        unsigned timeLimit) :
+    Solver::Solver(instance, timeLimit) {}
+
+GreedySolver::GreedySolver(const Instance & instance, unsigned timeLimit) :
+    Solver::Solver(instance, timeLimit) {}
+
+GreedySolver::GreedySolver(const std::shared_ptr<const Instance> & instance) :
+    Solver::Solver(instance) {}
+
+GreedySolver::GreedySolver(const Instance & instance) : Solver::Solver(instance) {}
+
+GreedySolver::GreedySolver() : Solver::Solver() {}
+
+void GreedySolver::solve() {
+    this->startTime = std::chrono::steady_clock::now();
+
+    unsigned numVehicles = this->instance->getNumVehicles();
+    double epsilon = std::numeric_limits<float>::epsilon();
+    std::vector<unsigned> requests(this->instance->getNumRequests());
+    std::vector<unsigned> lasts(numVehicles);
+    std::vector<double> tReadys(numVehicles);
+    std::vector<std::pair<unsigned, unsigned>> insertions;
+
+    for(unsigned k = 0; k < numVehicles; k++) {
+        lasts[k] = this->instance->getSourceK(k);
+        tReadys[k] = this->instance->getTStart(k) + this->instance->getTVisit(lasts[k]);
+    }
+
+    std::iota(requests.begin(), requests.end(), 0);
+    std::stable_sort(requests.begin(), requests.end(), [&](unsigned a, unsigned b) {
+        return this->instance->getTCreate(a) < this->instance->getTCreate(b);
+    });
+
+    for(unsigned r : requests) {
+        if(this->areTerminationCriteriaMet()) {
+            break;
+        }
+
+        unsigned sourceR = this->instance->getSourceR(r);
+        unsigned targetR = this->instance->getTargetR(r);
+        unsigned bestK = numVehicles;
+        double bestTReady = std::numeric_limits<double>::max();
+
+        for(unsigned k = 0; k < numVehicles; k++) {
+            if(!this->instance->isEligible(r, k)) {
+                continue;
+            }
+
+            unsigned targetK = this->instance->getTargetK(k);
+            double tArrive = std::max(tReadys[k] +
+                    this->instance->getTravelTime(lasts[k], sourceR, k),
+                    this->instance->getTCreate(r));
+            double tReady = tArrive + this->instance->getTVisit(sourceR) +
+                this->instance->getTravelTime(sourceR, targetR, k) +
+                this->instance->getTVisit(targetR);
+
+            if(tReady + this->instance->getTravelTime(targetR, targetK, k) >
+                    this->instance->getTStart(k) + this->instance->getTLimit(k) -
+                    this->instance->getTVisit(targetK) + epsilon) {
+                continue;
+            }
+
+            if(tReady < bestTReady) {
+                bestK = k;
+                bestTReady = tReady;
+            }
+        }
+
+        if(bestK < numVehicles) {
+            lasts[bestK] = targetR;
+            tReadys[bestK] = bestTReady;
+            insertions.push_back(std::make_pair(r, bestK));
+        }
+    }
+
+    // keep the solutions made of evenly spaced prefixes of the insertions
+    unsigned numSolutions = std::max(1u, std::min<unsigned>(this->maxNumSolutions,
+                insertions.size() + 1));
+    std::vector<std::vector<unsigned>> paths(numVehicles);
+    unsigned numInserted = 0;
+
+    for(unsigned k = 0; k < numVehicles; k++) {
+        paths[k].push_back(this->instance->getSourceK(k));
+    }
+
+    for(unsigned i = 0; i < numSolutions; i++) {
+        unsigned end = numSolutions == 1 ? insertions.size() :
+            (std::size_t) i * insertions.size() / (numSolutions - 1);
+
+        for(; numInserted < end; numInserted++) {
+            unsigned r = insertions[numInserted].first;
+            unsigned k = insertions[numInserted].second;
+
+            paths[k].push_back(this->instance->getSourceR(r));
+            paths[k].push_back(this->instance->getTargetR(r));
+        }
+
+        std::vector<std::vector<unsigned>> closedPaths(paths);
+
+        for(unsigned k = 0; k < numVehicles; k++) {
+            closedPaths[k].push_back(this->instance->getTargetK(k));
+        }
+
+        this->solutionSet.insert(Solution(this->instance, closedPaths));
+    }
+
+    this->solvingTime = this->getElapsedTime();
+}
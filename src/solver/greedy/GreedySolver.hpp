@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../Solver.hpp"
+
+/********************************************************************************************
+ * The GreedySolver class represents a constructive heuristic for the MVRPPD. The requests
+ * are taken in order of creation and each one is appended to the route of the eligible
+ * vehicle that fulfills it first, as long as the route still fits the time-limit of the
+ * vehicle. Every prefix of the insertions is a solution that trades profit for fulfillment
+ * time, and up to the maximum number of solutions of them, evenly spaced, are kept.
+ ********************************************************************************************/
+class GreedySolver : public Solver {
+    public :
+        /****************************************************************************
+         * Constructs a new solver.
+         *
+         * @param instance        the instance to be solved.
+         * @param timeLimit       the time limit in seconds.
+         * @param seed            the  seed for the pseudo-random numbers generator.
+         * @param maxNumSolutions the maximum number of solutions
+         ****************************************************************************/
+        GreedySolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+                unsigned seed, unsigned maxNumSolutions);
+
+        /****************************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance        the instance to be solved.
+         * @param timeLimit       the time limit in seconds.
+         * @param seed            the  seed for the pseudo-random numbers generator.
+         * @param maxNumSolutions the maximum number of solutions
+         ****************************************************************************/
+        GreedySolver(const Instance & instance, unsigned timeLimit, unsigned seed,
+                unsigned maxNumSolutions);
+
+        /************************************************************************
+         * Constructs a new solver.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         * @param seed      the  seed for the pseudo-random numbers generator.
+         ************************************************************************/
+        GreedySolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit,
+                unsigned seed);
+
+        /************************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         * @param seed      the  seed for the pseudo-random numbers generator.
+         ************************************************************************/
+        GreedySolver(const Instance & instance, unsigned timeLimit, unsigned seed);
+
+        /*********************************************************
+         * Constructs a new solver.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         *********************************************************/
+        GreedySolver(const std::shared_ptr<const Instance> & instance, unsigned timeLimit);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance  the instance to be solved.
+         * @param timeLimit the time limit in seconds.
+         ***********************************************************************/
+        GreedySolver(const Instance & instance, unsigned timeLimit);
+
+        /*********************************************
+         * Constructs a new solver.
+         *
+         * @param instance the instance to be solved.
+         *********************************************/
+        GreedySolver(const std::shared_ptr<const Instance> & instance);
+
+        /***********************************************************************
+         * Constructs a new solver that holds a copy of the specified instance.
+         *
+         * @param instance the instance to be solved.
+         ***********************************************************************/
+        GreedySolver(const Instance & instance);
+
+        /******************************
+         * Constructs an empty solver.
+         ******************************/
+        GreedySolver();
+
+        /**********************
+         * Solve the instance.
+         **********************/
+        void solve();
+};
+
@@ -0,0 +1,181 @@
+#include "../generator/InstanceGenerator.hpp"
+#include "../solver/decomposition/DecompositionSolver.hpp"
+#include "../solver/greedy/GreedySolver.hpp"
+#include <cassert>
+#include <mutex>
+#include <string>
+
+int main() {
+    unsigned timeLimit = 100;
+    unsigned seed = 0;
+    unsigned maxNumSolutions = 10;
+    SubSolverFactory greedySolverFactory = [](const std::shared_ptr<const Instance> & instance,
+            unsigned timeLimit, unsigned seed, unsigned maxNumSolutions) {
+        return std::unique_ptr<Solver>(new GreedySolver(instance, timeLimit, seed,
+                    maxNumSolutions));
+    };
+    Instance instance = Instance("instances/test.in");
+    GreedySolver greedySolver(instance, timeLimit, seed, maxNumSolutions);
+
+    greedySolver.solve();
+
+    assert(greedySolver.getSolvingTime() <= timeLimit);
+    assert(greedySolver.getSolutionSet().size() > 0);
+    assert(greedySolver.getSolutionSet().size() <= maxNumSolutions);
+
+    for(const Solution & solution : greedySolver.getSolutionSet().getSolutions()) {
+        assert(solution.isFeasible());
+        assert(solution.areConstraintsSatisfied());
+    }
+
+    instance = InstanceGenerator(200, 12, 3).generate();
+
+    for(unsigned numClusters : {1, 4, 12, 20}) {
+        DecompositionSolver solver(instance, numClusters, 2, greedySolverFactory, timeLimit, seed,
+                maxNumSolutions);
+
+        solver.solve();
+
+        const Decomposition & decomposition = solver.getDecomposition();
+        std::vector<unsigned> numClustersR(instance.getNumRequests(), 0);
+        std::vector<unsigned> numClustersK(instance.getNumVehicles(), 0);
+
+        assert(decomposition.getNumClusters() == std::min(numClusters,
+                    instance.getNumVehicles()));
+        assert(solver.getSolvingTime() <= timeLimit);
+
+        // every request and vehicle belongs to exactly one cluster
+        for(unsigned c = 0; c < decomposition.getNumClusters(); c++) {
+            const Instance & subInstance = * decomposition.getSubInstance(c);
+            ArrayView<unsigned> requests = decomposition.getRequests(c);
+            ArrayView<unsigned> vehicles = decomposition.getVehicles(c);
+            ArrayView<unsigned> vertices = decomposition.getVertices(c);
+
+            assert(subInstance.getNumRequests() == requests.size());
+            assert(subInstance.getNumVehicles() == vehicles.size());
+            assert(subInstance.getNumVertices() == vertices.size());
+            assert(vehicles.size() >= 1);
+
+            for(unsigned r = 0; r < requests.size(); r++) {
+                numClustersR[requests[r]]++;
+                assert(vertices[subInstance.getSourceR(r)] == instance.getSourceR(requests[r]));
+                assert(vertices[subInstance.getTargetR(r)] == instance.getTargetR(requests[r]));
+                assert(subInstance.getProfit(r) == instance.getProfit(requests[r]));
+                assert(subInstance.getDemandR(r) == instance.getDemandR(requests[r]));
+            }
+
+            for(unsigned k = 0; k < vehicles.size(); k++) {
+                numClustersK[vehicles[k]]++;
+                assert(vertices[subInstance.getSourceK(k)] == instance.getSourceK(vehicles[k]));
+                assert(vertices[subInstance.getTargetK(k)] == instance.getTargetK(vehicles[k]));
+                assert(subInstance.getCapacity(k) == instance.getCapacity(vehicles[k]));
+            }
+
+            for(unsigned v = 0; v < vertices.size(); v++) {
+                assert(subInstance.getX(v) == instance.getX(vertices[v]));
+                assert(subInstance.getY(v) == instance.getY(vertices[v]));
+                assert(subInstance.getTVisit(v) == instance.getTVisit(vertices[v]));
+            }
+
+            for(const Solution & solution : solver.getClusterSolutionSet(c).getSolutions()) {
+                assert(solution.isFeasible());
+            }
+        }
+
+        for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+            assert(numClustersR[r] == 1);
+        }
+
+        for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+            assert(numClustersK[k] == 1);
+        }
+
+        // the merged solutions are feasible and none dominates another
+        std::vector<Solution> solutions = solver.getSolutionSet().getFront(0);
+
+        assert(solutions.size() >= 1);
+        assert(solutions.size() <= maxNumSolutions);
+
+        for(const Solution & solutionA : solutions) {
+            assert(solutionA.isFeasible());
+            assert(solutionA.areConstraintsSatisfied());
+
+            for(const Solution & solutionB : solutions) {
+                assert(!solutionA.dominates(solutionB));
+            }
+        }
+    }
+
+    // with more clusters than threads, each cluster gets a share of the remaining time for
+    // the waves of clusters left, instead of the whole remaining time
+    std::vector<unsigned> timeLimitsC(8, 0);
+    std::mutex timeLimitsMutex;
+    SubSolverFactory recordingSolverFactory = [&](
+            const std::shared_ptr<const Instance> & instance, unsigned timeLimit, unsigned seed,
+            unsigned maxNumSolutions) {
+        std::lock_guard<std::mutex> lock(timeLimitsMutex);
+
+        timeLimitsC[seed] = timeLimit;
+
+        return greedySolverFactory(instance, timeLimit, seed, maxNumSolutions);
+    };
+    DecompositionSolver recordingSolver(instance, 8, 2, recordingSolverFactory, timeLimit, 0,
+            maxNumSolutions);
+
+    recordingSolver.solve();
+
+    for(unsigned c = 0; c < timeLimitsC.size(); c++) {
+        unsigned numWaves = (timeLimitsC.size() - c + 1) / 2;
+
+        assert(timeLimitsC[c] > 0);
+        assert(timeLimitsC[c] <= (timeLimit + numWaves - 1) / numWaves);
+        assert(recordingSolver.getClusterSolutionSet(c).size() > 0);
+    }
+
+    assert(timeLimitsC[0] == timeLimit / 4);
+
+    // an exception of a sub-solver on any thread reaches the caller
+    SubSolverFactory failingSolverFactory = [&](const std::shared_ptr<const Instance> & instance,
+            unsigned timeLimit, unsigned seed, unsigned maxNumSolutions) {
+        if(seed == 2) {
+            throw "Sub-solver failed.";
+        }
+
+        return greedySolverFactory(instance, timeLimit, seed, maxNumSolutions);
+    };
+
+    for(unsigned numThreads : {1, 4}) {
+        DecompositionSolver failingSolver(instance, 8, numThreads, failingSolverFactory,
+                timeLimit, 0, maxNumSolutions);
+
+        try {
+            failingSolver.solve();
+            assert(false);
+        } catch(const char * e) {
+            assert(std::string(e) == "Sub-solver failed.");
+        }
+    }
+
+    // the sub-instances read the lengths of the instance, even those of a lengths file
+    Instance("instances/test.in").writeLengths("bin/test/decomposition.bin");
+
+    std::shared_ptr<const Instance> asymmetricInstance = std::make_shared<const Instance>(
+            "instances/test.in", "bin/test/decomposition.bin");
+    Decomposition decomposition(asymmetricInstance, 2);
+
+    for(unsigned c = 0; c < decomposition.getNumClusters(); c++) {
+        const Instance & subInstance = * decomposition.getSubInstance(c);
+        ArrayView<unsigned> vertices = decomposition.getVertices(c);
+
+        assert(!subInstance.isSymmetric());
+
+        for(unsigned u = 0; u < vertices.size(); u++) {
+            for(unsigned v = 0; v < vertices.size(); v++) {
+                assert(subInstance.getLength(u, v) ==
+                        asymmetricInstance->getLength(vertices[u], vertices[v]));
+            }
+        }
+    }
+
+    return 0;
+}
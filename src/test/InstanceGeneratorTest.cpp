@@ -0,0 +1,110 @@
+#include "../generator/InstanceGenerator.hpp"
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+
+int main() {
+    InstanceGenerator generator(50, 5, 7);
+    Instance instance = generator.generate();
+
+    assert(instance.isValid());
+    assert(instance.getNumRequests() == 50);
+    assert(instance.getNumVehicles() == 5);
+    assert(instance.getNumVertices() == 110);
+    assert(instance.getNumSpeedClasses() == 1);
+
+    for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+        assert(instance.getTCreate(r) == 0.0);
+        assert(instance.getDemandR(r) >= 1 && instance.getDemandR(r) <= 10);
+    }
+
+    // the same seed generates the same instance, in either distance mode
+    Instance sameInstance = InstanceGenerator(50, 5, 7).generate(DistanceMode::ON_THE_FLY);
+    Instance otherInstance = InstanceGenerator(50, 5, 8).generate();
+
+    for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+        assert(sameInstance.getX(v) == instance.getX(v));
+        assert(sameInstance.getY(v) == instance.getY(v));
+        assert(sameInstance.getTVisit(v) == instance.getTVisit(v));
+    }
+
+    assert(otherInstance.getX(0) != instance.getX(0));
+
+    generator.setSpatialDistribution(SpatialDistribution::CLUSTERED);
+    generator.setArrivalProcess(ArrivalProcess::POISSON);
+    generator.setDemandRatio(0.5);
+    generator.setNumSpeeds(3);
+
+    for(auto spatialDistribution : {SpatialDistribution::UNIFORM, SpatialDistribution::CLUSTERED,
+            SpatialDistribution::MIXED}) {
+        for(auto arrivalProcess : {ArrivalProcess::BATCH, ArrivalProcess::POISSON,
+                ArrivalProcess::RUSH_HOUR}) {
+            generator.setSpatialDistribution(spatialDistribution);
+            generator.setArrivalProcess(arrivalProcess);
+            instance = generator.generate();
+
+            assert(instance.isValid());
+            assert(instance.getNumSpeedClasses() <= 3);
+
+            for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+                assert(instance.getX(v) >= 0.0 && instance.getX(v) <= 1000.0);
+                assert(instance.getY(v) >= 0.0 && instance.getY(v) <= 1000.0);
+            }
+
+            for(unsigned r = 1; r < instance.getNumRequests(); r++) {
+                assert(instance.getTCreate(r - 1) <= instance.getTCreate(r));
+            }
+
+            assert((arrivalProcess == ArrivalProcess::BATCH) ==
+                    (instance.getTCreate(instance.getNumRequests() - 1) == 0.0));
+        }
+    }
+
+    // written with enough digits, the text format reads back the same instance
+    std::stringstream ss;
+
+    ss.precision(std::numeric_limits<double>::max_digits10);
+    instance.write(ss);
+
+    Instance readInstance(ss);
+
+    assert(readInstance.getNumVertices() == instance.getNumVertices());
+
+    for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+        assert(readInstance.getTCreate(r) == instance.getTCreate(r));
+    }
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        assert(readInstance.getCapacity(k) == instance.getCapacity(k));
+        assert(readInstance.getSpeed(k) == instance.getSpeed(k));
+    }
+
+    for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+        assert(readInstance.getX(v) == instance.getX(v));
+        assert(readInstance.getY(v) == instance.getY(v));
+    }
+
+    assert(toSpatialDistribution("mixed") == SpatialDistribution::MIXED);
+    assert(toArrivalProcess("rush-hour") == ArrivalProcess::RUSH_HOUR);
+
+    try {
+        toArrivalProcess("never");
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "Unknown arrival process.");
+    }
+
+    // a ratio that is not positive would give infinite or negative capacities
+    for(double demandRatio : {0.0, -0.5, std::nan("")}) {
+        try {
+            InstanceGenerator(10, 2, 0).setDemandRatio(demandRatio);
+            assert(false);
+        } catch(const char * e) {
+            assert(std::string(e) == "Invalid demand ratio.");
+        }
+    }
+
+    return 0;
+}
@@ -1,8 +1,21 @@
+#include "../instance/ArcFilter.hpp"
+#include "../instance/CandidateLists.hpp"
+#include "../instance/CompressedStream.hpp"
 #include "../instance/Instance.hpp"
+#include "../instance/InstanceCache.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
 
 int main() {
     Instance instance;
@@ -263,6 +276,21 @@ int main() {
     assert(fabs(instance.getDemandV(18) - 2.0) < std::numeric_limits<float>::epsilon());
     assert(fabs(instance.getDemandV(19) + 2.0) < std::numeric_limits<float>::epsilon());
 
+    assert(instance.getRole(0) == VertexRole::VEHICLE_SOURCE);
+    assert(instance.getRole(3) == VertexRole::VEHICLE_TARGET);
+    assert(instance.getRole(4) == VertexRole::REQUEST_SOURCE);
+    assert(instance.getRole(19) == VertexRole::REQUEST_TARGET);
+    assert(reinterpret_cast<uintptr_t>(&instance.getVertex(0)) % 64 == 0);
+
+    for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+        const VertexRecord & vertex = instance.getVertex(v);
+
+        assert(vertex.demand == instance.getDemandsV()[v]);
+        assert(vertex.tVisit == instance.getTVisits()[v]);
+        assert(vertex.request == instance.getRequestsV()[v]);
+        assert(vertex.vehicle == instance.getVehiclesV()[v]);
+    }
+
     assert(instance.getLengths().size() == 20);
 
     assert(instance.getLengths()[0].size() == 20);
@@ -705,6 +733,959 @@ int main() {
     assert(fabs(instance.getLength(19, 18) - sqrt(2.0)) < std::numeric_limits<float>::epsilon());
     assert(fabs(instance.getLength(19, 19) - sqrt(0.0)) < std::numeric_limits<float>::epsilon());
 
+    assert(instance.getLengths().getStride() >= 20);
+    assert(instance.getLengths(19).size() == 20);
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            assert(instance.getLengths(u)[v] == instance.getLength(u, v));
+        }
+    }
+
+    assert(instance.getNumSpeedClasses() == 2);
+    assert(instance.getSpeedClass(0) != instance.getSpeedClass(1));
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        assert(instance.getTravelTimes(k).size() == 20);
+
+        for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+            for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+                assert(fabs(instance.getTravelTime(u, v, k) - instance.getLength(u, v) /
+                            instance.getSpeed(k)) < std::numeric_limits<float>::epsilon());
+            }
+        }
+    }
+
+    instance.writeBinary("bin/test/test.bin");
+
+    Instance binaryInstance("bin/test/test.bin");
+
+    assert(binaryInstance.isValid());
+    assert(binaryInstance.getNumRequests() == instance.getNumRequests());
+    assert(binaryInstance.getNumVehicles() == instance.getNumVehicles());
+    assert(binaryInstance.getNumVertices() == instance.getNumVertices());
+    assert(binaryInstance.getSumProfit() == instance.getSumProfit());
+    assert(binaryInstance.getNumSpeedClasses() == instance.getNumSpeedClasses());
+
+    for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+        assert(binaryInstance.getProfit(r) == instance.getProfit(r));
+        assert(binaryInstance.getSourceR(r) == instance.getSourceR(r));
+        assert(binaryInstance.getTargetR(r) == instance.getTargetR(r));
+    }
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        assert(binaryInstance.getSpeed(k) == instance.getSpeed(k));
+        assert(binaryInstance.getSourceK(k) == instance.getSourceK(k));
+        assert(binaryInstance.getTargetK(k) == instance.getTargetK(k));
+    }
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        assert(binaryInstance.getDemandV(u) == instance.getDemandV(u));
+        assert(binaryInstance.isASource(u) == instance.isASource(u));
+
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            assert(binaryInstance.getLength(u, v) == instance.getLength(u, v));
+
+            for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+                assert(binaryInstance.getTravelTime(u, v, k) == instance.getTravelTime(u, v, k));
+            }
+        }
+    }
+
+    assert(instance.isValid(ValidationLevel::STRUCTURAL));
+    assert(instance.isValid(ValidationLevel::METRIC));
+    assert(instance.isValid(ValidationLevel::FULL));
+
+    // writes a copy of the binary instance whose lengths (0, 1) and (1, 0) are replaced
+    auto writeLengths = [&](const char * filename, double length01, double length10) {
+        std::ifstream ifs("bin/test/test.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        double length = instance.getLength(0, 1);
+        std::size_t offset = bytes.find(std::string((const char *) &length, sizeof(length)));
+        std::size_t offset10 = offset + (instance.getLengths().getStride() - 1) * sizeof(double);
+
+        assert(offset != std::string::npos);
+        assert(memcmp(&bytes[offset - sizeof(double)], "\0\0\0\0\0\0\0\0", sizeof(double)) == 0);
+
+        memcpy(&bytes[offset], &length01, sizeof(double));
+        memcpy(&bytes[offset10], &length10, sizeof(double));
+
+        std::ofstream(filename, std::ios::binary) << bytes;
+    };
+
+    // writes a copy of the binary instance whose header field at the specified offset is
+    // replaced, which must then be rejected
+    auto assertInvalidHeader = [&](std::size_t offset, uint32_t value) {
+        std::ifstream ifs("bin/test/test.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+        memcpy(&bytes[offset], &value, sizeof(value));
+        std::ofstream("bin/test/corrupt.bin", std::ios::binary) << bytes;
+
+        try {
+            Instance corruptInstance("bin/test/corrupt.bin");
+            assert(false);
+        } catch(const char * e) {
+            assert(std::string(e) == "Invalid binary instance.");
+        }
+    };
+
+    // a stride shorter than a row, and fewer vertices than the requests and vehicles visit
+    assertInvalidHeader(28, 1);
+    assertInvalidHeader(20, 2);
+
+    unsigned error;
+
+    writeLengths("bin/test/negative.bin", -1.0, -1.0);
+    Instance negativeInstance("bin/test/negative.bin");
+
+    assert(negativeInstance.isValid(ValidationLevel::STRUCTURAL));
+    assert(!negativeInstance.isValid(error, ValidationLevel::METRIC) && error == 33);
+    assert(!negativeInstance.isValid(error) && error == 33);
+
+    // a view only checks the lengths between its own vertices, here those of vehicle 1
+    std::shared_ptr<const Instance> negativeParent = std::make_shared<const Instance>(
+            "bin/test/negative.bin");
+    std::vector<unsigned> allRequests(negativeParent->getNumRequests());
+
+    std::iota(allRequests.begin(), allRequests.end(), 0);
+
+    assert(Instance(negativeParent, allRequests, std::vector<unsigned>{1}).isValid(error) &&
+            error == 0);
+    assert(!Instance(negativeParent, allRequests, std::vector<unsigned>{0}).isValid(error) &&
+            error == 33);
+
+    writeLengths("bin/test/asymmetric.bin", instance.getLength(0, 1) + 1.0, instance.getLength(0, 1));
+    Instance asymmetricInstance("bin/test/asymmetric.bin");
+
+    assert(asymmetricInstance.isValid(ValidationLevel::STRUCTURAL));
+    assert(!asymmetricInstance.isValid(error, ValidationLevel::METRIC) && error == 34);
+    assert(!asymmetricInstance.isValid(error, ValidationLevel::FULL) && error == 34);
+
+    writeLengths("bin/test/detour.bin", 1000.0, 1000.0);
+    Instance detourInstance("bin/test/detour.bin");
+
+    assert(detourInstance.isValid(ValidationLevel::METRIC));
+    assert(!detourInstance.isValid(error, ValidationLevel::FULL) && error == 35);
+
+    writeLengths("bin/test/perturbed.bin", instance.getLength(0, 1) + 1.0e-9,
+            instance.getLength(0, 1) + 1.0e-9);
+    Instance perturbedInstance("bin/test/perturbed.bin");
+
+    assert(perturbedInstance.isValid(error, ValidationLevel::FULL) && error == 0);
+
+    instance.writeLengths("bin/test/lengths.bin");
+    Instance lengthsInstance("instances/test.in", "bin/test/lengths.bin");
+
+    assert(lengthsInstance.getDistanceMode() == DistanceMode::MATRIX);
+    assert(!lengthsInstance.isSymmetric());
+    assert(lengthsInstance.isValid(error) && error == 0);
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            assert(lengthsInstance.getLength(u, v) == instance.getLength(u, v));
+            assert(lengthsInstance.getTravelTime(u, v, 1) == instance.getTravelTime(u, v, 1));
+        }
+    }
+
+    // lengths files with rows that are unpadded or wider than the computed travelling times
+    // are written back and read again unchanged
+    for(unsigned stride : {instance.getNumVertices(), instance.getNumVertices() + 40}) {
+        std::ifstream ifs("bin/test/lengths.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        unsigned numTravelTimes = 0;
+
+        bytes.resize(64 + instance.getNumVertices() * stride * sizeof(double));
+        memcpy(&bytes[16], &numTravelTimes, sizeof(numTravelTimes));
+        memcpy(&bytes[20], &stride, sizeof(stride));
+
+        for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+            for(unsigned v = 0; v < stride; v++) {
+                double length = v < instance.getNumVertices() ? instance.getLength(u, v) : 0.0;
+
+                memcpy(&bytes[64 + (u * stride + v) * sizeof(double)], &length, sizeof(double));
+            }
+        }
+
+        std::ofstream("bin/test/strided-lengths.bin", std::ios::binary) << bytes;
+
+        Instance stridedInstance("instances/test.in", "bin/test/strided-lengths.bin");
+
+        stridedInstance.writeLengths("bin/test/strided-lengths-copy.bin");
+        stridedInstance.writeBinary("bin/test/strided-binary.bin");
+
+        Instance lengthsCopy("instances/test.in", "bin/test/strided-lengths-copy.bin");
+        Instance binaryCopy("bin/test/strided-binary.bin");
+
+        for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+            for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+                assert(lengthsCopy.getLength(u, v) == instance.getLength(u, v));
+                assert(binaryCopy.getLength(u, v) == instance.getLength(u, v));
+
+                for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+                    assert(lengthsCopy.getTravelTime(u, v, k) ==
+                            stridedInstance.getTravelTime(u, v, k));
+                    assert(binaryCopy.getTravelTime(u, v, k) ==
+                            stridedInstance.getTravelTime(u, v, k));
+                }
+            }
+        }
+    }
+
+    // adding one to the lengths of the edges (u, v) with u < v keeps them metric
+    {
+        std::ifstream ifs("bin/test/lengths.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        unsigned numTravelTimes = 0, stride = instance.getLengths().getStride();
+
+        memcpy(&bytes[16], &numTravelTimes, sizeof(numTravelTimes));
+
+        for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+            for(unsigned v = u + 1; v < instance.getNumVertices(); v++) {
+                double length = instance.getLength(u, v) + 1.0;
+
+                memcpy(&bytes[64 + (u * stride + v) * sizeof(double)], &length, sizeof(double));
+            }
+        }
+
+        std::ofstream("bin/test/asymmetric-lengths.bin", std::ios::binary) << bytes;
+    }
+
+    Instance asymmetricLengthsInstance(std::string("instances/test.in"),
+            std::string("bin/test/asymmetric-lengths.bin"));
+
+    assert(asymmetricLengthsInstance.getLength(0, 1) == instance.getLength(0, 1) + 1.0);
+    assert(asymmetricLengthsInstance.getLength(1, 0) == instance.getLength(1, 0));
+    assert(asymmetricLengthsInstance.getTravelTime(0, 1, 0) ==
+            asymmetricLengthsInstance.getLength(0, 1) / instance.getSpeed(0));
+    assert(asymmetricLengthsInstance.isValid(error, ValidationLevel::FULL) && error == 0);
+
+    asymmetricLengthsInstance.writeBinary("bin/test/asymmetric-binary.bin");
+    Instance asymmetricBinaryInstance("bin/test/asymmetric-binary.bin");
+
+    assert(!asymmetricBinaryInstance.isSymmetric());
+    assert(asymmetricBinaryInstance.isValid());
+    assert(asymmetricBinaryInstance.getLength(0, 1) == instance.getLength(0, 1) + 1.0);
+
+    // asymmetric lengths are read from a binary instance whatever the distance mode
+    Instance asymmetricOnTheFlyInstance("bin/test/asymmetric-binary.bin",
+            DistanceMode::ON_THE_FLY);
+
+    assert(asymmetricOnTheFlyInstance.getDistanceMode() == DistanceMode::MATRIX);
+    assert(!asymmetricOnTheFlyInstance.isSymmetric());
+    assert(asymmetricOnTheFlyInstance.getLength(0, 1) == instance.getLength(0, 1) + 1.0);
+    assert(Instance("bin/test/test.bin").isSymmetric());
+
+    try {
+        Instance mismatchedInstance("instances/test.in", "instances/test.in");
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "Invalid lengths file.");
+    }
+
+    Instance onTheFlyInstance("instances/test.in", DistanceMode::ON_THE_FLY);
+    std::vector<unsigned> vertices(instance.getNumVertices());
+    std::vector<double> lengths(instance.getNumVertices());
+    std::vector<double> batchLengths(instance.getNumVertices());
+
+    assert(onTheFlyInstance.isValid());
+    assert(onTheFlyInstance.getDistanceMode() == DistanceMode::ON_THE_FLY);
+    assert(onTheFlyInstance.getLengths().size() == 0);
+    assert(onTheFlyInstance.getTravelTimes(0).size() == 0);
+    assert(onTheFlyInstance.getNumSpeedClasses() == instance.getNumSpeedClasses());
+
+    for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+        vertices[v] = instance.getNumVertices() - 1 - v;
+    }
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            assert(onTheFlyInstance.getLength(u, v) == instance.getLength(u, v));
+
+            for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+                assert(onTheFlyInstance.getTravelTime(u, v, k) == instance.getTravelTime(u, v, k));
+            }
+        }
+
+        instance.getLengths(u, vertices, lengths.data());
+        onTheFlyInstance.getLengths(u, vertices, batchLengths.data());
+
+        for(unsigned i = 0; i < vertices.size(); i++) {
+            assert(lengths[i] == instance.getLength(u, vertices[i]));
+            assert(batchLengths[i] == lengths[i]);
+        }
+
+        for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+            instance.getTravelTimes(u, vertices, k, lengths.data());
+            onTheFlyInstance.getTravelTimes(u, vertices, k, batchLengths.data());
+
+            for(unsigned i = 0; i < vertices.size(); i++) {
+                assert(lengths[i] == instance.getTravelTime(u, vertices[i], k));
+                assert(batchLengths[i] == lengths[i]);
+            }
+        }
+    }
+
+    Instance onTheFlyBinaryInstance("bin/test/test.bin", DistanceMode::ON_THE_FLY);
+
+    assert(onTheFlyBinaryInstance.isValid());
+    assert(onTheFlyBinaryInstance.getLength(0, 19) == instance.getLength(0, 19));
+    assert(onTheFlyBinaryInstance.getTravelTime(0, 19, 1) == instance.getTravelTime(0, 19, 1));
+
+    const SpatialIndex & index = instance.getSpatialIndex();
+    std::vector<unsigned> nearest, withinRadius;
+
+    assert(index.size() == instance.getNumVertices());
+    assert(onTheFlyBinaryInstance.getSpatialIndex().size() == instance.getNumVertices());
+
+    // the closest vertices, by length and then by index, and the vertices within a radius
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        std::vector<unsigned> sorted(instance.getNumVertices());
+
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            sorted[v] = v;
+        }
+
+        std::sort(sorted.begin(), sorted.end(), [&](unsigned v, unsigned w) {
+            return std::make_pair(instance.getLength(u, v), v) <
+                std::make_pair(instance.getLength(u, w), w);
+        });
+
+        for(unsigned k = 0; k <= instance.getNumVertices() + 1; k++) {
+            index.getNearest(instance.getX(u), instance.getY(u), k, nearest);
+
+            assert(nearest.size() == std::min(k, instance.getNumVertices()));
+            assert(std::equal(nearest.begin(), nearest.end(), sorted.begin()));
+        }
+
+        for(double radius : {0.0, 1.0, 2.5, 10.0, 1000.0}) {
+            index.getWithinRadius(instance.getX(u), instance.getY(u), radius, withinRadius);
+            std::sort(withinRadius.begin(), withinRadius.end());
+
+            std::vector<unsigned> expected;
+
+            for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+                if(instance.getLength(u, v) <= radius) {
+                    expected.push_back(v);
+                }
+            }
+
+            assert(withinRadius == expected);
+        }
+    }
+
+    index.getNearest(-1000.0, 1000.0, 3, nearest);
+    assert(nearest.size() == 3);
+
+    SpatialIndex emptyIndex;
+
+    emptyIndex.getNearest(0.0, 0.0, 3, nearest);
+    assert(emptyIndex.size() == 0 && nearest.empty());
+
+    CandidateLists candidates(instance, 3);
+
+    assert(candidates.getNumCandidates() == 3);
+
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        ArrayView<unsigned> sources = candidates.getSources(u);
+        ArrayView<unsigned> targets = candidates.getTargets(u);
+
+        assert(sources.size() == 3 && targets.size() == 3);
+
+        for(unsigned i = 0; i < 3; i++) {
+            assert(sources[i] != u && instance.getRequestV(sources[i]) < instance.getNumRequests());
+            assert(instance.isASource(sources[i]));
+            assert(targets[i] != u && instance.getRequestV(targets[i]) < instance.getNumRequests());
+            assert(instance.isATarget(targets[i]));
+        }
+
+        for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+            unsigned v = instance.getSourceR(r);
+
+            assert(v == u || std::find(sources.begin(), sources.end(), v) != sources.end() ||
+                    instance.getLength(u, v) >= instance.getLength(u, sources[2]));
+
+            v = instance.getTargetR(r);
+
+            assert(v == u || std::find(targets.begin(), targets.end(), v) != targets.end() ||
+                    instance.getLength(u, v) >= instance.getLength(u, targets[2]));
+        }
+    }
+
+    assert(CandidateLists(instance, 100).getSources(0).size() == instance.getNumRequests());
+    assert(CandidateLists(instance, 100).getSources(instance.getSourceR(0)).size() ==
+            instance.getNumRequests() - 1);
+
+    for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+        for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+            assert(instance.isEligible(r, k));
+            assert(instance.getMinTFulfill(r, k) > 0.0);
+        }
+    }
+
+    // a small vehicle cannot carry the first request and a short shift cannot reach it
+    std::istringstream fleet("k0 100 1 5 0 0 0 1 1 0\nk0 5 1 50 0 0 0 1 1 0\n"
+            "r1 0 8 2 3 0 4 5 0\nr1 0 3 1 0 0 0 1 0\n");
+    Instance fleetInstance(fleet);
+
+    assert(!fleetInstance.isEligible(0, 0));
+    assert(!fleetInstance.isEligible(0, 1));
+    assert(fleetInstance.isEligible(1, 0));
+    assert(fleetInstance.isEligible(1, 1));
+    assert(fabs(fleetInstance.getMinTFulfill(1, 0) - 1.0 - sqrt(2.0)) < 1.0e-9);
+    assert(!ArcFilter::isArcFeasible(fleetInstance, fleetInstance.getSourceR(0),
+                fleetInstance.getTargetR(0), 0));
+    assert(ArcFilter::isArcFeasible(fleetInstance, fleetInstance.getSourceR(1),
+                fleetInstance.getTargetR(1), 1));
+
+    ArcFilter arcFilter(instance);
+
+    assert(arcFilter.getNumArcs() < 2 * 20 * 20);
+    assert(arcFilter.isFeasible(instance.getSourceK(0), instance.getTargetK(0), 0));
+    assert(arcFilter.isFeasible(instance.getSourceK(0), instance.getSourceR(0), 0));
+    assert(arcFilter.isFeasible(instance.getSourceR(0), instance.getTargetR(0), 0));
+    assert(!arcFilter.isFeasible(instance.getSourceK(0), instance.getSourceK(0), 0));
+    assert(!arcFilter.isFeasible(instance.getSourceK(1), instance.getTargetK(1), 0));
+    assert(!arcFilter.isFeasible(instance.getTargetK(0), instance.getSourceR(0), 0));
+    assert(!arcFilter.isFeasible(instance.getSourceR(0), instance.getSourceK(0), 0));
+    assert(!arcFilter.isFeasible(instance.getSourceK(0), instance.getTargetR(0), 0));
+    assert(!arcFilter.isFeasible(instance.getSourceR(0), instance.getTargetK(0), 0));
+    assert(!arcFilter.isFeasible(instance.getTargetR(0), instance.getSourceR(0), 0));
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        std::size_t numSuccessors = 0;
+
+        for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+            ArrayView<unsigned> successors = arcFilter.getSuccessors(u, k);
+
+            numSuccessors += successors.size();
+            assert(std::is_sorted(successors.begin(), successors.end()));
+
+            for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+                assert(arcFilter.isFeasible(u, v, k) ==
+                        ArcFilter::isArcFeasible(instance, u, v, k));
+                assert(arcFilter.isFeasible(u, v, k) ==
+                        (std::find(successors.begin(), successors.end(), v) != successors.end()));
+            }
+        }
+
+        assert(numSuccessors > 0);
+    }
+
+    // a vehicle whose capacity is below the demand of two requests cannot carry both
+    std::istringstream tight("k0 100 1 5 0 0 0 1 1 0\nr1 0 3 2 3 0 4 5 0\nr1 0 3 6 7 0 8 9 0\n");
+    Instance tightInstance(tight);
+    ArcFilter tightFilter(tightInstance);
+
+    assert(tightFilter.isFeasible(tightInstance.getSourceR(0), tightInstance.getTargetR(0), 0));
+    assert(tightFilter.isFeasible(tightInstance.getTargetR(0), tightInstance.getSourceR(1), 0));
+    assert(!tightFilter.isFeasible(tightInstance.getSourceR(0), tightInstance.getSourceR(1), 0));
+    assert(!tightFilter.isFeasible(tightInstance.getSourceR(0), tightInstance.getTargetR(1), 0));
+
+    // a failed write leaves the existing file unchanged
+    try {
+        onTheFlyInstance.writeBinary("bin/test/test.bin");
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "Lengths not stored.");
+    }
+
+    try {
+        onTheFlyInstance.writeLengths("bin/test/test.bin");
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "Lengths not stored.");
+    }
+
+    assert(Instance("bin/test/test.bin").getFingerprint() == instance.getFingerprint());
+
+    std::istringstream compact("k0 10 1 5 0 0 0 1 1 0\nr2 0 1 3 4 0 5 6 0\n");
+    Instance compactInstance(compact);
+
+    assert(compactInstance.getNumVehicles() == 1);
+    assert(compactInstance.getNumRequests() == 1);
+    assert(compactInstance.getTLimit(0) == 10);
+    assert(compactInstance.getProfit(0) == 2);
+    assert(compactInstance.getX(3) == 5);
+    assert(compactInstance.getY(3) == 6);
+
+    std::istringstream decimals("k 0 1e3 0.5 5 -1.25 0 0 1 1 0\n");
+    Instance decimalsInstance(decimals);
+
+    assert(decimalsInstance.getTLimit(0) == 1000);
+    assert(decimalsInstance.getSpeed(0) == 0.5);
+    assert(decimalsInstance.getX(0) == -1.25);
+
+    std::istringstream liLim("2 200 1\n"
+            "0 40 50 0 0 1236 0 0 0\n"
+            "1 45 68 -10 912 967 90 3 0\n"
+            "2 45 70 20 825 870 90 0 4\n"
+            "3 42 66 10 65 146 90 0 1\n"
+            "4 42 68 -20 727 782 90 2 0\n");
+    Instance liLimInstance(liLim);
+
+    assert(liLimInstance.isValid());
+    assert(liLimInstance.getNumVehicles() == 2);
+    assert(liLimInstance.getNumRequests() == 2);
+    assert(liLimInstance.getNumVertices() == 8);
+    assert(liLimInstance.getTStart(1) == 0 && liLimInstance.getTLimit(1) == 1236);
+    assert(liLimInstance.getCapacity(0) == 200 && liLimInstance.getSpeed(0) == 1);
+    assert(liLimInstance.getX(liLimInstance.getSourceK(1)) == 40);
+    assert(liLimInstance.getY(liLimInstance.getTargetK(1)) == 50);
+    assert(liLimInstance.getDemandR(0) == 20 && liLimInstance.getProfit(0) == 20);
+    assert(liLimInstance.getTCreate(0) == 825);
+    assert(liLimInstance.getY(liLimInstance.getSourceR(0)) == 70);
+    assert(liLimInstance.getY(liLimInstance.getTargetR(0)) == 68);
+    assert(liLimInstance.getDemandR(1) == 10 && liLimInstance.getTCreate(1) == 65);
+    assert(liLimInstance.getX(liLimInstance.getTargetR(1)) == 45);
+    assert(liLimInstance.getTVisit(liLimInstance.getTargetR(1)) == 90);
+
+    try {
+        std::istringstream unmatched("1 200 1\n0 40 50 0 0 1236 0 0 0\n"
+                "1 45 68 10 912 967 90 0 2\n2 45 70 -10 825 870 90 0 1\n");
+        Instance unmatchedInstance(unmatched);
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "line 3: unmatched pickup task.");
+    }
+
+    try {
+        std::istringstream skipped("1 200 1\n0 40 50 0 0 1236 0 0 0\n2 45 68 10 912 967 90 0 2\n");
+        Instance skippedInstance(skipped);
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "line 3, column 1: task 1 expected.");
+    }
+
+    try {
+        std::istringstream malformed("k 0 10 1 5 0 0 0 1 1 0\nr 2 0 x 3 4 0 5 6 0\n");
+        Instance malformedInstance(malformed);
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "line 2, column 7: number expected.");
+    }
+
+    try {
+        std::istringstream unknown("k 0 10 1 5 0 0 0 1 1 0\n  q 1\n");
+        Instance unknownInstance(unknown);
+        assert(false);
+    } catch(const char * e) {
+        assert(std::string(e) == "line 2, column 3: unknown record type 'q'.");
+    }
+
+    // a mutated instance matches the instance built from scratch with the same data
+    for(DistanceMode mode : {DistanceMode::MATRIX, DistanceMode::ON_THE_FLY}) {
+        Instance originalInstance("instances/test.in", mode);
+        Instance dynamicInstance = originalInstance;
+        unsigned numRequests = dynamicInstance.getNumRequests();
+        unsigned numVertices = dynamicInstance.getNumVertices();
+        double sumProfit = dynamicInstance.getSumProfit();
+
+        for(unsigned i = 0; i < 40; i++) {
+            unsigned r = dynamicInstance.addRequest(3.0, i, 1.0 + i % 4, 10.0 * (i % 7),
+                    5.0 * (i % 5), 1.0, 40.0 - i, 3.0 * (i % 11), 2.0);
+
+            assert(r == numRequests + i);
+            assert(dynamicInstance.getSourceR(r) == numVertices + 2 * i);
+            assert(dynamicInstance.getTargetR(r) == numVertices + 2 * i + 1);
+        }
+
+        dynamicInstance.removeRequest(1);
+        dynamicInstance.removeRequest(numRequests + 3);
+        dynamicInstance.updateVehicle(1, 7.0, 8.0, 2.0, 300.0, 3.0);
+
+        try {
+            dynamicInstance.removeRequest(1);
+            assert(false);
+        } catch(const char * e) {
+            assert(strcmp(e, "Invalid request.") == 0);
+        }
+
+        std::vector<double> x(dynamicInstance.getX().begin(), dynamicInstance.getX().end());
+        std::vector<double> y(dynamicInstance.getY().begin(), dynamicInstance.getY().end());
+        std::vector<double> tStarts(dynamicInstance.getTStarts().begin(),
+                dynamicInstance.getTStarts().end());
+        std::vector<double> tLimits(dynamicInstance.getTLimits().begin(),
+                dynamicInstance.getTLimits().end());
+        std::vector<double> capacities(dynamicInstance.getCapacities().begin(),
+                dynamicInstance.getCapacities().end());
+        Instance staticInstance(
+                std::vector<double>(dynamicInstance.getProfits().begin(),
+                    dynamicInstance.getProfits().end()),
+                std::vector<double>(dynamicInstance.getTCreates().begin(),
+                    dynamicInstance.getTCreates().end()),
+                std::vector<double>(dynamicInstance.getDemandsR().begin(),
+                    dynamicInstance.getDemandsR().end()),
+                std::vector<unsigned>(dynamicInstance.getSourcesR().begin(),
+                    dynamicInstance.getSourcesR().end()),
+                std::vector<unsigned>(dynamicInstance.getTargetsR().begin(),
+                    dynamicInstance.getTargetsR().end()),
+                tStarts, tLimits,
+                std::vector<double>(dynamicInstance.getSpeeds().begin(),
+                    dynamicInstance.getSpeeds().end()),
+                capacities,
+                std::vector<unsigned>(dynamicInstance.getSourcesK().begin(),
+                    dynamicInstance.getSourcesK().end()),
+                std::vector<unsigned>(dynamicInstance.getTargetsK().begin(),
+                    dynamicInstance.getTargetsK().end()),
+                x, y,
+                std::vector<double>(dynamicInstance.getTVisits().begin(),
+                    dynamicInstance.getTVisits().end()), mode);
+
+        assert(x[dynamicInstance.getSourceK(1)] == 7.0 && y[dynamicInstance.getSourceK(1)] == 8.0);
+        assert(tStarts[1] == 2.0 && tLimits[1] == 300.0 && capacities[1] == 3.0);
+        assert(dynamicInstance.isValid());
+        assert(dynamicInstance.getNumRequests() == numRequests + 40);
+        assert(dynamicInstance.getNumVertices() == numVertices + 80);
+        assert(dynamicInstance.getSumProfit() == unsigned(sumProfit + 40 * 3.0 -
+                    dynamicInstance.getProfit(1) - 3.0));
+        assert(dynamicInstance.getSpatialIndex().size() == dynamicInstance.getNumVertices());
+
+        // the copy it was made from is left untouched
+        Instance freshInstance("instances/test.in", mode);
+
+        assert(originalInstance.getNumVertices() == numVertices);
+        assert(!originalInstance.isRetired(1));
+
+        for(unsigned v = 0; v < numVertices; v++) {
+            assert(originalInstance.getX(v) == freshInstance.getX(v));
+
+            for(unsigned u = 0; u < numVertices; u++) {
+                assert(originalInstance.getLength(u, v) == freshInstance.getLength(u, v));
+            }
+        }
+
+        for(unsigned v = 0; v < dynamicInstance.getNumVertices(); v++) {
+            const VertexRecord & vertex = dynamicInstance.getVertex(v);
+            const VertexRecord & staticVertex = staticInstance.getVertex(v);
+
+            assert(vertex.demand == staticVertex.demand);
+            assert(vertex.tVisit == staticVertex.tVisit);
+            assert(vertex.request == staticVertex.request);
+            assert(vertex.vehicle == staticVertex.vehicle);
+            assert(vertex.role == staticVertex.role);
+            assert(dynamicInstance.getRequestV(v) == staticInstance.getRequestV(v));
+            assert(dynamicInstance.getDemandV(v) == staticInstance.getDemandV(v));
+
+            for(unsigned u = 0; u < dynamicInstance.getNumVertices(); u++) {
+                assert(dynamicInstance.getLength(u, v) == staticInstance.getLength(u, v));
+
+                for(unsigned k = 0; k < dynamicInstance.getNumVehicles(); k++) {
+                    assert(dynamicInstance.getTravelTime(u, v, k) ==
+                            staticInstance.getTravelTime(u, v, k));
+                }
+            }
+        }
+
+        // the travelling times derived from the lengths are the ones that were stored, and the
+        // inserted vertices, some outside the original grid, are found by the spatial index
+        std::vector<unsigned> vertices(dynamicInstance.getNumVertices());
+        std::vector<double> travelTimes(vertices.size()), staticTravelTimes(vertices.size());
+        std::vector<unsigned> nearest, staticNearest;
+
+        std::iota(vertices.begin(), vertices.end(), 0);
+
+        if(mode == DistanceMode::MATRIX) {
+            dynamicInstance.writeBinary("bin/test/dynamic.bin");
+
+            Instance binaryInstance("bin/test/dynamic.bin");
+
+            assert(dynamicInstance.getTravelTimes(0).size() == 0);
+            assert(binaryInstance.getTravelTimes(0).size() == vertices.size());
+
+            for(unsigned u = 0; u < vertices.size(); u++) {
+                for(unsigned v = 0; v < vertices.size(); v++) {
+                    for(unsigned k = 0; k < dynamicInstance.getNumVehicles(); k++) {
+                        assert(binaryInstance.getTravelTime(u, v, k) ==
+                                staticInstance.getTravelTime(u, v, k));
+                    }
+                }
+            }
+        }
+
+        for(unsigned u = 0; u < vertices.size(); u++) {
+            for(unsigned k = 0; k < dynamicInstance.getNumVehicles(); k++) {
+                dynamicInstance.getTravelTimes(u, vertices, k, travelTimes.data());
+                staticInstance.getTravelTimes(u, vertices, k, staticTravelTimes.data());
+
+                assert(travelTimes == staticTravelTimes);
+            }
+
+            dynamicInstance.getSpatialIndex().getNearest(dynamicInstance.getX(u),
+                    dynamicInstance.getY(u), 10, nearest);
+            staticInstance.getSpatialIndex().getNearest(dynamicInstance.getX(u),
+                    dynamicInstance.getY(u), 10, staticNearest);
+
+            assert(nearest == staticNearest);
+        }
+
+        for(unsigned r = 0; r < dynamicInstance.getNumRequests(); r++) {
+            bool isRetired = r == 1 || r == numRequests + 3;
+
+            assert(dynamicInstance.isRetired(r) == isRetired);
+
+            for(unsigned k = 0; k < dynamicInstance.getNumVehicles(); k++) {
+                assert(dynamicInstance.isEligible(r, k) ==
+                        (!isRetired && staticInstance.isEligible(r, k)));
+            }
+        }
+    }
+
+    try {
+        Instance("instances/test.in").writeLengths("bin/test/lengths.bin");
+        Instance lengthsInstance("instances/test.in", "bin/test/lengths.bin");
+
+        lengthsInstance.addRequest(1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0);
+        assert(false);
+    } catch(const char * e) {
+        assert(strcmp(e, "Instances with a lengths file cannot be modified.") == 0);
+    }
+
+    // the fingerprint depends on the data only, not on its format or the distance mode
+    Instance textInstance("instances/test.in");
+    uint64_t fingerprint = textInstance.getFingerprint();
+
+    textInstance.writeBinary("bin/test/fingerprint.bin");
+    textInstance.writeLengths("bin/test/fingerprint.lengths");
+
+    assert(Instance("instances/test.in", DistanceMode::ON_THE_FLY).getFingerprint() == fingerprint);
+    assert(Instance("bin/test/fingerprint.bin").getFingerprint() == fingerprint);
+    assert(Instance("instances/test.in", "bin/test/fingerprint.lengths").getFingerprint() !=
+            fingerprint);
+
+    textInstance.removeRequest(0);
+    assert(textInstance.getFingerprint() != fingerprint);
+
+    // the derived structures are stored on a miss and mapped on a hit
+    InstanceCache cache("bin/test/cache");
+    Instance cachedInstance;
+
+    std::remove(cache.getFilename(fingerprint, "instance", 2).c_str());
+    std::remove(cache.getFilename(fingerprint, "arcfilter", 1).c_str());
+
+    assert(!cache.find(fingerprint, "instance", 2));
+
+    for(unsigned i = 0; i < 2; i++) {
+        cachedInstance = cache.getInstance("instances/test.in", DistanceMode::MATRIX);
+
+        assert(cache.find(fingerprint, "instance", 2));
+        assert(cachedInstance.isValid());
+        assert(cachedInstance.getFingerprint() == fingerprint);
+        assert(cachedInstance.getNumVertices() == instance.getNumVertices());
+
+        for(unsigned u = 0; u < cachedInstance.getNumVertices(); u++) {
+            for(unsigned v = 0; v < cachedInstance.getNumVertices(); v++) {
+                assert(cachedInstance.getLength(u, v) == instance.getLength(u, v));
+                assert(cachedInstance.getTravelTime(u, v, 1) == instance.getTravelTime(u, v, 1));
+            }
+        }
+    }
+
+    assert(cache.getInstance("instances/test.in", DistanceMode::ON_THE_FLY).getDistanceMode() ==
+            DistanceMode::ON_THE_FLY);
+
+    ArcFilter computedArcFilter(cachedInstance);
+
+    for(unsigned i = 0; i < 3; i++) {
+        // a file whose header does not match is recomputed
+        if(i == 2) {
+            std::ofstream ofs(cache.getFilename(fingerprint, "arcfilter", 1),
+                    std::ios::binary | std::ios::in);
+
+            ofs.write("garbage", 7);
+        }
+
+        ArcFilter cachedArcFilter = cache.getArcFilter(cachedInstance);
+
+        assert(cache.find(fingerprint, "arcfilter", 1));
+        assert(cachedArcFilter.getNumArcs() == computedArcFilter.getNumArcs());
+
+        for(unsigned k = 0; k < cachedInstance.getNumVehicles(); k++) {
+            for(unsigned u = 0; u < cachedInstance.getNumVertices(); u++) {
+                ArrayView<unsigned> successors = cachedArcFilter.getSuccessors(u, k);
+                ArrayView<unsigned> computedSuccessors = computedArcFilter.getSuccessors(u, k);
+
+                assert(std::equal(successors.begin(), successors.end(),
+                            computedSuccessors.begin(), computedSuccessors.end()));
+
+                for(unsigned v = 0; v < cachedInstance.getNumVertices(); v++) {
+                    assert(cachedArcFilter.isFeasible(u, v, k) ==
+                            computedArcFilter.isFeasible(u, v, k));
+                }
+            }
+        }
+    }
+
+    // a view reads the attributes, lengths and eligibility of its parent
+    std::shared_ptr<Instance> parent = std::make_shared<Instance>("instances/test.in",
+            DistanceMode::ON_THE_FLY);
+    std::vector<unsigned> viewRequests = {6, 2, 7, 0};
+    std::vector<unsigned> viewVehicles = {1};
+
+    parent->removeRequest(7);
+
+    for(DistanceMode mode : {DistanceMode::MATRIX, DistanceMode::ON_THE_FLY}) {
+        std::shared_ptr<const Instance> view = std::make_shared<const Instance>(
+                mode == DistanceMode::MATRIX ? std::make_shared<const Instance>(
+                    "instances/test.in") : parent, viewRequests, viewVehicles);
+        const Instance & viewParent = * view->getParent();
+        ArrayView<unsigned> parentsV = view->getParentsV();
+
+        assert(view->getDistanceMode() == DistanceMode::VIEW);
+        assert(view->getTravelTimes(0).size() == 0);
+        assert(view->isValid(ValidationLevel::FULL));
+        assert(view->getNumRequests() == viewRequests.size());
+        assert(view->getNumVehicles() == viewVehicles.size());
+        assert(view->getNumVertices() == 2 * (viewRequests.size() + viewVehicles.size()));
+        assert(std::equal(view->getParentsR().begin(), view->getParentsR().end(),
+                    viewRequests.begin()));
+        assert(std::equal(view->getParentsK().begin(), view->getParentsK().end(),
+                    viewVehicles.begin()));
+
+        for(unsigned r = 0; r < view->getNumRequests(); r++) {
+            assert(parentsV[view->getSourceR(r)] == viewParent.getSourceR(viewRequests[r]));
+            assert(parentsV[view->getTargetR(r)] == viewParent.getTargetR(viewRequests[r]));
+            assert(view->getProfit(r) == viewParent.getProfit(viewRequests[r]));
+            assert(view->isRetired(r) == viewParent.isRetired(viewRequests[r]));
+
+            for(unsigned k = 0; k < view->getNumVehicles(); k++) {
+                assert(view->isEligible(r, k) ==
+                        viewParent.isEligible(viewRequests[r], viewVehicles[k]));
+            }
+        }
+
+        assert(view->getSumProfit() == viewParent.getProfit(6) + viewParent.getProfit(2) +
+                (mode == DistanceMode::MATRIX ? viewParent.getProfit(7) : 0.0) +
+                viewParent.getProfit(0));
+
+        for(unsigned u = 0; u < view->getNumVertices(); u++) {
+            std::vector<double> lengths(view->getNumVertices());
+            std::vector<double> travelTimes(view->getNumVertices());
+            std::vector<unsigned> vertices(view->getNumVertices());
+
+            std::iota(vertices.begin(), vertices.end(), 0);
+            view->getLengths(u, vertices, lengths.data());
+            view->getTravelTimes(u, vertices, 0, travelTimes.data());
+
+            assert(view->getX(u) == viewParent.getX(parentsV[u]));
+            assert(view->getTVisit(u) == viewParent.getTVisit(parentsV[u]));
+
+            for(unsigned v = 0; v < view->getNumVertices(); v++) {
+                assert(view->getLength(u, v) == viewParent.getLength(parentsV[u], parentsV[v]));
+                assert(view->getTravelTime(u, v, 0) ==
+                        viewParent.getTravelTime(parentsV[u], parentsV[v], 1));
+                assert(lengths[v] == view->getLength(u, v));
+                assert(travelTimes[v] == view->getTravelTime(u, v, 0));
+            }
+        }
+
+        // a view of a view reads the lengths of the root
+        Instance subView(view, {1}, {0});
+
+        assert(subView.getLength(subView.getSourceK(0), subView.getTargetR(0)) ==
+                viewParent.getLength(viewParent.getSourceK(1), viewParent.getTargetR(2)));
+
+        // a view cannot grow, retire its requests nor move its vehicles, whose lengths and
+        // eligibility belong to the parent
+        Instance copy = * view;
+        bool isExceptionThrown = false;
+
+        try {
+            copy.addRequest(1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0);
+        } catch(const char * e) {
+            isExceptionThrown = true;
+        }
+
+        assert(isExceptionThrown);
+        isExceptionThrown = false;
+
+        try {
+            copy.removeRequest(0);
+        } catch(const char * e) {
+            assert(strcmp(e, "Views cannot be modified.") == 0);
+            isExceptionThrown = true;
+        }
+
+        assert(isExceptionThrown);
+        assert(!copy.isRetired(0) && copy.getSumProfit() == view->getSumProfit());
+        isExceptionThrown = false;
+
+        try {
+            copy.updateVehicle(0, 0.0, 0.0, 0.0, 100.0, 10.0);
+        } catch(const char * e) {
+            isExceptionThrown = true;
+        }
+
+        assert(isExceptionThrown);
+    }
+
+    // compressed instances are chosen by their extension and read back unchanged
+    Instance plainInstance("instances/test.in");
+    std::vector<std::string> compressedFilenames = {"bin/test/compressed.in.gz"};
+
+#ifdef WITH_ZSTD
+    compressedFilenames.push_back("bin/test/compressed.in.zst");
+#else
+    try {
+        plainInstance.write("bin/test/compressed.in.zst");
+        assert(false);
+    } catch(const char * e) {
+        assert(strcmp(e, "Zstandard compression not available.") == 0);
+    }
+#endif
+
+    assert(getCompression("instance.in") == Compression::NONE);
+    assert(getCompression("instance.in.gz") == Compression::GZIP);
+    assert(getCompression("instance.in.zst") == Compression::ZSTD);
+    assert(getCompression(".gz") == Compression::NONE);
+
+    plainInstance.write("bin/test/compressed.in");
+
+    std::size_t textSize = CompressedInputStream("bin/test/compressed.in").getSize();
+
+    assert(textSize > 0);
+
+    for(const std::string & compressedFilename : compressedFilenames) {
+        plainInstance.write(compressedFilename.c_str());
+
+        std::ifstream ifs(compressedFilename, std::ios::binary);
+        std::string compressed((std::istreambuf_iterator<char>(ifs)),
+                std::istreambuf_iterator<char>());
+        Instance compressedInstance(compressedFilename);
+
+        assert(compressed.size() > 4);
+        assert(compressedFilename.back() == 'z' ?
+                (uint8_t) compressed[0] == 0x1f && (uint8_t) compressed[1] == 0x8b :
+                (uint8_t) compressed[0] == 0x28 && (uint8_t) compressed[1] == 0xb5);
+        assert(compressedInstance.getFingerprint() == plainInstance.getFingerprint());
+
+        // the size of the text is known before reading it, except from a Zstandard stream
+        std::size_t size = CompressedInputStream(compressedFilename.c_str()).getSize();
+
+        assert(compressedFilename.back() == 'z' ? size == textSize : size == 0 || size == textSize);
+
+        // a truncated file is reported rather than read as a shorter instance
+        std::string truncatedFilename = "bin/test/truncated" + compressedFilename.substr(19);
+        std::ofstream ofs(truncatedFilename, std::ios::binary);
+
+        ofs.write(compressed.data(), compressed.size() - 4);
+        ofs.close();
+
+        try {
+            Instance truncatedInstance(truncatedFilename);
+            assert(false);
+        } catch(const char * e) {
+            assert(strcmp(e, "Invalid compressed file.") == 0);
+        }
+    }
+
+    try {
+        Instance missingInstance("bin/test/missing.in.gz");
+        assert(false);
+    } catch(const char * e) {
+        assert(strcmp(e, "File not found.") == 0);
+    }
+
     return 0;
 }
 
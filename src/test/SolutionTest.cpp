@@ -1,8 +1,16 @@
+#include "../instance/ArcFilter.hpp"
 #include "../solution/Solution.hpp"
+#include "../solution/SolutionSet.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <unordered_set>
 
 int main() {
     Instance instance;
@@ -38,6 +46,25 @@ int main() {
     assert(solution.isFeasible());
     assert(solution.areConstraintsSatisfied());
 
+    // the arc filter keeps every arc of a feasible solution
+    ArcFilter arcFilter(instance);
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        for(unsigned i = 1; i < paths[k].size(); i++) {
+            assert(arcFilter.isFeasible(paths[k][i - 1], paths[k][i], k));
+        }
+    }
+
+    // every request served is served by an eligible vehicle, no sooner than its lower bound
+    for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+        unsigned k = solution.getVehicleR(r);
+
+        if(k < instance.getNumVehicles()) {
+            assert(instance.isEligible(r, k));
+            assert(solution.getTFulfill(r) >= instance.getMinTFulfill(r, k) - 1.0e-9);
+        }
+    }
+
     assert(solution.getPaths().size() == 2);
 
     assert(solution.getPath(0).size() == 10);
@@ -2132,6 +2159,294 @@ int main() {
     assert(solution.getIndexKV(1, 18) == 2);
     assert(solution.getIndexKV(1, 19) == 3);
 
+    Solution copy = solution;
+    Solution other = Solution(solution.getInstancePtr(), paths);
+
+    assert(&copy.getInstance() == &solution.getInstance());
+    assert(&other.getInstance() == &solution.getInstance());
+    assert(other == solution);
+
+    // the routes of the second vehicle give the same solution in a view of its requests
+    std::shared_ptr<const Instance> view = std::make_shared<const Instance>(
+            solution.getInstancePtr(), std::vector<unsigned>{5, 6, 7}, std::vector<unsigned>{1});
+    std::vector<std::vector<unsigned>> viewPaths = {{view->getSourceK(0), view->getSourceR(1),
+        view->getSourceR(2), view->getTargetR(2), view->getSourceR(0), view->getTargetR(0),
+        view->getTargetR(1), view->getTargetK(0)}};
+    Solution viewSolution(view, viewPaths);
+
+    paths[0] = {instance.getSourceK(0), instance.getTargetK(0)};
+    solution = Solution(solution.getInstancePtr(), paths);
+
+    assert(viewSolution.isFeasible());
+    assert(viewSolution.areConstraintsSatisfied());
+    assert(viewSolution.getTotalProfit() == solution.getTotalProfit());
+    assert(fabs(viewSolution.getSumTFulfill() - solution.getSumTFulfill()) < DBL_EPSILON * 1e3);
+
+    // a solution file compressed with gzip is read back unchanged
+    solution.write("bin/test/solution.out.gz");
+
+    assert(Solution(solution.getInstancePtr(), "bin/test/solution.out.gz") == solution);
+
+    // the decision variables are derived once, even when first read by several threads, and
+    // shared by the copies
+    Solution lazySolution(solution.getInstancePtr(), solution.getPaths());
+    std::vector<const void *> addresses(4, nullptr);
+    std::vector<std::thread> threads;
+
+    for(unsigned i = 0; i < addresses.size(); i++) {
+        threads.push_back(std::thread([&, i]() {
+            addresses[i] = &lazySolution.getX();
+        }));
+    }
+
+    for(std::thread & thread : threads) {
+        thread.join();
+    }
+
+    for(const void * address : addresses) {
+        assert(address == addresses[0]);
+    }
+
+    assert(&Solution(lazySolution).getT() == &lazySolution.getT());
+    assert(lazySolution.getX() == solution.getX());
+    assert(lazySolution.getL() == solution.getL());
+
+    // a solution can be copied and assigned while another thread derives its values
+    Solution racedSolution(solution.getInstancePtr(), solution.getPaths());
+    Solution assignedSolution;
+    std::thread racer([&]() {
+        racedSolution.getX();
+        racedSolution.getVehiclesE();
+    });
+
+    for(unsigned i = 0; i < 100; i++) {
+        Solution copiedSolution(racedSolution);
+
+        assignedSolution = racedSolution;
+        assert(copiedSolution == racedSolution);
+    }
+
+    racer.join();
+
+    assert(Solution(racedSolution).getX() == solution.getX());
+    assert(assignedSolution.getVehiclesE() == lazySolution.getVehiclesE());
+
+    // the vehicle of each edge and the index of each vertex in each path follow the successors
+    // and positions of the vertices, as in their dense matrices
+    for(unsigned u = 0; u < instance.getNumVertices(); u++) {
+        unsigned k = lazySolution.getVehicleV(u);
+
+        if(k < instance.getNumVehicles()) {
+            assert(lazySolution.getPath(k)[lazySolution.getPosition(u)] == u);
+            assert(lazySolution.getSuccessor(u) == (u == instance.getTargetK(k) ?
+                        instance.getNumVertices() :
+                        lazySolution.getPath(k)[lazySolution.getPosition(u) + 1]));
+        } else {
+            assert(lazySolution.getSuccessor(u) == instance.getNumVertices());
+        }
+
+        for(unsigned v = 0; v < instance.getNumVertices(); v++) {
+            assert(lazySolution.getVehicleE(u, v) == lazySolution.getVehiclesE()[u][v]);
+        }
+
+        for(k = 0; k < instance.getNumVehicles(); k++) {
+            assert(lazySolution.getIndexKV(k, u) == lazySolution.getIndexesKV()[k][u]);
+        }
+    }
+
+    // every insertion gives the changes, the validity and the hash of the solution built from
+    // its paths, and the hashes of different paths differ
+    unsigned numFeasible = 0, numInserted = 0;
+    std::unordered_set<uint64_t> hashes = {solution.getHash()};
+
+    for(unsigned k = 0; k < instance.getNumVehicles(); k++) {
+        const std::vector<unsigned> & path = solution.getPath(k);
+
+        assert(solution.getSlack(k) == instance.getTLimit(k) - solution.getTTravel(k));
+
+        for(unsigned i = 0; i < path.size(); i++) {
+            for(unsigned j = i; j < path.size(); j++) {
+                double maxLoad = solution.getLoad(k, i);
+
+                for(unsigned p = i; p <= j; p++) {
+                    maxLoad = std::max(maxLoad, solution.getLoad(k, p));
+                }
+
+                assert(solution.getMaxLoad(k, i, j) == maxLoad);
+            }
+        }
+
+        for(unsigned r = 0; r < instance.getNumRequests(); r++) {
+            assert(!solution.evaluateInsertion(r, k, 0, 1).isFeasible);
+            assert(!solution.evaluateInsertion(r, k, 1, path.size()).isFeasible);
+
+            for(unsigned i = 1; i < path.size(); i++) {
+                for(unsigned j = i; j < path.size(); j++) {
+                    Insertion insertion = solution.evaluateInsertion(r, k, i, j);
+                    std::vector<std::vector<unsigned>> newPaths = solution.getPaths();
+
+                    if(solution.getVehicleV(instance.getSourceR(r)) <
+                            instance.getNumVehicles()) {
+                        assert(!insertion.isFeasible);
+                        continue;
+                    }
+
+                    newPaths[k].insert(newPaths[k].begin() + j, instance.getTargetR(r));
+                    newPaths[k].insert(newPaths[k].begin() + i, instance.getSourceR(r));
+
+                    Solution newSolution(solution.getInstancePtr(), newPaths);
+
+                    assert(fabs(solution.getTotalProfit() + insertion.deltaTotalProfit -
+                                newSolution.getTotalProfit()) < 1e-9);
+                    assert(fabs(solution.getSumTFulfill() + insertion.deltaSumTFulfill -
+                                newSolution.getSumTFulfill()) < 1e-9);
+                    assert(fabs(solution.getTTravel(k) + insertion.deltaTTravel -
+                                newSolution.getTTravel(k)) < 1e-9);
+                    assert(insertion.isFeasible == (newSolution.isValidPath(k) &&
+                                instance.isEligible(r, k)));
+                    assert(insertion.hash == newSolution.getHash());
+
+                    hashes.insert(insertion.hash);
+                    numInserted++;
+
+                    if(insertion.isFeasible) {
+                        numFeasible++;
+                    }
+                }
+            }
+        }
+    }
+
+    assert(numFeasible > 0);
+    assert(hashes.size() == numInserted + 1);
+    assert(solution.evaluateInsertion(0, 0, 0, 0).hash == solution.getHash());
+
+    // solutions with the same paths have the same hash, whatever they are built from, and a set
+    // of solutions keeps only one of them
+    Solution readSolution(solution.getInstancePtr(), "bin/test/solution.out.gz");
+    Solution variablesSolution(solution.getInstancePtr(), solution.getX(), solution.getY(),
+            solution.getT(), solution.getL());
+    std::vector<std::vector<unsigned>> swappedPaths = solution.getPaths();
+
+    std::swap(swappedPaths[0], swappedPaths[1]);
+
+    assert(Solution(solution).getHash() == solution.getHash());
+    assert(readSolution.getHash() == solution.getHash());
+    assert(lazySolution.getHash() == solution.getHash());
+    assert(variablesSolution.getHash() == solution.getHash());
+    assert(Solution(solution.getInstancePtr(), swappedPaths).getHash() != solution.getHash());
+    assert(copy.getHash() != solution.getHash());
+
+    SolutionSet solutionSet(10);
+
+    solutionSet.insert(solution);
+    solutionSet.insert(readSolution);
+    solutionSet.insert(std::set<Solution>{variablesSolution, lazySolution});
+
+    assert(solutionSet.size() == 1);
+
+    solutionSet.insert(copy);
+
+    assert(solutionSet.size() == 2);
+    assert(SolutionSet(10, std::set<Solution>{solution, copy}).size() == 2);
+
+    // the constraints derived from the paths fail first where the decision variables do, for
+    // well-formed, shuffled and arbitrary paths, as well as paths that repeat vertices, in the
+    // test instance and in small random instances, half of which have attributes out of range
+    std::default_random_engine generator(0);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    std::vector<unsigned> numErrors(23, 0);
+
+    for(unsigned n = 0; n < 100; n++) {
+        std::shared_ptr<const Instance> randomInstance = solution.getInstancePtr();
+
+        if(n > 0) {
+            unsigned numRequests = 4, numVehicles = 2;
+            double range = n % 2 == 0 ? 1.0 : 0.0;
+            std::vector<double> profits, tCreates, demandsR, tStarts, tLimits, speeds;
+            std::vector<double> capacities, x, y, tVisits;
+            std::vector<unsigned> sourcesR, targetsR, sourcesK, targetsK;
+
+            for(unsigned k = 0; k < numVehicles; k++) {
+                tStarts.push_back(5.0 * range * distribution(generator));
+                tLimits.push_back(30.0 + 30.0 * distribution(generator) + 100.0 * (1.0 - range));
+                speeds.push_back(1.0);
+                capacities.push_back(2.0 + 3.0 * range * distribution(generator));
+                sourcesK.push_back(2 * k);
+                targetsK.push_back(2 * k + 1);
+            }
+
+            for(unsigned r = 0; r < numRequests; r++) {
+                profits.push_back(1.0);
+                tCreates.push_back(20.0 * range * (1.0 + distribution(generator)));
+                demandsR.push_back(1.0 + 3.0 * range * distribution(generator));
+                sourcesR.push_back(2 * numVehicles + 2 * r);
+                targetsR.push_back(2 * numVehicles + 2 * r + 1);
+            }
+
+            for(unsigned v = 0; v < 2 * (numVehicles + numRequests); v++) {
+                x.push_back(5.0 * distribution(generator));
+                y.push_back(5.0 * distribution(generator));
+                tVisits.push_back(1.0 + distribution(generator));
+            }
+
+            randomInstance = std::make_shared<const Instance>(profits, tCreates, demandsR,
+                    sourcesR, targetsR, tStarts, tLimits, speeds, capacities, sourcesK, targetsK,
+                    x, y, tVisits);
+        }
+
+        for(unsigned it = 0; it < 200; it++) {
+            std::vector<std::vector<unsigned>> randomPaths(randomInstance->getNumVehicles());
+            std::vector<unsigned> vertices(randomInstance->getNumVertices());
+            unsigned mode = generator() % 4;
+
+            std::iota(vertices.begin(), vertices.end(), 0);
+            std::shuffle(vertices.begin(), vertices.end(), generator);
+
+            for(unsigned k = 0; k < randomInstance->getNumVehicles(); k++) {
+                std::vector<unsigned> & path = randomPaths[k];
+
+                if(mode < 2) {
+                    path.push_back(randomInstance->getSourceK(k));
+
+                    for(unsigned r = 0; r < randomInstance->getNumRequests(); r++) {
+                        if(generator() % (2 * randomInstance->getNumVehicles()) == 0) {
+                            path.push_back(randomInstance->getSourceR(r));
+                            path.push_back(randomInstance->getTargetR(r));
+                        }
+                    }
+
+                    path.push_back(randomInstance->getTargetK(k));
+                } else {
+                    unsigned size = generator() % 6;
+
+                    for(unsigned i = 0; i < size && !vertices.empty(); i++) {
+                        path.push_back(vertices.back());
+                        vertices.pop_back();
+                    }
+                }
+
+                // shuffled paths swap two of their vertices, and arbitrary paths may repeat one
+                if(mode == 1 && generator() % 2 == 0) {
+                    std::swap(path[generator() % path.size()], path[generator() % path.size()]);
+                } else if(mode == 3 && !path.empty() && generator() % 4 == 0) {
+                    path.push_back(path[generator() % path.size()]);
+                }
+            }
+
+            Solution randomSolution(randomInstance, randomPaths);
+            unsigned error, expectedError;
+
+            assert(randomSolution.areConstraintsSatisfied(error) ==
+                    randomSolution.areDecisionVariablesSatisfied(expectedError));
+            assert(error == expectedError);
+
+            numErrors[error]++;
+        }
+    }
+
+    assert(numErrors[0] > 0);
+
     return 0;
 }
 